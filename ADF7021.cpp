@@ -29,13 +29,15 @@
 #include "Globals.h"
 #include "IO.h"
 #include "ADF7021.h"
-#include <math.h>
 
 volatile bool totx_request = false;
 volatile bool torx_request = false;
 volatile bool even = true;
 static uint32_t last_clk = 2U;
 
+// The interrupt latches a TX/RX switch within two bits, 208 us
+const uint16_t SWITCH_WAIT_US = 500U;
+
 volatile uint32_t  AD7021_control_word;
 
 uint32_t           ADF7021_RX_REG0;
@@ -52,111 +54,101 @@ uint16_t           m_nxdnDev;
 uint16_t           m_m17Dev;
 uint16_t           m_pocsagDev;
 
-static void Send_AD7021_control_shift()
+// Last word written to each register of the two chips
+static uint32_t    AD7021_shadow[2U][16U];
+static uint16_t    AD7021_shadowValid[2U] = {0U, 0U};
+static uint16_t    AD7021_skipped = 0U;
+static uint16_t    AD7021_resetsSkipped = 0U;
+static uint32_t    AD7021_savedUs = 0U;
+
+static void AD7021_shadowWrite(uint8_t chip)
 {
-  for (int AD7021_counter = 31; AD7021_counter >= 0; AD7021_counter--) {
-    if (bitRead(AD7021_control_word, AD7021_counter) == HIGH)
-      io.SDATA_pin(HIGH);
-    else
-      io.SDATA_pin(LOW);
+  uint8_t reg = AD7021_control_word & 0x0FU;
 
-    io.dlybit();
-    io.SCLK_pin(HIGH);
-    io.dlybit();
-    io.SCLK_pin(LOW);
-  }
+  AD7021_shadow[chip][reg] = AD7021_control_word;
+  AD7021_shadowValid[chip] |= 1U << reg;
+}
+
+static bool AD7021_isShadowed(uint8_t chip, uint32_t word)
+{
+  uint8_t reg = word & 0x0FU;
 
-  // to keep SDATA signal at defined level when idle (not required)
-  io.SDATA_pin(LOW);
+  return (AD7021_shadowValid[chip] & (1U << reg)) != 0U && AD7021_shadow[chip][reg] == word;
 }
 
-static void Send_AD7021_control_slePulse()
+static bool AD7021_skip(uint8_t chip, bool force)
 {
-  io.SLE_pin(HIGH);
-  io.dlybit();
-  io.SLE_pin(LOW);
+  if (force || !AD7021_isShadowed(chip, AD7021_control_word))
+    return false;
+
+  AD7021_skipped++;
+  AD7021_savedUs += ADF7021_WRITE_US;
+
+  return true;
 }
 
 void Send_AD7021_control(bool doSle)
 {
-  Send_AD7021_control_shift();
+  io.busWrite(AD7021_control_word, 32U);
 
   if (doSle)
-    Send_AD7021_control_slePulse();
+    io.busLatch(0U);
+
+  AD7021_shadowWrite(0U);
 }
 
-#if defined(DUPLEX)
-static  void Send_AD7021_control_sle2Pulse()
+// Only shifts the word out when the chip does not already hold it, returns
+// true if it was written
+bool Send_AD7021_update(bool force)
 {
-  io.SLE2_pin(HIGH);
-  io.dlybit();
-  io.SLE2_pin(LOW);
+  if (AD7021_skip(0U, force))
+    return false;
+
+  Send_AD7021_control();
+
+  return true;
 }
 
+#if defined(DUPLEX)
 void Send_AD7021_control2(bool doSle)
 {
-  Send_AD7021_control_shift();
+  io.busWrite(AD7021_control_word, 32U);
 
   if (doSle)
-    Send_AD7021_control_sle2Pulse();
+    io.busLatch(1U);
+
+  AD7021_shadowWrite(1U);
 }
-#endif
 
-#if defined(SEND_RSSI_DATA)
-uint16_t CIO::readRSSI()
+bool Send_AD7021_update2(bool force)
 {
-  uint32_t AD7021_RB;
-  uint16_t RB_word = 0U;
-  uint8_t RB_code, gain_code, gain_corr;
+  if (AD7021_skip(1U, force))
+    return false;
 
-  // Register 7, readback enable, ADC RSSI mode
-  AD7021_RB = 0x0147;
-
-  // Send control register
-  for (int AD7021_counter = 8; AD7021_counter >= 0; AD7021_counter--) {
-    if (bitRead(AD7021_RB, AD7021_counter) == HIGH)
-      SDATA_pin(HIGH);
-    else
-      SDATA_pin(LOW);
-
-    dlybit();
-    SCLK_pin(HIGH);
-    dlybit();
-    SCLK_pin(LOW);
-  }
-
-  SDATA_pin(LOW);
+  Send_AD7021_control2();
 
-#if defined(DUPLEX)
-  if (m_duplex || m_calState == STATE_RSSICAL)
-    SLE2_pin(HIGH);
-  else
-    SLE_pin(HIGH);
-#else
-  SLE_pin(HIGH);
+  return true;
+}
 #endif
 
-  dlybit();
-
-  // Read SREAD pin
-  for (int AD7021_counter = 17; AD7021_counter >= 0; AD7021_counter--) {
-    SCLK_pin(HIGH);
-    dlybit();
-
-    if ((AD7021_counter != 17) && (AD7021_counter != 0))
-      RB_word |= ((SREAD_pin() & 0x01) << (AD7021_counter - 1));
+#if defined(SEND_RSSI_DATA)
+uint16_t CIO::readRSSI()
+{
+  uint16_t RB_word;
+  uint8_t RB_code, gain_code, gain_corr;
 
-    SCLK_pin(LOW);
-    dlybit();
-  }
+  // The readback would shift over the REG0 a TX/RX switch has pending
+  if (isSwitching())
+    return m_rssi;
 
+  // Register 7, readback enable, ADC RSSI mode
 #if defined(DUPLEX)
   if (m_duplex || m_calState == STATE_RSSICAL)
-    SLE2_pin(LOW);
+    RB_word = busReadback(1U, 0x0147);
   else
-    SLE_pin(LOW);
+    RB_word = busReadback(0U, 0x0147);
 #else
-  SLE_pin(LOW);
+  RB_word = busReadback(0U, 0x0147);
 #endif
 
   // Process RSSI code
@@ -184,15 +176,103 @@ uint16_t CIO::readRSSI()
       break;
   }
 
-  return ( 130 - (RB_code + gain_corr)/2 );
+  m_rssi = 130 - (RB_code + gain_corr)/2;
+
+  return m_rssi;
 
 }
 #endif
 
-void CIO::ifConf(MMDVM_STATE modemState, bool reset)
+// VCO/oscillator register and output divider for the band a frequency is in,
+// returns false (and the UHF1 settings) when it is outside all of them
+static bool ADF7021_band(uint32_t frequency, uint32_t& reg1, uint32_t& div)
 {
-  float    divider;
+  if ((frequency >= VHF1_MIN) && (frequency < VHF1_MAX)) {
+    reg1 = ADF7021_REG1_VHF1;         // VHF1, external VCO
+    div  = 1U;
+  } else if ((frequency >= VHF2_MIN) && (frequency < VHF2_MAX)) {
+    reg1 = ADF7021_REG1_VHF2;         // VHF2, external VCO
+    div  = 1U;
+  } else if ((frequency >= UHF1_MIN) && (frequency < UHF1_MAX)) {
+    reg1 = ADF7021_REG1_UHF1;         // UHF1, internal VCO
+    div  = 1U;
+  } else if ((frequency >= UHF2_MIN) && (frequency < UHF2_MAX)) {
+    reg1 = ADF7021_REG1_UHF2;         // UHF2, internal VCO
+    div  = 2U;
+  } else {
+    reg1 = ADF7021_REG1_UHF1;         // UHF1, internal VCO
+    div  = 1U;
+    return false;
+  }
+
+  return true;
+}
 
+// N and F synthesizer dividers for frequency * fdiv / PFD, in integer maths.
+// The quotient is rounded to a 24 bit mantissa before F is rounded, which is
+// what the single precision float code used to do, so the register words
+// come out bit for bit the same as before.
+static void ADF7021_divider(uint32_t frequency, uint32_t fdiv, uint8_t& n, uint16_t& f)
+{
+  uint64_t num = uint64_t(frequency) * fdiv;
+
+  uint8_t bits = 0U;
+  for (uint32_t tmp = uint32_t(num / ADF7021_PFD); tmp > 0U; tmp >>= 1)
+    bits++;
+
+  // Bits left for the fraction
+  uint8_t shift = 24U - bits;
+
+  uint64_t scaled = num << shift;
+  uint32_t q      = uint32_t(scaled / ADF7021_PFD);
+  uint64_t rem    = scaled - uint64_t(q) * ADF7021_PFD;
+
+  // Round half to even
+  if ((rem * 2U) > ADF7021_PFD || ((rem * 2U) == ADF7021_PFD && (q & 1U) != 0U))
+    q++;
+
+  uint32_t frac = q & ((1UL << shift) - 1U);
+
+  n = q >> shift;
+
+  if (shift > 15U)
+    f = (frac + (1UL << (shift - 16U))) >> (shift - 15U);
+  else
+    f = frac;
+}
+
+static uint32_t ADF7021_rxReg0(uint8_t n, uint16_t f)
+{
+  uint32_t reg0 = (uint32_t) 0b0000;
+
+#if defined(BIDIR_DATA_PIN)
+  reg0 |= (uint32_t) 0b01001   << 27;   // mux regulator/receive
+#else
+  reg0 |= (uint32_t) 0b01011   << 27;   // mux regulator/uart-spi enabled/receive
+#endif
+
+  reg0 |= (uint32_t) n << 19;           // frequency;
+  reg0 |= (uint32_t) f << 4;            // frequency;
+
+  return reg0;
+}
+
+// RX register 0 for a DMR channel in the band with output divider div
+static uint32_t ADF7021_dmrRxReg0(uint32_t frequency, uint32_t div)
+{
+  uint8_t  n;
+  uint16_t f;
+
+  if (div == 1U)
+    ADF7021_divider(frequency - 100000 + AFC_OFFSET_DMR, 2U, n, f);
+  else
+    ADF7021_divider(frequency - 100000 + (2 * AFC_OFFSET_DMR), 1U, n, f);
+
+  return ADF7021_rxReg0(n, f);
+}
+
+void CIO::ifConf(MMDVM_STATE modemState, bool reset)
+{
   uint32_t ADF7021_REG2  = 0U;
   uint32_t ADF7021_REG3  = 0U;
   uint32_t ADF7021_REG4  = 0U;
@@ -202,6 +282,12 @@ void CIO::ifConf(MMDVM_STATE modemState, bool reset)
 
   uint32_t frequency_tx_tmp, frequency_rx_tmp;
 
+#if defined(ENABLE_DEBUG)
+  uint16_t skipped = AD7021_skipped;
+#endif
+
+  waitSwitch();
+
   if (modemState != STATE_CWID && modemState != STATE_POCSAG)
     m_modemState_prev = modemState;
 
@@ -217,31 +303,8 @@ void CIO::ifConf(MMDVM_STATE modemState, bool reset)
   io.checkBand(m_frequency_rx, m_frequency_tx);
   #endif
 
-  // Toggle CE pin for ADF7021 reset
-  if (reset) {
-    CE_pin(LOW);
-    delay_reset();
-    CE_pin(HIGH);
-    delay_reset();
-  }
-
   // Check frequency band
-  if ((m_frequency_tx >= VHF1_MIN) && (m_frequency_tx < VHF1_MAX)) {
-    ADF7021_REG1 = ADF7021_REG1_VHF1;         // VHF1, external VCO
-    div2 = 1U;
-  } else if ((m_frequency_tx >= VHF2_MIN) && (m_frequency_tx < VHF2_MAX)) {
-    ADF7021_REG1 = ADF7021_REG1_VHF2;         // VHF1, external VCO
-    div2 = 1U;
-  } else if ((m_frequency_tx >= UHF1_MIN)&&(m_frequency_tx < UHF1_MAX)) {
-    ADF7021_REG1 = ADF7021_REG1_UHF1;         // UHF1, internal VCO
-    div2 = 1U;
-  } else if ((m_frequency_tx >= UHF2_MIN)&&(m_frequency_tx < UHF2_MAX)) {
-    ADF7021_REG1 = ADF7021_REG1_UHF2;         // UHF2, internal VCO
-    div2 = 2U;
-  } else {
-    ADF7021_REG1 = ADF7021_REG1_UHF1;         // UHF1, internal VCO
-    div2 = 1U;
-  }
+  ADF7021_band(m_frequency_tx, ADF7021_REG1, div2);
 
   if (div2 == 1U)
     f_div = 2U;
@@ -274,33 +337,16 @@ void CIO::ifConf(MMDVM_STATE modemState, bool reset)
   }
 
   if (div2 == 1U)
-    divider = (m_frequency_rx - 100000 + AFC_OFFSET) / (ADF7021_PFD / 2U);
+    ADF7021_divider(m_frequency_rx - 100000 + AFC_OFFSET, f_div, m_RX_N_divider, m_RX_F_divider);
   else
-    divider = (m_frequency_rx - 100000 + (2 * AFC_OFFSET)) / ADF7021_PFD;
+    ADF7021_divider(m_frequency_rx - 100000 + (2 * AFC_OFFSET), f_div, m_RX_N_divider, m_RX_F_divider);
 
-  m_RX_N_divider = floor(divider);
-  divider = (divider - m_RX_N_divider) * 32768;
-  m_RX_F_divider = floor(divider + 0.5);
+  ADF7021_RX_REG0 = ADF7021_rxReg0(m_RX_N_divider, m_RX_F_divider);
 
-  ADF7021_RX_REG0  = (uint32_t) 0b0000;
+  // A channel scan or trunk plan retunes away from it, and back once dropped
+  m_chanHome = ADF7021_RX_REG0;
 
-#if defined(BIDIR_DATA_PIN)
-  ADF7021_RX_REG0 |= (uint32_t) 0b01001   << 27;   // mux regulator/receive
-#else
-  ADF7021_RX_REG0 |= (uint32_t) 0b01011   << 27;   // mux regulator/uart-spi enabled/receive
-#endif
-
-  ADF7021_RX_REG0 |= (uint32_t) m_RX_N_divider << 19;   // frequency;
-  ADF7021_RX_REG0 |= (uint32_t) m_RX_F_divider << 4;    // frequency;
-
-  if (div2 == 1U)
-    divider = m_frequency_tx / (ADF7021_PFD / 2U);
-  else
-    divider = m_frequency_tx / ADF7021_PFD;
-
-  m_TX_N_divider = floor(divider);
-  divider = (divider - m_TX_N_divider) * 32768;
-  m_TX_F_divider = floor(divider + 0.5);
+  ADF7021_divider(m_frequency_tx, f_div, m_TX_N_divider, m_TX_F_divider);
 
   ADF7021_TX_REG0  = (uint32_t) 0b0000;            // register 0
 
@@ -526,38 +572,62 @@ void CIO::ifConf(MMDVM_STATE modemState, bool reset)
       break;
   }
 
+  // MODULATION (2)
+  ADF7021_REG2 |= (uint32_t) 0b0010;               // register 2
+  ADF7021_REG2 |= (uint32_t) m_power       << 13;  // power level
+  ADF7021_REG2 |= (uint32_t) 0b110001      << 7;   // PA
+
+  // Toggle CE pin for ADF7021 reset, unless the chip already holds the
+  // whole RF set up and the command only changed firmware parameters
+  if (reset) {
+    if (AD7021_isShadowed(0U, ADF7021_REG1) && AD7021_isShadowed(0U, ADF7021_REG2) &&
+        AD7021_isShadowed(0U, ADF7021_REG3) && AD7021_isShadowed(0U, ADF7021_REG4) &&
+        AD7021_isShadowed(0U, ADF7021_REG10) && AD7021_isShadowed(0U, ADF7021_REG13)) {
+      AD7021_resetsSkipped++;
+      AD7021_savedUs += 2U * ADF7021_RESET_US;
+    } else {
+      CE_pin(LOW);
+      delay_reset();
+      CE_pin(HIGH);
+      delay_reset();
+
+      // Both chips hang off the same CE line
+      AD7021_shadowValid[0U] = 0U;
+      AD7021_shadowValid[1U] = 0U;
+    }
+  }
+
   // VCO/OSCILLATOR (REG1)
   AD7021_control_word = ADF7021_REG1;
-  Send_AD7021_control();
+  bool ifChanged = Send_AD7021_update();
 
   // TX/RX CLOCK (3)
   AD7021_control_word = ADF7021_REG3;
-  Send_AD7021_control();
+  ifChanged |= Send_AD7021_update();
 
   // DEMOD (4)
   AD7021_control_word = ADF7021_REG4;
-  Send_AD7021_control();
+  ifChanged |= Send_AD7021_update();
 
   // IF fine cal (6)
   AD7021_control_word = ADF7021_REG6;
-  Send_AD7021_control();
+  ifChanged |= Send_AD7021_update();
 
-  // IF coarse cal (5)
+  // IF coarse cal (5), writing it starts the calibration
   AD7021_control_word = ADF7021_REG5;
-  Send_AD7021_control();
-
-  // Delay for filter calibration
-  delay_IFcal();
+  if (Send_AD7021_update(ifChanged)) {
+    // Delay for filter calibration
+    delay_IFcal();
+  } else {
+    AD7021_savedUs += ADF7021_IFCAL_US;
+  }
 
   // Frequency RX (0)
   setRX();
 
   // MODULATION (2)
-  ADF7021_REG2 |= (uint32_t) 0b0010;               // register 2
-  ADF7021_REG2 |= (uint32_t) m_power       << 13;  // power level
-  ADF7021_REG2 |= (uint32_t) 0b110001      << 7;   // PA
   AD7021_control_word = ADF7021_REG2;
-  Send_AD7021_control();
+  Send_AD7021_update();
 
   // TEST DAC (14)
 #if defined(TEST_DAC)
@@ -565,7 +635,7 @@ void CIO::ifConf(MMDVM_STATE modemState, bool reset)
 #else
   AD7021_control_word = 0x0000000E;
 #endif
-  Send_AD7021_control();
+  Send_AD7021_update();
 
   // AGC (auto, defaults) (9)
 #if defined(AD7021_GAIN_AUTO)
@@ -577,23 +647,23 @@ void CIO::ifConf(MMDVM_STATE modemState, bool reset)
 #elif defined(AD7021_GAIN_HIGH)
   AD7021_control_word = 0x00A631E9; // AGC OFF, high gain
 #endif
-  Send_AD7021_control();
+  Send_AD7021_update();
 
   // AFC (10)
   AD7021_control_word = ADF7021_REG10;
-  Send_AD7021_control();
+  Send_AD7021_update();
 
   // SYNC WORD DET (11)
   AD7021_control_word = 0x0000003B;
-  Send_AD7021_control();
+  Send_AD7021_update();
 
   // SWD/THRESHOLD (12)
   AD7021_control_word = 0x0000010C;
-  Send_AD7021_control();
+  Send_AD7021_update();
 
   // 3FSK/4FSK DEMOD (13)
   AD7021_control_word = ADF7021_REG13;
-  Send_AD7021_control();
+  Send_AD7021_update();
 
 #if defined(TEST_TX)
   PTT_pin(HIGH);
@@ -605,7 +675,7 @@ void CIO::ifConf(MMDVM_STATE modemState, bool reset)
   // TEST MODE (disabled) (15)
   AD7021_control_word = 0x000E000F;
 #endif
-  Send_AD7021_control();
+  Send_AD7021_update();
 
   // Restore normal DV frequencies
   if (modemState == STATE_POCSAG) {
@@ -617,6 +687,37 @@ void CIO::ifConf(MMDVM_STATE modemState, bool reset)
 if (m_duplex && (modemState != STATE_CWID && modemState != STATE_POCSAG))
   ifConf2(modemState);
 #endif
+
+#if defined(ENABLE_DEBUG)
+  if (AD7021_skipped != skipped)
+    DEBUG4("ADF7021: writes skipped/resets skipped/bus time saved (ms)", AD7021_skipped, AD7021_resetsSkipped, int16_t(AD7021_savedUs / 1000U));
+#endif
+}
+
+uint8_t CIO::readShadowStatus(uint8_t* data, uint8_t length) const
+{
+  if (length < SHADOW_STATUS_LENGTH)
+    return 0U;
+
+  uint32_t savedMs = AD7021_savedUs / 1000U;
+  if (savedMs > 0xFFFFU)
+    savedMs = 0xFFFFU;
+
+  data[0U] = (AD7021_skipped >> 8) & 0xFFU;
+  data[1U] = (AD7021_skipped >> 0) & 0xFFU;
+  data[2U] = (AD7021_resetsSkipped >> 8) & 0xFFU;
+  data[3U] = (AD7021_resetsSkipped >> 0) & 0xFFU;
+  data[4U] = (savedMs >> 8) & 0xFFU;
+  data[5U] = (savedMs >> 0) & 0xFFU;
+
+  return SHADOW_STATUS_LENGTH;
+}
+
+void CIO::resetShadowStatus()
+{
+  AD7021_skipped       = 0U;
+  AD7021_resetsSkipped = 0U;
+  AD7021_savedUs       = 0U;
 }
 
 #if defined(DUPLEX)
@@ -773,26 +874,28 @@ void CIO::ifConf2(MMDVM_STATE modemState)
 
   // VCO/OSCILLATOR (1)
   AD7021_control_word = ADF7021_REG1;
-  Send_AD7021_control2();
+  bool ifChanged = Send_AD7021_update2();
 
   // TX/RX CLOCK (3)
   AD7021_control_word = ADF7021_REG3;
-  Send_AD7021_control2();
+  ifChanged |= Send_AD7021_update2();
 
   // DEMOD (4)
   AD7021_control_word = ADF7021_REG4;
-  Send_AD7021_control2();
+  ifChanged |= Send_AD7021_update2();
 
   // IF fine cal (6)
   AD7021_control_word = ADF7021_REG6;
-  Send_AD7021_control2();
+  ifChanged |= Send_AD7021_update2();
 
   // IF coarse cal (5)
   AD7021_control_word = ADF7021_REG5;
-  Send_AD7021_control2();
-
-  // Delay for coarse IF filter calibration
-  delay_IFcal();
+  if (Send_AD7021_update2(ifChanged)) {
+    // Delay for coarse IF filter calibration
+    delay_IFcal();
+  } else {
+    AD7021_savedUs += ADF7021_IFCAL_US;
+  }
 
   // Frequency RX (0) and set to RX only
   AD7021_control_word = ADF7021_RX_REG0;
@@ -803,35 +906,35 @@ void CIO::ifConf2(MMDVM_STATE modemState)
   ADF7021_REG2 |= (uint32_t) (m_power & 0x3F) << 13;  // power level
   ADF7021_REG2 |= (uint32_t) 0b110001         << 7;   // PA
   AD7021_control_word = ADF7021_REG2;
-  Send_AD7021_control2();
+  Send_AD7021_update2();
 
   // TEST DAC (14)
   AD7021_control_word = 0x0000000E;
-  Send_AD7021_control2();
+  Send_AD7021_update2();
 
   // AGC (auto, defaults) (9)
   AD7021_control_word = 0x000231E9;
-  Send_AD7021_control2();
+  Send_AD7021_update2();
 
   // AFC (10)
   AD7021_control_word = ADF7021_REG10;
-  Send_AD7021_control2();
+  Send_AD7021_update2();
 
   // SYNC WORD DET (11)
   AD7021_control_word = 0x0000003B;
-  Send_AD7021_control2();
+  Send_AD7021_update2();
 
   // SWD/THRESHOLD (12)
   AD7021_control_word = 0x0000010C;
-  Send_AD7021_control2();
+  Send_AD7021_update2();
 
   // 3FSK/4FSK DEMOD (13)
   AD7021_control_word = ADF7021_REG13;
-  Send_AD7021_control2();
+  Send_AD7021_update2();
 
   // TEST MODE (disabled) (15)
   AD7021_control_word = 0x000E000F;
-  Send_AD7021_control2();
+  Send_AD7021_update2();
 }
 #endif
 
@@ -859,7 +962,7 @@ void CIO::interrupt()
     last_clk = clk;
 
   // we set the TX bit at TXD low, sampling of ADF7021 happens at rising clock
-  if (m_tx && clk == 0U) {
+  if ((m_tx || totx_request) && clk == 0U) {
     uint8_t control;
     m_txBuffer.get(bit, control);
     even = !even;
@@ -894,7 +997,9 @@ void CIO::interrupt()
       SDATA_pin(LOW);
 
       // now do housekeeping
+      m_tx         = true;
       totx_request = false;
+      m_turnTX     = m_ticks - m_turnStart;
       // first tranmittted bit is always the odd bit
       even = ADF7021_EVEN_BIT;
     }
@@ -910,6 +1015,19 @@ void CIO::interrupt()
     m_rxBuffer.put(bit, 0U);
   }
 
+#if defined(DUAL_RX)
+  // In duplex the first chip is free to receive the second downlink
+  // whenever it is not transmitting
+  if (!m_tx && clk == 1U && m_dualRX) {
+    if (RXD_pin())
+      bit = 1U;
+    else
+      bit = 0U;
+
+    m_rxBuffer2.put(bit, 0U);
+  }
+#endif
+
   if (torx_request && even == ADF7021_EVEN_BIT && m_tx && clk == 0U) {
       // that is absolutely crucial in 4FSK, see datasheet:
       // enable sle after 1/4 tBit == 26uS when sending MSB (even == false) and clock is low
@@ -927,12 +1045,14 @@ void CIO::interrupt()
       // now do housekeeping
       m_tx = false;
       torx_request = false;
+      m_turnRX     = m_ticks - m_turnStart;
       // last tranmittted bit is always the even bit
       // since the current bit is a transitional "don't care" bit, never transmitted
       even = !ADF7021_EVEN_BIT;
   }
 
   m_watchdog++;
+  m_ticks++;
   m_modeTimerCnt++;
   //m_int1counter++;
 
@@ -987,8 +1107,10 @@ void CIO::setTX()
   Data_dir_out(true);  // Data pin output mode
 #endif
 
+  // The interrupt latches it on the next falling clock edge and sets m_tx,
+  // poll isSwitching() for the end of the turnaround
+  m_turnStart  = m_ticks;
   totx_request = true;
-  while(CLK_pin());
 }
 
 void CIO::setRX(bool doSle)
@@ -998,19 +1120,53 @@ void CIO::setRX(bool doSle)
 
   // Send register 0 for RX operation, but do not activate yet.
   // This is done in the interrupt at the correct time
+#if defined(DUAL_RX)
+  // A new SET_FREQ may have moved the radio to another band
+  if (m_dualRX && ADF7021_REG1 != m_dualReg1) {
+    m_dualRX = false;
+    DEBUG1("IO: band changed, dual receive stopped");
+  }
+
+  AD7021_control_word = m_dualRX ? m_dualReg0 : ADF7021_RX_REG0;
+#else
   AD7021_control_word = ADF7021_RX_REG0;
+#endif
   Send_AD7021_control(doSle);
 
 #if defined(BIDIR_DATA_PIN)
   Data_dir_out(false);  // Data pin input mode
 #endif
 
+  // The interrupt latches it after the last bit and clears m_tx, poll
+  // isSwitching() for the end of the turnaround
   if (!doSle) {
+    m_turnStart  = m_ticks;
     torx_request = true;
-    while(torx_request) { asm volatile ("nop"); }
   }
 }
 
+bool CIO::isSwitching() const
+{
+  return totx_request || torx_request;
+}
+
+void CIO::getTurnaround(uint16_t& toTX, uint16_t& toRX) const
+{
+  toTX = m_turnTX;
+  toRX = m_turnRX;
+}
+
+// Both chips share SCLK and SDATA, so any word shifted before the interrupt
+// has latched a pending TX/RX switch would be latched by chip 0 in its place
+void CIO::waitSwitch()
+{
+  for (uint16_t n = 0U; n < SWITCH_WAIT_US && isSwitching(); n += 10U)
+    delay_us(10U);
+
+  if (isSwitching())
+    DEBUG1("IO: TX/RX switch not latched");
+}
+
 void CIO::setPower(uint8_t power)
 {
   m_power = power >> 2;
@@ -1035,25 +1191,11 @@ void CIO::setDeviations(uint8_t dstarTXLevel, uint8_t dmrTXLevel, uint8_t ysfTXL
 void CIO::updateCal()
 {
   uint32_t ADF7021_REG2;
-  float    divider;
+
+  waitSwitch();
 
   // Check frequency band
-  if ((m_frequency_tx >= VHF1_MIN) && (m_frequency_tx < VHF1_MAX)) {
-    ADF7021_REG1 = ADF7021_REG1_VHF1;         // VHF1, external VCO
-    div2 = 1U;
-  } else if ((m_frequency_tx >= VHF2_MIN) && (m_frequency_tx < VHF2_MAX)) {
-    ADF7021_REG1 = ADF7021_REG1_VHF2;         // VHF1, external VCO
-    div2 = 1U;
-  } else if ((m_frequency_tx >= UHF1_MIN)&&(m_frequency_tx < UHF1_MAX)) {
-    ADF7021_REG1 = ADF7021_REG1_UHF1;         // UHF1, internal VCO
-    div2 = 1U;
-  } else if ((m_frequency_tx >= UHF2_MIN)&&(m_frequency_tx < UHF2_MAX)) {
-    ADF7021_REG1 = ADF7021_REG1_UHF2;         // UHF2, internal VCO
-    div2 = 2U;
-  } else {
-    ADF7021_REG1 = ADF7021_REG1_UHF1;         // UHF1, internal VCO
-    div2 = 1U;
-  }
+  ADF7021_band(m_frequency_tx, ADF7021_REG1, div2);
 
   if (div2 == 1U)
     f_div = 2U;
@@ -1081,14 +1223,7 @@ void CIO::updateCal()
   AD7021_control_word = ADF7021_REG2;
   Send_AD7021_control();
 
-  if (div2 == 1U)
-    divider = m_frequency_tx / (ADF7021_PFD / 2U);
-  else
-    divider = m_frequency_tx / ADF7021_PFD;
-
-  m_TX_N_divider = floor(divider);
-  divider = (divider - m_TX_N_divider) * 32768;
-  m_TX_F_divider = floor(divider + 0.5);
+  ADF7021_divider(m_frequency_tx, f_div, m_TX_N_divider, m_TX_F_divider);
 
   ADF7021_TX_REG0  = (uint32_t) 0b0000;            // register 0
 
@@ -1107,51 +1242,212 @@ void CIO::updateCal()
     setRX();
 }
 
+uint8_t CIO::setChannels(const uint32_t* frequencies, uint8_t count, uint16_t dwell)
+{
+  if (count > 0U && dwell < SCAN_MIN_DWELL)
+    return 4U;
+
+  if (!loadChannels(frequencies, count))
+    return 4U;
+
+  m_trunk     = false;
+  m_chanDwell = (uint32_t(dwell) * 96U) / 5U;     // 19.2 ticks per ms
+  m_chanHold  = false;
+  m_chanTimer = m_ticks;
+
+  DEBUG3("IO: channel scan channels/dwell (ms)", count, dwell);
+
+  if (count > 0U)
+    tuneChannel(0U);
+
+  return 0U;
+}
+
+uint8_t CIO::setTrunk(const uint32_t* frequencies, uint8_t count)
+{
+  if (!loadChannels(frequencies, count))
+    return 4U;
+
+  m_trunk = count > 0U;
+
+  DEBUG2("IO: trunk channels", count);
+
+  if (count > 0U)
+    tuneChannel(0U);
+
+  return 0U;
+}
+
+bool CIO::loadChannels(const uint32_t* frequencies, uint8_t count)
+{
+  if (count > SCAN_MAX_CHANNELS)
+    return false;
+
+  uint32_t reg1, div;
+  ADF7021_band(m_frequency_tx, reg1, div);
+
+  uint32_t chanReg1, chanDiv;
+
+  // Only REG0 is rewritten on a retune, so every channel has to share the
+  // VCO and divider settings of the configured band
+  for (uint8_t i = 0U; i < count; i++) {
+    uint32_t frequency = frequencies[i];
+
+    if (!ADF7021_band(frequency, chanReg1, chanDiv) || chanReg1 != reg1)
+      return false;
+
+#if !defined(DISABLE_FREQ_BAN)
+    if (((frequency >= BAN1_MIN) && (frequency <= BAN1_MAX)) || ((frequency >= BAN2_MIN) && (frequency <= BAN2_MAX)))
+      return false;
+#endif
+  }
+
+  for (uint8_t i = 0U; i < count; i++) {
+    // The scan and the trunk only run in DMR mode
+    m_chanReg0[i] = ADF7021_dmrRxReg0(frequencies[i], div);
+    m_chanFreq[i] = frequencies[i];
+  }
+
+  bool restore = m_chanCount > 0U && count == 0U;
+
+  m_chanReg1  = reg1;
+  m_chanCount = count;
+
+  // Back to the frequency SET_FREQ configured, the retunes only changed REG0
+  if (restore) {
+    ADF7021_RX_REG0 = m_chanHome;
+    tuneRX();
+  }
+
+  return true;
+}
+
+#if defined(DUAL_RX)
+uint8_t CIO::setDualRX(uint32_t frequency)
+{
+  if (frequency == 0U) {
+    m_dualRX = false;
+    DEBUG1("IO: dual receive stopped");
+  } else {
+    // The second chip has to be the main receiver
+    if (!m_duplex)
+      return 4U;
+
+    uint32_t reg1, div;
+    ADF7021_band(m_frequency_tx, reg1, div);
+
+    // The first chip transmits as well, so it cannot leave the band
+    uint32_t dualReg1, dualDiv;
+    if (!ADF7021_band(frequency, dualReg1, dualDiv) || dualReg1 != reg1)
+      return 4U;
+
+#if !defined(DISABLE_FREQ_BAN)
+    if (((frequency >= BAN1_MIN) && (frequency <= BAN1_MAX)) || ((frequency >= BAN2_MIN) && (frequency <= BAN2_MAX)))
+      return 4U;
+#endif
+
+    m_dualReg0 = ADF7021_dmrRxReg0(frequency, div);
+    m_dualReg1 = reg1;
+    m_dualRX   = true;
+
+    DEBUG2I("IO: dual receive on", frequency);
+  }
+
+  // Otherwise the end of the transmission retunes it
+  if (!m_tx && !isSwitching()) {
+    AD7021_control_word = m_dualRX ? m_dualReg0 : ADF7021_RX_REG0;
+    Send_AD7021_control();
+  }
+
+  return 0U;
+}
+#endif
+
+void CIO::tuneChannel(uint8_t pos)
+{
+  // A new SET_FREQ may have moved the radio to another band
+  if (ADF7021_REG1 != m_chanReg1) {
+    m_chanCount = 0U;
+    DEBUG1("IO: band changed, channel scan stopped");
+    return;
+  }
+
+  m_chanPos = pos;
+
+  // Keep it for the next setRX()/ifConf2() as well
+  ADF7021_RX_REG0 = m_chanReg0[pos];
+
+  tuneRX();
+}
+
+void CIO::tuneRX()
+{
+  // Held back until the switch is latched, process() retries it
+  if (isSwitching()) {
+    m_tunePending = true;
+    return;
+  }
+
+  m_tunePending = false;
+
+  AD7021_control_word = ADF7021_RX_REG0;
+#if defined(DUPLEX)
+  if (m_duplex) {
+    Send_AD7021_control2();
+    return;
+  }
+#endif
+
+  // The only chip is transmitting, setRX() tunes it at the end
+  if (!m_tx)
+    Send_AD7021_control();
+}
+
 #if defined(ENABLE_DEBUG)
 
 uint32_t CIO::RXfreq()
 {
-  return (uint32_t)((float)(ADF7021_PFD / f_div) * ((float)((32768 * m_RX_N_divider) + m_RX_F_divider) / 32768.0)) + 100000;
+  return uint32_t((uint64_t(ADF7021_PFD) * ((32768U * m_RX_N_divider) + m_RX_F_divider)) / (f_div * 32768U)) + 100000;
 }
 
 uint32_t CIO::TXfreq()
 {
-  return (uint32_t)((float)(ADF7021_PFD / f_div) * ((float)((32768 * m_TX_N_divider) + m_TX_F_divider) / 32768.0));
+  return uint32_t((uint64_t(ADF7021_PFD) * ((32768U * m_TX_N_divider) + m_TX_F_divider)) / (f_div * 32768U));
 }
 
 uint16_t CIO::devDSTAR()
 {
-  return (uint16_t)((ADF7021_PFD * m_dstarDev) / (f_div * 65536));
+  return (uint16_t)((uint64_t(ADF7021_PFD) * m_dstarDev) / (f_div * 65536U));
 }
 
 uint16_t CIO::devDMR()
 {
-  return (uint16_t)((ADF7021_PFD * m_dmrDev) / (f_div * 65536));
+  return (uint16_t)((uint64_t(ADF7021_PFD) * m_dmrDev) / (f_div * 65536U));
 }
 
 uint16_t CIO::devYSF()
 {
-  return (uint16_t)((ADF7021_PFD * m_ysfDev) / (f_div * 65536));
+  return (uint16_t)((uint64_t(ADF7021_PFD) * m_ysfDev) / (f_div * 65536U));
 }
 
 uint16_t CIO::devP25()
 {
-  return (uint16_t)((ADF7021_PFD * m_p25Dev) / (f_div * 65536));
+  return (uint16_t)((uint64_t(ADF7021_PFD) * m_p25Dev) / (f_div * 65536U));
 }
 
 uint16_t CIO::devNXDN()
 {
-  return (uint16_t)((ADF7021_PFD * m_nxdnDev) / (f_div * 65536));
+  return (uint16_t)((uint64_t(ADF7021_PFD) * m_nxdnDev) / (f_div * 65536U));
 }
 
 uint16_t CIO::devM17()
 {
-  return (uint16_t)((ADF7021_PFD * m_m17Dev) / (f_div * 65536));
+  return (uint16_t)((uint64_t(ADF7021_PFD) * m_m17Dev) / (f_div * 65536U));
 }
 
 uint16_t CIO::devPOCSAG()
 {
-  return (uint16_t)((ADF7021_PFD * m_pocsagDev) / (f_div * 65536));
+  return (uint16_t)((uint64_t(ADF7021_PFD) * m_pocsagDev) / (f_div * 65536U));
 }
 
 void CIO::printConf()
@@ -69,7 +69,7 @@ www.analog.com/media/en/technical-documentation/data-sheets/ADF7021.pdf
 // DEMOD_CLK = 7.3728 MHz (YSF_H, M17)
 // DEMOD CLK = 3.6864 MHz (NXDN)
 // DEMOD_CLK = 7.3728 MHz (POCSAG)
-#define ADF7021_PFD              3686400.0
+#define ADF7021_PFD              3686400U
 
 // PLL (REG 01)
 #define ADF7021_REG1_VHF1        0x021F5041
@@ -180,7 +180,7 @@ www.analog.com/media/en/technical-documentation/data-sheets/ADF7021.pdf
 // DEMOD_CLK = 6.1440 MHz (DMR, YSF_H, YSF_L, P25, M17)
 // DEMOD_CLK = 3.0720 MHz (NXDN)
 // DEMOD_CLK = 6.1440 MHz (POCSAG)
-#define ADF7021_PFD              6144000.0
+#define ADF7021_PFD              6144000U
 
 // PLL (REG 01)
 #define ADF7021_REG1_VHF1        0x021F5021
@@ -310,9 +310,17 @@ www.analog.com/media/en/technical-documentation/data-sheets/ADF7021.pdf
 
 #define bitRead(value, bit) (((value) >> (bit)) & 0x01)
 
+// Approximate cost of one bit-banged word, and the delays in IOArduino.cpp,
+// used to report the bus time saved by skipped writes
+#define ADF7021_WRITE_US         10U
+#define ADF7021_RESET_US         300U
+#define ADF7021_IFCAL_US         10000U
+
 void Send_AD7021_control(bool doSle = true);
+bool Send_AD7021_update(bool force = false);
 #if defined(DUPLEX)
 void Send_AD7021_control2(bool doSle = true);
+bool Send_AD7021_update2(bool force = false);
 #endif
 
 #if defined(ADF7021_DISABLE_RC_4FSK)
@@ -109,7 +109,7 @@ CBPTC19696::CBPTC19696()
 // frame points to the start of the 33-byte burst payload (skipping the control byte).
 // This function extracts the 196 BPTC bits by skipping the 48-bit SYNC
 // and 20-bit slot-type fields, exactly like MMDVMHost CBPTC19696::decode().
-void CBPTC19696::decode(const uint8_t* frame, uint8_t* out)
+uint8_t CBPTC19696::decode(const uint8_t* frame, uint8_t* out)
 {
   // Extract 196 BPTC bits from the 264-bit burst, skipping sync and slot type.
   // DMR voice header burst layout (bit positions within frame[1..33]):
@@ -134,8 +134,10 @@ void CBPTC19696::decode(const uint8_t* frame, uint8_t* out)
   }
 
   deInterleave();
-  errorCheck();
+  uint8_t corrections = errorCheck();
   extractData(out);
+
+  return corrections;
 }
 
 void CBPTC19696::deInterleave()
@@ -144,12 +146,13 @@ void CBPTC19696::deInterleave()
     m_deInterData[i] = m_rawData[INTERLEAVE_TABLE[i]];
 }
 
-void CBPTC19696::errorCheck()
+uint8_t CBPTC19696::errorCheck()
 {
   // Iterative row/column Hamming error correction (up to 5 passes).
   // Mirrors MMDVMHost CBPTC19696::decodeErrorCheck().
   bool fixing;
   uint32_t count = 0U;
+  uint8_t corrections = 0U;
   do {
     fixing = false;
 
@@ -170,6 +173,7 @@ void CBPTC19696::errorCheck()
           wpos += 15U;
         }
         fixing = true;
+        corrections++;
       }
     }
 
@@ -177,8 +181,10 @@ void CBPTC19696::errorCheck()
     // Row r: bits at m_deInterData[r*15+1 .. r*15+15].
     for (uint32_t r = 0U; r < 9U; r++) {
       uint32_t pos = (r * 15U) + 1U;
-      if (hammingDecode15113_2(m_deInterData + pos))
+      if (hammingDecode15113_2(m_deInterData + pos)) {
         fixing = true;
+        corrections++;
+      }
     }
 
     count++;
@@ -198,6 +204,8 @@ void CBPTC19696::errorCheck()
     // For now, this is a silent indicator that frame had parity issues
     #endif
   }
+
+  return corrections;
 }
 
 // Encode 12 clean LC bytes into a BPTC(196,96) codeword and write the corrected
@@ -19,7 +19,8 @@ class CBPTC19696
 public:
   CBPTC19696();
 
-  void decode(const uint8_t* in, uint8_t* out);
+  // Returns the number of bits the row and column codes corrected
+  uint8_t decode(const uint8_t* in, uint8_t* out);
   void encode(const uint8_t* data, uint8_t* frame);
 
 private:
@@ -27,7 +28,7 @@ private:
   bool m_deInterData[196];
 
   void deInterleave();
-  void errorCheck();
+  uint8_t errorCheck();
   void extractData(uint8_t* data) const;
 };
 
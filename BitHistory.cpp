@@ -0,0 +1,107 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "Config.h"
+#include "Globals.h"
+#include "BitHistory.h"
+
+const uint8_t BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
+
+#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
+#define READ_BIT1(p,i)    ((p[(i)>>3] & BIT_MASK_TABLE[(i)&7]) >> (7 - ((i)&7)))
+
+CBitHistory::CBitHistory() :
+m_buffer(),
+m_pattern(0U),
+m_ptr(BIT_HISTORY_LENGTH_BITS - 1U),
+m_count(0U)
+{
+}
+
+void CBitHistory::reset()
+{
+  ::memset(m_buffer, 0x00U, sizeof(m_buffer));
+
+  m_pattern = 0U;
+  m_ptr     = BIT_HISTORY_LENGTH_BITS - 1U;
+  m_count   = 0U;
+}
+
+void CBitHistory::add(bool bit)
+{
+  m_ptr++;
+  if (m_ptr >= BIT_HISTORY_LENGTH_BITS)
+    m_ptr = 0U;
+
+  WRITE_BIT1(m_buffer, m_ptr, bit);
+
+  m_pattern <<= 1;
+  if (bit)
+    m_pattern |= 0x01U;
+
+  if (m_count < BIT_HISTORY_LENGTH_BITS)
+    m_count++;
+}
+
+uint16_t CBitHistory::getPtr() const
+{
+  return m_ptr;
+}
+
+uint64_t CBitHistory::getPattern() const
+{
+  return m_pattern;
+}
+
+uint16_t CBitHistory::getCount() const
+{
+  return m_count;
+}
+
+bool CBitHistory::getBit(uint16_t pos) const
+{
+  return READ_BIT1(m_buffer, pos) != 0U;
+}
+
+uint8_t CBitHistory::match(const BITHISTORY_PATTERN* patterns, uint8_t count) const
+{
+  for (uint8_t i = 0U; i < count; i++) {
+    if (countBits64((m_pattern & patterns[i].mask) ^ patterns[i].data) <= patterns[i].errs)
+      return i;
+  }
+
+  return count;
+}
+
+void CBitHistory::getBytes(uint16_t pos, uint8_t count, uint8_t* buffer) const
+{
+  for (uint8_t i = 0U; i < count; i++) {
+    uint8_t value = 0U;
+
+    for (uint8_t j = 0U; j < 8U; j++) {
+      value = (value << 1) | READ_BIT1(m_buffer, pos);
+
+      pos++;
+      if (pos >= BIT_HISTORY_LENGTH_BITS)
+        pos = 0U;
+    }
+
+    buffer[i] = value;
+  }
+}
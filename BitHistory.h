@@ -0,0 +1,71 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(BITHISTORY_H)
+#define  BITHISTORY_H
+
+#include <stdint.h>
+
+// Received bits kept for the receivers, two DMR bursts
+const uint16_t BIT_HISTORY_LENGTH_BITS = 576U;
+
+// A sync word for match(), data is in the low bits of the pattern
+struct BITHISTORY_PATTERN {
+  uint64_t data;
+  uint64_t mask;
+  uint8_t  errs;
+};
+
+// One record of the received bit stream shared by all receivers. CIO adds
+// each bit once and the receivers keep their own positions into it, so
+// switching between them keeps the history instead of starting cold.
+class CBitHistory {
+public:
+  CBitHistory();
+
+  void add(bool bit);
+
+  // Position of the newest bit
+  uint16_t getPtr() const;
+
+  // The newest 64 bits, the newest in bit 0
+  uint64_t getPattern() const;
+
+  // Bits received so far, up to the history length
+  uint16_t getCount() const;
+
+  bool getBit(uint16_t pos) const;
+
+  // Index of the first pattern within its error limit on the newest bits,
+  // or count when none is
+  uint8_t match(const BITHISTORY_PATTERN* patterns, uint8_t count) const;
+
+  // Packs count bytes starting at pos, wrapping around the history
+  void getBytes(uint16_t pos, uint8_t count, uint8_t* buffer) const;
+
+  void reset();
+
+private:
+  uint8_t  m_buffer[BIT_HISTORY_LENGTH_BITS / 8U];
+  uint64_t m_pattern;
+  uint16_t m_ptr;
+  uint16_t m_count;
+};
+
+#endif
@@ -86,6 +86,54 @@ bool CBitRB::put(uint8_t bit, uint8_t control)
   return true;
 }
 
+uint16_t CBitRB::putBytes(const uint8_t* data, uint16_t length)
+{
+  // The reader only frees space, so it is checked once
+  uint16_t n = getSpace() / 8U;
+  if (n < length) {
+    m_overflow = true;
+    length = n;
+  }
+
+  uint16_t bytes  = m_length / 8U;
+  uint16_t offset = m_head & 7U;
+  uint16_t pos    = m_head >> 3;
+
+  for (uint16_t i = 0U; i < length; i++) {
+    uint8_t c = data[i];
+
+    if (offset == 0U) {
+      m_bits[pos]    = c;
+      m_control[pos] = 0x00U;
+    } else {
+      // Straddles two bytes, keeping the bits around it
+      uint8_t mask = 0xFFU >> offset;
+      m_bits[pos]    = (m_bits[pos] & ~mask) | (c >> offset);
+      m_control[pos] = m_control[pos] & ~mask;
+
+      uint16_t next = pos + 1U;
+      if (next >= bytes)
+        next = 0U;
+
+      m_bits[next]    = (m_bits[next] & mask) | uint8_t(c << (8U - offset));
+      m_control[next] = m_control[next] & mask;
+    }
+
+    pos++;
+    if (pos >= bytes)
+      pos = 0U;
+  }
+
+  if (length > 0U) {
+    m_head = (pos << 3) + offset;
+
+    if (m_head == m_tail)
+      m_full = true;
+  }
+
+  return length;
+}
+
 bool CBitRB::get(uint8_t& bit, uint8_t& control)
 {
   if (m_head == m_tail && !m_full)
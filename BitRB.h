@@ -42,6 +42,10 @@ public:
 
   bool put(uint8_t bit, uint8_t control);
 
+  // Packed bytes, MSB first, with no control marks. Returns the number of
+  // bytes stored.
+  uint16_t putBytes(const uint8_t* data, uint16_t length);
+
   bool get(uint8_t& bit, uint8_t& control);
 
   bool hasOverflowed();
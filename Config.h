@@ -33,6 +33,13 @@
 // Mobile Station Mode
 #define MS_MODE
 
+// Dual receive, the first ADF7021 listens on a second DMR downlink set by
+// the host (needs DUPLEX and MS_MODE). Opt-in, not yet tried on hardware:
+// it costs about 600 bytes of RAM for the second bit ring, bit history,
+// receiver and diversity buffer, and the last heard reply grows from two
+// slots to four
+//#define DUAL_RX
+
 // Debug Mode
 #define ENABLE_DEBUG
 
@@ -0,0 +1,138 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRCSBK.h"
+#include "BPTC19696.h"
+
+// ETSI TS 102 361-1 table B.21, over the two CRC bytes
+const uint8_t CSBK_CRC_MASK[2U] = {0xA5U, 0xA5U};
+
+// Opcodes with the standard feature set, ETSI TS 102 361-2 and -4
+const uint8_t CSBKO_UU_V_REQ       = 0x04U;
+const uint8_t CSBKO_UU_ANS_RSP     = 0x05U;
+const uint8_t CSBKO_CT_CSBK        = 0x07U;
+const uint8_t CSBKO_C_ALOHA        = 0x19U;
+const uint8_t CSBKO_C_AHOY         = 0x1CU;
+const uint8_t CSBKO_CALL_ALERT     = 0x1FU;
+const uint8_t CSBKO_CALL_ALERT_ACK = 0x20U;
+const uint8_t CSBKO_RADIO_CHECK    = 0x24U;
+const uint8_t CSBKO_NACK_RSP       = 0x26U;
+const uint8_t CSBKO_EMERGENCY      = 0x27U;
+const uint8_t CSBKO_C_BCAST        = 0x28U;
+const uint8_t CSBKO_P_CLEAR        = 0x2EU;
+const uint8_t CSBKO_P_PROTECT      = 0x2FU;
+const uint8_t CSBKO_PV_GRANT       = 0x30U;
+const uint8_t CSBKO_PD_GRANT_DX    = 0x36U;
+const uint8_t CSBKO_BS_DWN_ACT     = 0x38U;
+const uint8_t CSBKO_PRE_CSBK       = 0x3DU;
+
+const uint8_t FID_STANDARD         = 0x00U;
+
+bool CDMRCSBK::decode(const uint8_t* data, DMRCSBK_T* csbk)
+{
+  uint8_t payload[12U];
+  CBPTC19696 bptc;
+  bptc.decode(data + 1U, payload);
+
+  return decodePayload(payload, csbk);
+}
+
+bool CDMRCSBK::decodePayload(const uint8_t* payload, DMRCSBK_T* csbk)
+{
+  memcpy(csbk->rawData, payload, 12U);
+
+  csbk->rawData[10U] ^= CSBK_CRC_MASK[0U];
+  csbk->rawData[11U] ^= CSBK_CRC_MASK[1U];
+
+  if (!checkCRC(csbk->rawData))
+    return false;
+
+  csbk->LB    = (csbk->rawData[0U] & 0x80U) != 0;
+  csbk->PF    = (csbk->rawData[0U] & 0x40U) != 0;
+  csbk->CSBKO = csbk->rawData[0U] & 0x3FU;
+  csbk->FID   = csbk->rawData[1U];
+
+  csbk->dstId = (uint32_t(csbk->rawData[4U]) << 16) | (uint32_t(csbk->rawData[5U]) << 8) | uint32_t(csbk->rawData[6U]);
+  csbk->srcId = (uint32_t(csbk->rawData[7U]) << 16) | (uint32_t(csbk->rawData[8U]) << 8) | uint32_t(csbk->rawData[9U]);
+
+  csbk->csbkClass = classify(csbk->CSBKO, csbk->FID);
+
+  // A grant names the channel and slot of the call, then its late entry,
+  // emergency and offset flags
+  if (csbk->csbkClass == DMRCC_GRANT) {
+    csbk->channel = (uint16_t(csbk->rawData[2U]) << 4) | (csbk->rawData[3U] >> 4);
+    csbk->slot    = (csbk->rawData[3U] >> 3) & 0x01U;
+  } else {
+    csbk->channel = 0U;
+    csbk->slot    = 0U;
+  }
+
+  return true;
+}
+
+// CRC-CCITT over the first ten bytes, preset to zero and inverted, sent
+// high byte first
+bool CDMRCSBK::checkCRC(const uint8_t* data)
+{
+  uint16_t crc = 0x0000U;
+
+  for (uint8_t i = 0U; i < 10U; i++) {
+    crc ^= uint16_t(data[i]) << 8;
+    for (uint8_t j = 0U; j < 8U; j++)
+      crc = (crc & 0x8000U) ? uint16_t((crc << 1) ^ 0x1021U) : uint16_t(crc << 1);
+  }
+
+  crc = ~crc;
+
+  return data[10U] == (crc >> 8) && data[11U] == (crc & 0xFFU);
+}
+
+DMR_CSBK_CLASS CDMRCSBK::classify(uint8_t csbko, uint8_t fid)
+{
+  if (fid != FID_STANDARD)
+    return DMRCC_OTHER;
+
+  if (csbko >= CSBKO_PV_GRANT && csbko <= CSBKO_PD_GRANT_DX)
+    return DMRCC_GRANT;
+
+  switch (csbko) {
+    case CSBKO_PRE_CSBK:
+      return DMRCC_PREAMBLE;
+    case CSBKO_UU_V_REQ:
+    case CSBKO_UU_ANS_RSP:
+    case CSBKO_CALL_ALERT:
+    case CSBKO_CALL_ALERT_ACK:
+    case CSBKO_RADIO_CHECK:
+    case CSBKO_NACK_RSP:
+    case CSBKO_EMERGENCY:
+      return DMRCC_CALL;
+    case CSBKO_CT_CSBK:
+    case CSBKO_C_ALOHA:
+    case CSBKO_C_AHOY:
+    case CSBKO_C_BCAST:
+    case CSBKO_P_CLEAR:
+    case CSBKO_P_PROTECT:
+    case CSBKO_BS_DWN_ACT:
+      return DMRCC_CONTROL;
+    default:
+      return DMRCC_OTHER;
+  }
+}
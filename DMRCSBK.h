@@ -0,0 +1,61 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(DMRCSBK_H)
+#define  DMRCSBK_H
+
+#include <stdint.h>
+
+// What a CSBK is for, as far as forwarding it goes
+enum DMR_CSBK_CLASS : uint8_t {
+  DMRCC_PREAMBLE,   // Preamble ahead of a data or voice call
+  DMRCC_CALL,       // Unit to unit call set-up, alerts and radio checks
+  DMRCC_GRANT,      // Tier III channel grants
+  DMRCC_CONTROL,    // Tier III control channel and BS signalling
+  DMRCC_OTHER       // Manufacturer specific and unknown opcodes
+};
+
+struct DMRCSBK_T {
+  bool           LB;         // Last Block
+  bool           PF;         // Protect Flag
+  uint8_t        CSBKO;      // CSBK Opcode
+  uint8_t        FID;        // Feature ID
+  uint32_t       dstId;      // Target address, for the opcodes that carry one here
+  uint32_t       srcId;      // Source address, likewise
+  uint16_t       channel;    // Logical physical channel of a grant
+  uint8_t        slot;       // Timeslot of a grant, 0 for TS1
+  DMR_CSBK_CLASS csbkClass;
+  uint8_t        rawData[12];// Unmasked 12-byte CSBK
+};
+
+class CDMRCSBK
+{
+public:
+  // data[0] is the control byte, as for CDMRLC::decode(). Returns false
+  // when the CRC fails.
+  static bool decode(const uint8_t* data, DMRCSBK_T* csbk);
+  // As decode(), for the 12 bytes a BPTC(196,96) decode already produced
+  static bool decodePayload(const uint8_t* payload, DMRCSBK_T* csbk);
+
+private:
+  static bool           checkCRC(const uint8_t* data);
+  static DMR_CSBK_CLASS classify(uint8_t csbko, uint8_t fid);
+};
+
+#endif
@@ -33,14 +33,9 @@ const uint8_t CONTROL_NONE  = 0x00U;
 const uint8_t CONTROL_VOICE = 0x20U;
 const uint8_t CONTROL_DATA  = 0x40U;
 
-const uint8_t BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
-
-#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
-#define READ_BIT1(p,i)    ((p[(i)>>3] & BIT_MASK_TABLE[(i)&7]) >> (7 - ((i)&7)))
-
 CDMRDMORX::CDMRDMORX() :
-m_patternBuffer(0x00U),
-m_buffer(),
+m_frameBuffer(),
+frame(m_frameBuffer + DMR_FRAME_HEADROOM),
 m_dataPtr(0U),
 m_syncPtr(0U),
 m_startPtr(0U),
@@ -64,13 +59,9 @@ void CDMRDMORX::reset()
   m_endPtr    = NOENDPTR;
 }
 
-void CDMRDMORX::databit(bool bit)
+void CDMRDMORX::databit()
 {
-  WRITE_BIT1(m_buffer, m_dataPtr, bit);
-
-  m_patternBuffer <<= 1;
-  if (bit)
-    m_patternBuffer |= 0x01U;
+  m_dataPtr = bitHistory.getPtr();
 
   if (m_state == DMORXS_NONE) {
     correlateSync();
@@ -96,16 +87,16 @@ void CDMRDMORX::databit(bool bit)
   if (m_dataPtr == m_endPtr) {
     frame[0U] = m_control;
 
-    bitsToBytes(m_startPtr, DMR_FRAME_LENGTH_BYTES, frame + 1U);
+    bitHistory.getBytes(m_startPtr, DMR_FRAME_LENGTH_BYTES, frame + 1U);
 
     if (m_control == CONTROL_DATA) {
       // Data sync
       uint8_t colorCode;
       uint8_t dataType;
       CDMRSlotType slotType;
-      slotType.decode(frame + 1U, colorCode, dataType);
+      uint8_t errs = slotType.decode(frame + 1U, colorCode, dataType);
 
-      if (colorCode == m_colorCode) {
+      if (errs <= DMR_SLOT_TYPE_MAX_ERRS && colorCode == m_colorCode) {
         m_syncCount = 0U;
         m_n         = 0U;
 
@@ -177,7 +168,7 @@ void CDMRDMORX::databit(bool bit)
         } else {
           frame[0U] = ++m_n;
         }
-        serial.writeDMRData(true, &frame[1], DMR_FRAME_LENGTH_BYTES);
+        serial.writeDMRFrame(true, &frame[1], DMR_FRAME_LENGTH_BYTES);
       } else if (m_state == DMORXS_DATA) {
         if (m_type != 0x00U) {
           frame[0U] = CONTROL_DATA | m_type;
@@ -190,34 +181,30 @@ void CDMRDMORX::databit(bool bit)
     m_control = CONTROL_NONE;
   }
 
-  m_dataPtr++;
-
-  if (m_dataPtr >= DMO_BUFFER_LENGTH_BITS)
-    m_dataPtr = 0U;
-
   io.setDecode(m_state != DMORXS_NONE);
 }
 
 void CDMRDMORX::correlateSync()
 {
-  uint8_t control = CONTROL_NONE;
+  uint8_t  control = CONTROL_NONE;
+  uint64_t pattern = bitHistory.getPattern() & DMR_SYNC_BITS_MASK;
 
-  if (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_BS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
+  if (countBits64(pattern ^ DMR_BS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
     control = CONTROL_DATA;
-  } else if (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_BS_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
+  } else if (countBits64(pattern ^ DMR_BS_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
     control = CONTROL_VOICE;
-  } else if (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_BS_DATA_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) {
+  } else if (countBits64(pattern ^ DMR_BS_DATA_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) {
     control = CONTROL_DATA;
-  } else if (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_BS_VOICE_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) {
+  } else if (countBits64(pattern ^ DMR_BS_VOICE_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) {
     control = CONTROL_VOICE;
 #if !defined(MS_MODE)
-  } else if ( (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) || \
-    (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_S2_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) || \
-    (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_DATA_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) ) {
+  } else if ( (countBits64(pattern ^ DMR_MS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) || \
+    (countBits64(pattern ^ DMR_S2_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) || \
+    (countBits64(pattern ^ DMR_MS_DATA_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) ) {
     control = CONTROL_DATA;
-  } else if ( (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) || \
-    (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_S2_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) || \
-    (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_VOICE_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) ) {
+  } else if ( (countBits64(pattern ^ DMR_MS_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) || \
+    (countBits64(pattern ^ DMR_S2_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) || \
+    (countBits64(pattern ^ DMR_MS_VOICE_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) ) {
     control = CONTROL_VOICE;
 #endif
   }
@@ -239,46 +226,6 @@ void CDMRDMORX::correlateSync()
   }
 }
 
-void CDMRDMORX::bitsToBytes(uint16_t start, uint8_t count, uint8_t* buffer)
-{
-  for (uint8_t i = 0U; i < count; i++) {
-
-  buffer[i]  = 0U;
-  buffer[i] |= READ_BIT1(m_buffer, start) << 7;
-  start++;
-  if (start >= DMO_BUFFER_LENGTH_BITS)
-    start -= DMO_BUFFER_LENGTH_BITS;
-  buffer[i] |= READ_BIT1(m_buffer, start) << 6;
-  start++;
-  if (start >= DMO_BUFFER_LENGTH_BITS)
-    start -= DMO_BUFFER_LENGTH_BITS;
-  buffer[i] |= READ_BIT1(m_buffer, start) << 5;
-  start++;
-  if (start >= DMO_BUFFER_LENGTH_BITS)
-    start -= DMO_BUFFER_LENGTH_BITS;
-  buffer[i] |= READ_BIT1(m_buffer, start) << 4;
-  start++;
-  if (start >= DMO_BUFFER_LENGTH_BITS)
-    start -= DMO_BUFFER_LENGTH_BITS;
-  buffer[i] |= READ_BIT1(m_buffer, start) << 3;
-  start++;
-  if (start >= DMO_BUFFER_LENGTH_BITS)
-    start -= DMO_BUFFER_LENGTH_BITS;
-  buffer[i] |= READ_BIT1(m_buffer, start) << 2;
-  start++;
-  if (start >= DMO_BUFFER_LENGTH_BITS)
-    start -= DMO_BUFFER_LENGTH_BITS;
-  buffer[i] |= READ_BIT1(m_buffer, start) << 1;
-  start++;
-  if (start >= DMO_BUFFER_LENGTH_BITS)
-    start -= DMO_BUFFER_LENGTH_BITS;
-  buffer[i] |= READ_BIT1(m_buffer, start) << 0;
-  start++;
-  if (start >= DMO_BUFFER_LENGTH_BITS)
-    start -= DMO_BUFFER_LENGTH_BITS;
-  }
-}
-
 void CDMRDMORX::setColorCode(uint8_t colorCode)
 {
   m_colorCode = colorCode;
@@ -292,9 +239,9 @@ void CDMRDMORX::writeRSSIData(uint8_t* frame)
   frame[34U] = (rssi >> 8) & 0xFFU;
   frame[35U] = (rssi >> 0) & 0xFFU;
   
-  serial.writeDMRData(true, frame, DMR_FRAME_LENGTH_BYTES + 3U);
+  serial.writeDMRFrame(true, frame, DMR_FRAME_LENGTH_BYTES + 3U);
 #else
-  serial.writeDMRData(true, &frame[1], DMR_FRAME_LENGTH_BYTES);
+  serial.writeDMRFrame(true, &frame[1], DMR_FRAME_LENGTH_BYTES);
 #endif
 }
 
@@ -21,8 +21,9 @@
 #define  DMRDMORX_H
 
 #include "DMRDefines.h"
+#include "BitHistory.h"
 
-const uint16_t DMO_BUFFER_LENGTH_BITS = 576U;
+const uint16_t DMO_BUFFER_LENGTH_BITS = BIT_HISTORY_LENGTH_BITS;
 
 enum DMORX_STATE {
   DMORXS_NONE,
@@ -34,15 +35,15 @@ class CDMRDMORX {
 public:
   CDMRDMORX();
 
-  void databit(bool bit);
+  // Processes the newest bit in the shared bit history
+  void databit();
   void setColorCode(uint8_t colorCode);
 
   void reset();
 
 private:
-  uint64_t    m_patternBuffer;
-  uint8_t     m_buffer[DMO_BUFFER_LENGTH_BITS / 8U];  // 72 bytes
-  uint8_t     frame[DMR_FRAME_LENGTH_BYTES + 3U];
+  uint8_t     m_frameBuffer[DMR_FRAME_HEADROOM + DMR_FRAME_LENGTH_BYTES + 3U];
+  uint8_t*    frame;
   uint16_t    m_dataPtr;
   uint16_t    m_syncPtr;
   uint16_t    m_startPtr;
@@ -55,7 +56,6 @@ private:
   uint8_t     m_type;
 
   void correlateSync();
-  void bitsToBytes(uint16_t start, uint8_t count, uint8_t* buffer);
   void writeRSSIData(uint8_t* frame);
 
 };
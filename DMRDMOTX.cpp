@@ -52,9 +52,12 @@ void CDMRDMOTX::process()
   }
   else {
     if (m_poLen == 0U && m_fifo.getData() > 0U) {
-      if (!m_tx) {
+      // A transmitter still switching off needs the TX delay again
+      if (!m_tx || io.isSwitching()) {
         m_delay = true;
         m_poLen = m_txDelay;
+        // The delay is sent from the buffer as many times as it takes
+        memset(m_poBuffer, DMR_SYNC, sizeof(m_poBuffer));
         DEBUG1("DMRDMOTX: Delaying transmission");  
       } else {
         m_delay = false;
@@ -72,23 +75,32 @@ void CDMRDMOTX::process()
   }
 
   if (m_poLen > 0U) {
+    // Whole bytes that leave at least a bit of space in the ring
     uint16_t space = io.getSpace();
+    if (space <= 8U)
+      return;
 
-    while (space > 8U) {
-      if (m_delay) {
-        m_poPtr++;
-        writeByte(DMR_SYNC);
-      } else
-          writeByte(m_poBuffer[m_poPtr++]);   
+    uint16_t n = (space - 1U) / 8U;
+    if (n > (m_poLen - m_poPtr))
+      n = m_poLen - m_poPtr;
 
-      space -= 8U;
+    if (m_delay) {
+      m_poPtr += n;
 
-      if (m_poPtr >= m_poLen) {
-        m_poPtr = 0U;
-        m_poLen = 0U;
-        m_delay = false;
-        return;
+      while (n > 0U) {
+        uint16_t len = (n > sizeof(m_poBuffer)) ? sizeof(m_poBuffer) : n;
+        io.writeBytes(m_poBuffer, len);
+        n -= len;
       }
+    } else {
+      io.writeBytes(m_poBuffer + m_poPtr, n);
+      m_poPtr += n;
+    }
+
+    if (m_poPtr >= m_poLen) {
+      m_poPtr = 0U;
+      m_poLen = 0U;
+      m_delay = false;
     }
   }
 }
@@ -108,21 +120,6 @@ uint8_t CDMRDMOTX::writeData(const uint8_t* data, uint8_t length)
   return 0U;
 }
 
-void CDMRDMOTX::writeByte(uint8_t c)
-{
-  uint8_t bit;
-  uint8_t mask = 0x80U;
-
-  for (uint8_t i = 0U; i < 8U; i++, c <<= 1) {
-    if ((c & mask) == mask)
-      bit = 1U;
-    else
-      bit = 0U;
-
-    io.write(&bit, 1);
-  }
-}
-
 void CDMRDMOTX::setCal(bool start)
 {
   m_cal = start ? true : false;
@@ -48,7 +48,6 @@ private:
   bool                 m_delay;
   bool                 m_cal;
 
-  void writeByte(uint8_t c);
   void createCal();
 
 };
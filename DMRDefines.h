@@ -25,6 +25,10 @@ const unsigned int DMR_FRAME_LENGTH_BYTES   = 33U;
 const unsigned int DMR_FRAME_LENGTH_BITS    = DMR_FRAME_LENGTH_BYTES * 8U;
 const unsigned int DMR_FRAME_LENGTH_SYMBOLS = DMR_FRAME_LENGTH_BYTES * 4U;
 
+// Room kept in front of received frames for the MMDVM serial header and
+// the receiver tag of a second receiver's frames
+const unsigned int DMR_FRAME_HEADROOM = 4U;
+
 const unsigned int DMR_SYNC_LENGTH_BYTES   = 6U;
 const unsigned int DMR_SYNC_LENGTH_BITS    = DMR_SYNC_LENGTH_BYTES * 8U;
 const unsigned int DMR_SYNC_LENGTH_SYMBOLS = DMR_SYNC_LENGTH_BYTES * 4U;
@@ -48,6 +52,16 @@ const unsigned int DMR_CACH_LENGTH_BYTES   = 3U;
 const unsigned int DMR_CACH_LENGTH_BITS    = DMR_CACH_LENGTH_BYTES * 8U;
 const unsigned int DMR_CACH_LENGTH_SYMBOLS = DMR_CACH_LENGTH_BYTES * 4U;
 
+// The 17 Short LC bits of a CACH, the other seven are the TACT at 0, 4, 8,
+// 12, 14, 18 and 22 (ETSI TS 102 361-1 annex B, CACH interleaving)
+const uint8_t  DMR_CACH_PAYLOAD[] = {1U, 2U, 3U, 5U, 6U, 7U, 9U, 10U, 11U, 13U, 15U, 16U, 17U, 19U, 20U, 21U, 23U};
+
+// LCSS of the TACT, where a CACH's bits sit in the Short LC
+const uint8_t  DMR_LCSS_SINGLE       = 0U;
+const uint8_t  DMR_LCSS_FIRST        = 1U;
+const uint8_t  DMR_LCSS_LAST         = 2U;
+const uint8_t  DMR_LCSS_CONTINUATION = 3U;
+
 const uint8_t  DMR_SYNC_BYTES_LENGTH     = 7U;
 const uint8_t  DMR_MS_DATA_SYNC_BYTES[]  = {0x0DU, 0x5DU, 0x7FU, 0x77U, 0xFDU, 0x75U, 0x70U};
 const uint8_t  DMR_MS_VOICE_SYNC_BYTES[] = {0x07U, 0xF7U, 0xD5U, 0xDDU, 0x57U, 0xDFU, 0xD0U};
@@ -0,0 +1,142 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "Config.h"
+
+#if defined(DUAL_RX)
+
+#include "Globals.h"
+#include "DMRDiversity.h"
+#include <string.h>
+
+// Copies of one burst end this close together, a whole slot is 576 ticks
+const uint32_t DIVERSITY_MATCH_TICKS = 2U * DMR_DIVERSITY_HOLD_BITS;
+
+CDMRDiversity::CDMRDiversity() :
+m_enabled(false),
+m_buffer(),
+m_pending(false),
+m_receiver(0U),
+m_slot(false),
+m_control(0U),
+m_length(0U),
+m_cost(0U),
+m_endTime(0U),
+m_hold(0U)
+{
+}
+
+void CDMRDiversity::setEnabled(bool enabled)
+{
+  if (!enabled)
+    flush();
+
+  m_enabled = enabled;
+
+  DEBUG2("DMRDiversity: enabled", enabled ? 1 : 0);
+}
+
+bool CDMRDiversity::isEnabled() const
+{
+  return m_enabled;
+}
+
+void CDMRDiversity::write(uint8_t receiver, bool slot, uint8_t control, uint8_t* data, uint8_t length, uint8_t cost, uint32_t endTime)
+{
+  // Paired by time alone, a slot is 576 ticks, so a receiver that has the
+  // slot wrong after a bad CACH does not put the burst out twice
+  if (m_pending && m_receiver != receiver) {
+    uint32_t diff = (endTime > m_endTime) ? (endTime - m_endTime) : (m_endTime - endTime);
+    if (diff <= DIVERSITY_MATCH_TICKS) {
+      m_pending = false;
+
+      // On a tie the copy that arrived first has already waited long enough
+      if (cost < m_cost)
+        forward(slot, control, data, length, endTime);
+      else
+        forward(m_slot, m_control, m_buffer + DMR_FRAME_HEADROOM, m_length, m_endTime);
+      return;
+    }
+  }
+
+  // Not the other half of the held burst, that one goes out on its own
+  flush();
+
+  if (length > (DMR_FRAME_LENGTH_BYTES + 3U))
+    length = DMR_FRAME_LENGTH_BYTES + 3U;
+
+  memcpy(m_buffer + DMR_FRAME_HEADROOM, data, length);
+
+  m_pending  = true;
+  m_receiver = receiver;
+  m_slot     = slot;
+  m_control  = control;
+  m_length   = length;
+  m_cost     = cost;
+  m_endTime  = endTime;
+  m_hold     = DMR_DIVERSITY_HOLD_BITS;
+}
+
+void CDMRDiversity::writeLost(uint8_t receiver, bool slot)
+{
+  const CDMRRX& other = (receiver == 0U) ? dmrRX2 : dmrRX;
+  if (other.isActive(slot ? 1U : 0U))
+    return;
+
+  flush();
+
+  serial.writeDMRLost(slot, 0U);
+}
+
+void CDMRDiversity::clock()
+{
+  if (!m_pending)
+    return;
+
+  m_hold--;
+  if (m_hold == 0U)
+    flush();
+}
+
+void CDMRDiversity::reset()
+{
+  m_pending = false;
+  m_hold    = 0U;
+}
+
+void CDMRDiversity::flush()
+{
+  if (!m_pending)
+    return;
+
+  m_pending = false;
+
+  forward(m_slot, m_control, m_buffer + DMR_FRAME_HEADROOM, m_length, m_endTime);
+}
+
+void CDMRDiversity::forward(bool slot, uint8_t control, uint8_t* data, uint8_t length, uint32_t endTime)
+{
+  // Whichever receiver won, the host sees a single main downlink
+  serial.writeDMRFrame(slot, data, length, 0U);
+
+  // To the UART queue, as CDMRSlotRX::writeHost() has it
+  dmrLatency.add(control, io.getTicks() - endTime);
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(DMRDIVERSITY_H)
+#define  DMRDIVERSITY_H
+
+#include "Config.h"
+
+#if defined(DUAL_RX)
+
+#include "DMRDefines.h"
+
+// How long the first copy of a burst waits for the other receiver's copy
+const uint8_t DMR_DIVERSITY_HOLD_BITS = 16U;
+
+// Combines the two receivers when both are on the same downlink, each burst
+// is offered by both and only the copy with the lower cost goes to the host
+class CDMRDiversity {
+public:
+  CDMRDiversity();
+
+  void setEnabled(bool enabled);
+  bool isEnabled() const;
+
+  // Cost is the estimated number of bit errors in the burst, endTime the tick
+  // its last bit was received on, data is laid out as for
+  // CSerialPort::writeDMRFrame()
+  void write(uint8_t receiver, bool slot, uint8_t control, uint8_t* data, uint8_t length, uint8_t cost, uint32_t endTime);
+
+  // The call is lost once neither receiver holds it
+  void writeLost(uint8_t receiver, bool slot);
+
+  // Called once per received bit
+  void clock();
+
+  void reset();
+
+private:
+  bool     m_enabled;
+  uint8_t  m_buffer[DMR_FRAME_HEADROOM + DMR_FRAME_LENGTH_BYTES + 3U];
+  bool     m_pending;
+  uint8_t  m_receiver;
+  bool     m_slot;
+  uint8_t  m_control;
+  uint8_t  m_length;
+  uint8_t  m_cost;
+  uint32_t m_endTime;
+  uint8_t  m_hold;
+
+  void flush();
+  void forward(bool slot, uint8_t control, uint8_t* data, uint8_t length, uint32_t endTime);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,177 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRFilter.h"
+
+const uint8_t DMR_FILTER_RANGE_LENGTH = 6U;
+
+CDMRFilter::CDMRFilter() :
+m_mode(DMRFM_OFF),
+m_tg(),
+m_tgCount(0U),
+m_src(),
+m_srcCount(0U),
+m_csbkDrop(0U)
+{
+}
+
+void CDMRFilter::reset()
+{
+  m_mode     = DMRFM_OFF;
+  m_tgCount  = 0U;
+  m_srcCount = 0U;
+  m_csbkDrop = 0U;
+}
+
+uint8_t CDMRFilter::setFilter(const uint8_t* data, uint8_t length)
+{
+  if (length < 3U)
+    return 4U;
+
+  uint8_t mode     = data[0U];
+  uint8_t tgCount  = data[1U];
+  uint8_t srcCount = data[2U];
+
+  if (mode > uint8_t(DMRFM_DENY))
+    return 4U;
+
+  if (tgCount > DMR_FILTER_MAX_RANGES || srcCount > DMR_FILTER_MAX_RANGES)
+    return 4U;
+
+  if (length != (3U + (tgCount + srcCount) * DMR_FILTER_RANGE_LENGTH))
+    return 4U;
+
+  // Build the new tables aside so a bad frame leaves the old filter in place
+  DMRFILTER_RANGE tg[DMR_FILTER_MAX_RANGES];
+  DMRFILTER_RANGE src[DMR_FILTER_MAX_RANGES];
+
+  uint8_t tgLen = load(data + 3U, tgCount, tg);
+  if (tgLen == 0U && tgCount > 0U)
+    return 4U;
+
+  uint8_t srcLen = load(data + 3U + tgCount * DMR_FILTER_RANGE_LENGTH, srcCount, src);
+  if (srcLen == 0U && srcCount > 0U)
+    return 4U;
+
+  for (uint8_t i = 0U; i < tgLen; i++)
+    m_tg[i] = tg[i];
+  for (uint8_t i = 0U; i < srcLen; i++)
+    m_src[i] = src[i];
+
+  m_tgCount  = tgLen;
+  m_srcCount = srcLen;
+  m_mode     = DMR_FILTER_MODE(mode);
+
+  DEBUG4("DMRFilter: mode/talkgroup ranges/source ranges", mode, tgLen, srcLen);
+
+  return 0U;
+}
+
+// Returns the number of ranges after sorting and merging, 0 on a bad range
+uint8_t CDMRFilter::load(const uint8_t* data, uint8_t count, DMRFILTER_RANGE* ranges)
+{
+  for (uint8_t i = 0U; i < count; i++, data += DMR_FILTER_RANGE_LENGTH) {
+    DMRFILTER_RANGE range;
+    range.start = (uint32_t(data[0U]) << 16) | (uint32_t(data[1U]) << 8) | uint32_t(data[2U]);
+    range.end   = (uint32_t(data[3U]) << 16) | (uint32_t(data[4U]) << 8) | uint32_t(data[5U]);
+
+    if (range.start > range.end)
+      return 0U;
+
+    // Insertion sort on the start ID, the tables are tiny
+    uint8_t j = i;
+    while (j > 0U && ranges[j - 1U].start > range.start) {
+      ranges[j] = ranges[j - 1U];
+      j--;
+    }
+    ranges[j] = range;
+  }
+
+  if (count == 0U)
+    return 0U;
+
+  // Merge overlapping and adjacent ranges so the search only has to look at one
+  uint8_t n = 0U;
+  for (uint8_t i = 1U; i < count; i++) {
+    if (ranges[i].start <= ranges[n].end + 1U) {
+      if (ranges[i].end > ranges[n].end)
+        ranges[n].end = ranges[i].end;
+    } else {
+      ranges[++n] = ranges[i];
+    }
+  }
+
+  return n + 1U;
+}
+
+bool CDMRFilter::find(const DMRFILTER_RANGE* ranges, uint8_t count, uint32_t id)
+{
+  uint8_t lo = 0U;
+  uint8_t hi = count;
+
+  // Find the last range starting at or below the ID
+  while (lo < hi) {
+    uint8_t mid = (lo + hi) / 2U;
+    if (ranges[mid].start <= id)
+      lo = mid + 1U;
+    else
+      hi = mid;
+  }
+
+  if (lo == 0U)
+    return false;
+
+  return id <= ranges[lo - 1U].end;
+}
+
+bool CDMRFilter::check(const DMRLC_T& lc) const
+{
+  return check(lc.srcId, lc.dstId);
+}
+
+bool CDMRFilter::check(uint32_t srcId, uint32_t dstId) const
+{
+  if (m_mode == DMRFM_OFF)
+    return true;
+
+  bool match = find(m_tg, m_tgCount, dstId) || find(m_src, m_srcCount, srcId);
+
+  if (m_mode == DMRFM_ALLOW)
+    return match;
+  else
+    return !match;
+}
+
+uint8_t CDMRFilter::setCSBK(const uint8_t* data, uint8_t length)
+{
+  if (length != 1U || (data[0U] >> (uint8_t(DMRCC_OTHER) + 1U)) != 0U)
+    return 4U;
+
+  m_csbkDrop = data[0U];
+
+  DEBUG2("DMRFilter: CSBK classes dropped", m_csbkDrop);
+
+  return 0U;
+}
+
+bool CDMRFilter::check(const DMRCSBK_T& csbk) const
+{
+  return (m_csbkDrop & (1U << csbk.csbkClass)) == 0U;
+}
@@ -0,0 +1,71 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(DMRFILTER_H)
+#define  DMRFILTER_H
+
+#include "DMRLC.h"
+#include "DMRCSBK.h"
+
+#include <stdint.h>
+
+// Ranges per table (talkgroups and source IDs)
+const uint8_t DMR_FILTER_MAX_RANGES = 16U;
+
+enum DMR_FILTER_MODE : uint8_t {
+  DMRFM_OFF,
+  DMRFM_ALLOW,
+  DMRFM_DENY
+};
+
+struct DMRFILTER_RANGE {
+  uint32_t start;
+  uint32_t end;
+};
+
+class CDMRFilter {
+public:
+  CDMRFilter();
+
+  // Payload: mode, TG count, source count, then (start, end) 24-bit big
+  // endian pairs, talkgroups first
+  uint8_t setFilter(const uint8_t* data, uint8_t length);
+
+  bool check(const DMRLC_T& lc) const;
+  bool check(uint32_t srcId, uint32_t dstId) const;
+
+  // Payload: one byte, bit n set drops CSBKs of DMR_CSBK_CLASS n
+  uint8_t setCSBK(const uint8_t* data, uint8_t length);
+
+  bool check(const DMRCSBK_T& csbk) const;
+
+  void reset();
+
+private:
+  DMR_FILTER_MODE m_mode;
+  DMRFILTER_RANGE m_tg[DMR_FILTER_MAX_RANGES];
+  uint8_t         m_tgCount;
+  DMRFILTER_RANGE m_src[DMR_FILTER_MAX_RANGES];
+  uint8_t         m_srcCount;
+  uint8_t         m_csbkDrop;
+
+  static uint8_t load(const uint8_t* data, uint8_t count, DMRFILTER_RANGE* ranges);
+  static bool    find(const DMRFILTER_RANGE* ranges, uint8_t count, uint32_t id);
+};
+
+#endif
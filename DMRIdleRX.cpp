@@ -33,14 +33,7 @@ const uint16_t NOENDPTR = 9999U;
 const uint8_t CONTROL_IDLE = 0x80U;
 const uint8_t CONTROL_DATA = 0x40U;
 
-const uint8_t BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
-
-#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
-#define READ_BIT1(p,i)    ((p[(i)>>3] & BIT_MASK_TABLE[(i)&7]) >> (7 - ((i)&7)))
-
 CDMRIdleRX::CDMRIdleRX() :
-m_patternBuffer(0U),
-m_buffer(),
 m_dataPtr(0U),
 m_endPtr(NOENDPTR),
 m_colorCode(0U)
@@ -49,21 +42,18 @@ m_colorCode(0U)
 
 void CDMRIdleRX::reset()
 {
-  m_dataPtr   = 0U;
   m_endPtr    = NOENDPTR;
 }
 
-void CDMRIdleRX::databit(bool bit)
+void CDMRIdleRX::databit()
 {
-  WRITE_BIT1(m_buffer, m_dataPtr, bit);
+  m_dataPtr = bitHistory.getPtr();
 
-  m_patternBuffer <<= 1;
-  if (bit)
-    m_patternBuffer |= 0x01U;
+  uint64_t pattern = bitHistory.getPattern() & DMR_SYNC_BITS_MASK;
 
-  bool msSync = countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS;
-  bool bsSync = countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_BS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS ||
-                countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_BS_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS;
+  bool msSync = countBits64(pattern ^ DMR_MS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS;
+  bool bsSync = countBits64(pattern ^ DMR_BS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS ||
+                countBits64(pattern ^ DMR_BS_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS;
 
   if (msSync || bsSync) {
     m_endPtr = m_dataPtr + DMR_SLOT_TYPE_LENGTH_BITS / 2U + DMR_INFO_LENGTH_BITS / 2U;
@@ -76,66 +66,24 @@ void CDMRIdleRX::databit(bool bit)
     if (ptr >= DMR_IDLE_LENGTH_BITS)
       ptr -= DMR_IDLE_LENGTH_BITS;
 
-    uint8_t frame[DMR_FRAME_LENGTH_BYTES + 1U];
-    bitsToBytes(ptr, DMR_FRAME_LENGTH_BYTES, frame + 1U);
+    uint8_t buffer[DMR_FRAME_HEADROOM + DMR_FRAME_LENGTH_BYTES + 1U];
+    uint8_t* frame = buffer + DMR_FRAME_HEADROOM;
+    bitHistory.getBytes(ptr, DMR_FRAME_LENGTH_BYTES, frame + 1U);
 
     uint8_t colorCode;
     uint8_t dataType;
     CDMRSlotType slotType;
-    slotType.decode(frame + 1U, colorCode, dataType);
+    uint8_t errs = slotType.decode(frame + 1U, colorCode, dataType);
 
-    if (colorCode == m_colorCode) {
+    if (errs <= DMR_SLOT_TYPE_MAX_ERRS && colorCode == m_colorCode) {
       frame[0U] = CONTROL_IDLE | CONTROL_DATA | dataType;
-      serial.writeDMRData(false, &frame[1], DMR_FRAME_LENGTH_BYTES);
+      serial.writeDMRFrame(false, &frame[1], DMR_FRAME_LENGTH_BYTES);
       DEBUG2I("DMRIdleRX: Received idle frame with color code", colorCode);
       io.setDecode(true);
     }
 
     m_endPtr  = NOENDPTR;
   }
-
-  m_dataPtr++;
-  if (m_dataPtr >= DMR_IDLE_LENGTH_BITS)
-    m_dataPtr = 0U;
-}
-
-void CDMRIdleRX::bitsToBytes(uint16_t start, uint8_t count, uint8_t* buffer)
-{
-  for (uint8_t i = 0U; i < count; i++) {
-    buffer[i]  = 0U;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 7;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 6;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 5;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 4;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 3;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 2;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 1;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 0;
-    start++;
-    if (start >= DMR_IDLE_LENGTH_BITS)
-      start -= DMR_IDLE_LENGTH_BITS;
-  }
 }
 
 void CDMRIdleRX::setColorCode(uint8_t colorCode)
@@ -25,27 +25,25 @@
 #if defined(DUPLEX)
 
 #include "DMRDefines.h"
+#include "BitHistory.h"
 
-const uint16_t DMR_IDLE_LENGTH_BITS = 320U;
+const uint16_t DMR_IDLE_LENGTH_BITS = BIT_HISTORY_LENGTH_BITS;
 
 class CDMRIdleRX {
 public:
   CDMRIdleRX();
 
-  void databit(bool bit);
+  // Processes the newest bit in the shared bit history
+  void databit();
 
   void setColorCode(uint8_t colorCode);
 
   void reset();
 
 private:
-  uint64_t m_patternBuffer;
-  uint8_t  m_buffer[DMR_IDLE_LENGTH_BITS / 8U];
   uint16_t m_dataPtr;
   uint16_t m_endPtr;
   uint8_t  m_colorCode;
-
-  void bitsToBytes(uint16_t start, uint8_t count, uint8_t* buffer);
 };
 
 #endif
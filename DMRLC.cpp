@@ -42,9 +42,17 @@ bool CDMRLC::decode(const uint8_t* data, uint8_t dataType, DMRLC_T* lc)
 {
   // BPTC(196,96) decode from the full 33‑byte DMR burst payload
   // (data[0] is the control byte, payload starts at data[1]).
-  // After BPTC decode, lc->rawData has the 12-byte LC with CRC mask ALREADY APPLIED
+  uint8_t payload[12U];
   CBPTC19696 bptc;
-  bptc.decode(data + 1U, lc->rawData);
+  bptc.decode(data + 1U, payload);
+
+  return decodePayload(payload, dataType, lc);
+}
+
+bool CDMRLC::decodePayload(const uint8_t* payload, uint8_t dataType, DMRLC_T* lc)
+{
+  // After BPTC decode, the payload is the 12-byte LC with CRC mask ALREADY APPLIED
+  memcpy(lc->rawData, payload, 12U);
 
   // Remove CRC mask from bytes 9-11 (ETSI TS 102 361-1 Section 9.2.5)
   // The mask was applied at transmission; we remove it to compute RS check
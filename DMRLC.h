@@ -29,6 +29,8 @@ class CDMRLC
 {
 public:
   static bool decode(const uint8_t* data, uint8_t dataType, DMRLC_T* lc);
+  // As decode(), for the 12 bytes a BPTC(196,96) decode already produced
+  static bool decodePayload(const uint8_t* payload, uint8_t dataType, DMRLC_T* lc);
   static void extractData(const uint8_t* frame, uint8_t* lcData);
 
 private:
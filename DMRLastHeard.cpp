@@ -0,0 +1,143 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRLastHeard.h"
+
+const uint8_t SYNC_WORD_BITS = 48U;
+
+CDMRLastHeard::CDMRLastHeard() :
+m_calls(),
+m_ptr(0U),
+m_count(0U),
+m_active()
+{
+}
+
+void CDMRLastHeard::start(uint8_t slot, const DMRLC_T& lc, bool filtered)
+{
+  if (slot >= DMR_LAST_HEARD_SLOTS)
+    return;
+
+  DMRLH_ENTRY& call = m_active[slot];
+
+  call.slot       = slot + 1U;
+  call.FLCO       = lc.FLCO;
+  call.srcId      = lc.srcId;
+  call.dstId      = lc.dstId;
+  call.startMs    = millis();
+  call.durationMs = 0U;
+  call.syncBits   = 0U;
+  call.syncErrs   = 0U;
+  call.rssiMin    = 0xFFFFU;
+  call.rssiMax    = 0U;
+  call.filtered   = filtered;
+  call.end        = DMRLHE_NONE;
+}
+
+void CDMRLastHeard::addSync(uint8_t slot, uint8_t errs)
+{
+  if (slot >= DMR_LAST_HEARD_SLOTS || m_active[slot].slot == 0U)
+    return;
+
+  if (m_active[slot].syncErrs > (0xFFFFU - errs))
+    return;
+
+  m_active[slot].syncBits += SYNC_WORD_BITS;
+  m_active[slot].syncErrs += errs;
+}
+
+void CDMRLastHeard::addRSSI(uint8_t slot, uint16_t rssi)
+{
+  if (slot >= DMR_LAST_HEARD_SLOTS || m_active[slot].slot == 0U)
+    return;
+
+  if (rssi < m_active[slot].rssiMin)
+    m_active[slot].rssiMin = rssi;
+  if (rssi > m_active[slot].rssiMax)
+    m_active[slot].rssiMax = rssi;
+}
+
+void CDMRLastHeard::end(uint8_t slot, DMR_LH_END reason)
+{
+  if (slot >= DMR_LAST_HEARD_SLOTS || m_active[slot].slot == 0U)
+    return;
+
+  DMRLH_ENTRY& call = m_active[slot];
+
+  call.durationMs = millis() - call.startMs;
+  call.end        = reason;
+
+  if (call.rssiMin > call.rssiMax)
+    call.rssiMin = call.rssiMax = 0U;
+
+  m_calls[m_ptr] = call;
+
+  m_ptr++;
+  if (m_ptr >= DMR_LAST_HEARD_LENGTH)
+    m_ptr = 0U;
+
+  if (m_count < DMR_LAST_HEARD_LENGTH)
+    m_count++;
+
+  call.slot = 0U;
+}
+
+uint8_t CDMRLastHeard::read(uint8_t* data, uint8_t length) const
+{
+  uint8_t n   = 0U;
+  uint8_t ptr = m_ptr;
+
+  for (uint8_t i = 0U; i < m_count && (n + DMR_LAST_HEARD_ENTRY_LENGTH) <= length; i++) {
+    ptr = (ptr == 0U) ? DMR_LAST_HEARD_LENGTH - 1U : ptr - 1U;
+
+    const DMRLH_ENTRY& call = m_calls[ptr];
+
+    // Sync word bit error rate in 0.1% steps
+    uint16_t ber = 0U;
+    if (call.syncBits > 0U)
+      ber = uint16_t((uint32_t(call.syncErrs) * 1000U) / call.syncBits);
+
+    data[n++] = call.slot | (call.filtered ? 0x80U : 0x00U);
+    data[n++] = call.FLCO;
+    data[n++] = (call.srcId >> 16) & 0xFFU;
+    data[n++] = (call.srcId >> 8)  & 0xFFU;
+    data[n++] = (call.srcId >> 0)  & 0xFFU;
+    data[n++] = (call.dstId >> 16) & 0xFFU;
+    data[n++] = (call.dstId >> 8)  & 0xFFU;
+    data[n++] = (call.dstId >> 0)  & 0xFFU;
+    data[n++] = (call.startMs >> 24) & 0xFFU;
+    data[n++] = (call.startMs >> 16) & 0xFFU;
+    data[n++] = (call.startMs >> 8)  & 0xFFU;
+    data[n++] = (call.startMs >> 0)  & 0xFFU;
+    data[n++] = (call.durationMs >> 24) & 0xFFU;
+    data[n++] = (call.durationMs >> 16) & 0xFFU;
+    data[n++] = (call.durationMs >> 8)  & 0xFFU;
+    data[n++] = (call.durationMs >> 0)  & 0xFFU;
+    data[n++] = (ber >> 8) & 0xFFU;
+    data[n++] = (ber >> 0) & 0xFFU;
+    data[n++] = (call.rssiMin >> 8) & 0xFFU;
+    data[n++] = (call.rssiMin >> 0) & 0xFFU;
+    data[n++] = (call.rssiMax >> 8) & 0xFFU;
+    data[n++] = (call.rssiMax >> 0) & 0xFFU;
+    data[n++] = uint8_t(call.end);
+  }
+
+  return n;
+}
@@ -0,0 +1,81 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(DMRLASTHEARD_H)
+#define  DMRLASTHEARD_H
+
+#include "Config.h"
+#include "DMRLC.h"
+
+#include <stdint.h>
+
+const uint8_t DMR_LAST_HEARD_LENGTH = 8U;
+
+// Calls followed at once, two slots per receiver
+#if defined(DUAL_RX)
+const uint8_t DMR_LAST_HEARD_SLOTS = 4U;
+#else
+const uint8_t DMR_LAST_HEARD_SLOTS = 2U;
+#endif
+
+// Bytes per entry in the serial reply
+const uint8_t DMR_LAST_HEARD_ENTRY_LENGTH = 23U;
+
+enum DMR_LH_END : uint8_t {
+  DMRLHE_NONE,
+  DMRLHE_TERMINATOR,
+  DMRLHE_SYNC_LOST,
+  DMRLHE_ABORTED
+};
+
+struct DMRLH_ENTRY {
+  uint8_t  slot;
+  uint8_t  FLCO;
+  uint32_t srcId;
+  uint32_t dstId;
+  uint32_t startMs;
+  uint32_t durationMs;
+  uint32_t syncBits;
+  uint16_t syncErrs;
+  uint16_t rssiMin;
+  uint16_t rssiMax;
+  bool     filtered;
+  DMR_LH_END end;
+};
+
+// The slot is 0 or 1 on the main receiver, and 2 or 3 on the second one
+class CDMRLastHeard {
+public:
+  CDMRLastHeard();
+
+  void start(uint8_t slot, const DMRLC_T& lc, bool filtered);
+  void addSync(uint8_t slot, uint8_t errs);
+  void addRSSI(uint8_t slot, uint16_t rssi);
+  void end(uint8_t slot, DMR_LH_END reason);
+
+  // Newest call first, returns the number of bytes written
+  uint8_t read(uint8_t* data, uint8_t length) const;
+
+private:
+  DMRLH_ENTRY m_calls[DMR_LAST_HEARD_LENGTH];
+  uint8_t     m_ptr;
+  uint8_t     m_count;
+  DMRLH_ENTRY m_active[DMR_LAST_HEARD_SLOTS];
+};
+
+#endif
@@ -0,0 +1,88 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRDefines.h"
+#include "DMRLatency.h"
+
+const uint8_t CONTROL_DATA = 0x40U;
+
+CDMRLatency::CDMRLatency() :
+m_buckets(),
+m_max()
+{
+}
+
+void CDMRLatency::reset()
+{
+  for (uint8_t i = 0U; i < DMRLT_COUNT; i++) {
+    for (uint8_t j = 0U; j < DMR_LATENCY_BUCKETS; j++)
+      m_buckets[i][j] = 0U;
+    m_max[i] = 0U;
+  }
+}
+
+void CDMRLatency::add(uint8_t control, uint32_t ticks)
+{
+  DMR_LATENCY_TYPE type = DMRLT_VOICE;
+
+  // Data bursts carry the data type, voice bursts the superframe position
+  if ((control & CONTROL_DATA) != 0U) {
+    switch (control & 0x0FU) {
+      case DT_VOICE_LC_HEADER:
+      case DT_VOICE_PI_HEADER:
+        type = DMRLT_HEADER;
+        break;
+      case DT_TERMINATOR_WITH_LC:
+        type = DMRLT_TERMINATOR;
+        break;
+      default:
+        type = DMRLT_DATA;
+        break;
+    }
+  }
+
+  uint8_t n = 0U;
+  for (uint32_t tmp = ticks >> 1; tmp > 0U && n < (DMR_LATENCY_BUCKETS - 1U); tmp >>= 1)
+    n++;
+
+  if (m_buckets[type][n] < 0xFFFFU)
+    m_buckets[type][n]++;
+
+  uint16_t max = (ticks > 0xFFFFU) ? 0xFFFFU : uint16_t(ticks);
+  if (max > m_max[type])
+    m_max[type] = max;
+}
+
+uint8_t CDMRLatency::read(uint8_t* data, uint8_t length) const
+{
+  uint8_t n = 0U;
+
+  for (uint8_t i = 0U; i < DMRLT_COUNT && (n + DMR_LATENCY_TYPE_LENGTH) <= length; i++) {
+    data[n++] = (m_max[i] >> 8) & 0xFFU;
+    data[n++] = (m_max[i] >> 0) & 0xFFU;
+
+    for (uint8_t j = 0U; j < DMR_LATENCY_BUCKETS; j++) {
+      data[n++] = (m_buckets[i][j] >> 8) & 0xFFU;
+      data[n++] = (m_buckets[i][j] >> 0) & 0xFFU;
+    }
+  }
+
+  return n;
+}
@@ -0,0 +1,60 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(DMRLATENCY_H)
+#define  DMRLATENCY_H
+
+#include <stdint.h>
+
+// Time from the end of a DMR burst on air to its frame being queued for the
+// UART. The frame then still waits for the ones queued ahead of it, and
+// takes about 3 ms on the wire at 115200 baud.
+//
+// Bucket n counts latencies of 2^n to 2^(n+1) - 1 bit clock ticks (52 us
+// each), bucket 0 includes 0 and the last bucket has no upper limit
+const uint8_t DMR_LATENCY_BUCKETS = 12U;
+
+enum DMR_LATENCY_TYPE : uint8_t {
+  DMRLT_HEADER,
+  DMRLT_VOICE,
+  DMRLT_TERMINATOR,
+  DMRLT_DATA,
+  DMRLT_COUNT
+};
+
+// Bytes per frame type in the serial reply, the maximum then the buckets
+const uint8_t DMR_LATENCY_TYPE_LENGTH = 2U + DMR_LATENCY_BUCKETS * 2U;
+
+class CDMRLatency {
+public:
+  CDMRLatency();
+
+  // Control is the first byte of the frame going to the host
+  void add(uint8_t control, uint32_t ticks);
+
+  // Returns the number of bytes written
+  uint8_t read(uint8_t* data, uint8_t length) const;
+
+  void reset();
+
+private:
+  uint16_t m_buckets[DMRLT_COUNT][DMR_LATENCY_BUCKETS];
+  uint16_t m_max[DMRLT_COUNT];
+};
+
+#endif
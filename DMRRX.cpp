@@ -30,11 +30,20 @@ static uint32_t syncCounter = 0;
 static bool firstSync = true;
 
 CDMRRX::CDMRRX() :
+m_slotRX(bitHistory, 0U),
+m_receiver(0U),
 m_control_old(0U)
 {
 }
 
-void CDMRRX::databit(bool bit, const uint8_t control)
+CDMRRX::CDMRRX(CBitHistory& history, uint8_t receiver) :
+m_slotRX(history, receiver),
+m_receiver(receiver),
+m_control_old(0U)
+{
+}
+
+void CDMRRX::databit(const uint8_t control)
 {
 #if defined(MS_MODE)
   (void)control;
@@ -52,7 +61,7 @@ void CDMRRX::databit(bool bit, const uint8_t control)
 
 
   
-  bool locked = m_slotRX.databit(bit);
+  bool locked = m_slotRX.databit();
   if (locked) {
     syncCounter++;
     if (firstSync) {
@@ -61,7 +70,9 @@ void CDMRRX::databit(bool bit, const uint8_t control)
     }
   }
   
-  io.setDecode(locked);
+  // Only the main receiver holds the channel scan and drives the COS LED
+  if (m_receiver == 0U)
+    io.setDecode(locked);
   io.resetWatchdog();
 #else
   if (control != m_control_old) {
@@ -72,7 +83,7 @@ void CDMRRX::databit(bool bit, const uint8_t control)
       m_slotRX.start(false);
   }
 
-  io.setDecode(m_slotRX.databit(bit));
+  io.setDecode(m_slotRX.databit());
 #endif
 }
 
@@ -88,6 +99,33 @@ void CDMRRX::setDelay(uint8_t delay)
   DEBUG2I("DMRRX: Delay set to", delay);
 }
 
+uint8_t CDMRRX::setQuality(uint8_t forward, uint8_t start, uint8_t flywheel)
+{
+  return m_slotRX.setQuality(forward, start, flywheel);
+}
+
+uint32_t CDMRRX::getSyncTime(uint8_t slot) const
+{
+  return m_slotRX.getSyncTime(slot);
+}
+
+bool CDMRRX::isActive(uint8_t slot) const
+{
+  return m_slotRX.isActive(slot);
+}
+
+bool CDMRRX::hasCall(uint8_t slot) const
+{
+  return m_slotRX.hasCall(slot);
+}
+
+#if defined(MS_MODE)
+const CDMRShortLC& CDMRRX::getShortLC() const
+{
+  return m_slotRX.getShortLC();
+}
+#endif
+
 void CDMRRX::reset()
 {
   m_slotRX.reset();
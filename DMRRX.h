@@ -29,16 +29,29 @@
 class CDMRRX {
 public:
   CDMRRX();
+  CDMRRX(CBitHistory& history, uint8_t receiver);
 
-  void databit(bool bit, const uint8_t control);
+  void databit(const uint8_t control);
 
   void setColorCode(uint8_t colorCode);
   void setDelay(uint8_t delay);
+  uint8_t setQuality(uint8_t forward, uint8_t start, uint8_t flywheel);
+
+  // For the trunk follower's retune to sync latency
+  uint32_t getSyncTime(uint8_t slot) const;
+
+  bool isActive(uint8_t slot) const;
+  bool hasCall(uint8_t slot) const;
+
+#if defined(MS_MODE)
+  const CDMRShortLC& getShortLC() const;
+#endif
 
   void reset();
 
 private:
   CDMRSlotRX m_slotRX;
+  uint8_t    m_receiver;
   uint8_t    m_control_old;
 };
 
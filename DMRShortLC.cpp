@@ -0,0 +1,275 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRDefines.h"
+#include "DMRShortLC.h"
+
+// A BS sends a Short LC every four bursts, 120 ms, and repeats its activity
+// and system identity all the time it is on air
+const uint32_t SHORT_LC_TIMEOUT_MS = 1000U;
+
+CDMRShortLC::CDMRShortLC() :
+m_rawData(),
+m_fragments(0U),
+m_activity(),
+m_actValid(false),
+m_actMs(0U),
+m_sysCode(0U),
+m_controlChannel(false),
+m_sysValid(false),
+m_sysMs(0U)
+{
+}
+
+bool CDMRShortLC::decode(const bool* cach)
+{
+  bool tc;
+  uint8_t lcss;
+  if (!decodeTACT(cach, tc, lcss)) {
+    m_fragments = 0U;
+    return false;
+  }
+
+  // A fragment out of order, or a single fragment LC of the reverse
+  // channel, ends the one being assembled
+  switch (lcss) {
+    case DMR_LCSS_FIRST:
+      m_fragments = 0U;
+      break;
+    case DMR_LCSS_CONTINUATION:
+      if (m_fragments == 0U || m_fragments == 3U) {
+        m_fragments = 0U;
+        return false;
+      }
+      break;
+    case DMR_LCSS_LAST:
+      if (m_fragments != 3U) {
+        m_fragments = 0U;
+        return false;
+      }
+      break;
+    default:
+      m_fragments = 0U;
+      return false;
+  }
+
+  bool* p = m_rawData + m_fragments * 17U;
+  for (uint8_t i = 0U; i < 17U; i++)
+    p[i] = cach[DMR_CACH_PAYLOAD[i]];
+
+  if (lcss != DMR_LCSS_LAST) {
+    m_fragments++;
+    return false;
+  }
+
+  m_fragments = 0U;
+
+  return decodeLC();
+}
+
+bool CDMRShortLC::decodeLC()
+{
+  bool deInterData[68U];
+  for (uint8_t a = 0U; a < 67U; a++)
+    deInterData[a] = m_rawData[(a * 4U) % 67U];
+  deInterData[67U] = m_rawData[67U];
+
+  // Three rows of Hamming(17,12,3) and a row of column parity
+  for (uint8_t r = 0U; r < 3U; r++) {
+    if (!decode17123(deInterData + r * 17U))
+      return false;
+  }
+
+  for (uint8_t c = 0U; c < 17U; c++) {
+    if ((deInterData[c] ^ deInterData[c + 17U] ^ deInterData[c + 34U]) != deInterData[c + 51U])
+      return false;
+  }
+
+  // SLCO, 24 bits of payload and the CRC-8, the SLCO in the low nibble of
+  // lc[0]
+  uint8_t lc[5U] = {0U, 0U, 0U, 0U, 0U};
+  uint8_t pos = 4U;
+  for (uint8_t r = 0U; r < 3U; r++) {
+    for (uint8_t i = 0U; i < 12U; i++, pos++) {
+      if (deInterData[r * 17U + i])
+        lc[pos >> 3] |= 0x80U >> (pos & 7U);
+    }
+  }
+
+  if (crc8(lc, 4U) != lc[4U])
+    return false;
+
+  uint32_t now = millis();
+
+  switch (lc[0U]) {
+    case DMRSLCO_ACT_UPDT:
+      if (!m_actValid || (lc[1U] >> 4) != m_activity[0U] || (lc[1U] & 0x0FU) != m_activity[1U])
+        DEBUG3("DMRShortLC: site activity", lc[1U] >> 4, lc[1U] & 0x0FU);
+      m_activity[0U] = lc[1U] >> 4;
+      m_activity[1U] = lc[1U] & 0x0FU;
+      m_actValid = true;
+      m_actMs    = now;
+      break;
+
+    case DMRSLCO_C_SYS_PARMS:
+    case DMRSLCO_P_SYS_PARMS:
+      m_sysCode = (uint16_t(lc[1U]) << 6) | (lc[2U] >> 2);
+      m_controlChannel = lc[0U] == DMRSLCO_C_SYS_PARMS;
+      m_sysValid = true;
+      m_sysMs    = now;
+      break;
+
+    default:
+      break;
+  }
+
+  return true;
+}
+
+bool CDMRShortLC::getActivity(uint8_t slot, uint8_t& activity) const
+{
+  if (!m_actValid || (millis() - m_actMs) >= SHORT_LC_TIMEOUT_MS)
+    return false;
+
+  activity = m_activity[slot & 1U];
+
+  return true;
+}
+
+bool CDMRShortLC::isBusy() const
+{
+  uint8_t activity1, activity2;
+  if (!getActivity(0U, activity1) || !getActivity(1U, activity2))
+    return false;
+
+  return activity1 != 0U || activity2 != 0U;
+}
+
+bool CDMRShortLC::getSystem(uint16_t& sysCode, bool& controlChannel) const
+{
+  if (!m_sysValid || (millis() - m_sysMs) >= SHORT_LC_TIMEOUT_MS)
+    return false;
+
+  sysCode        = m_sysCode;
+  controlChannel = m_controlChannel;
+
+  return true;
+}
+
+void CDMRShortLC::reset()
+{
+  m_fragments = 0U;
+  m_actValid  = false;
+  m_sysValid  = false;
+}
+
+// AT, TC, LCSS and Hamming(7,4), correcting one bit
+bool CDMRShortLC::decodeTACT(const bool* cach, bool& tc, uint8_t& lcss)
+{
+  bool t[7U];
+  t[0U] = cach[0U];   // AT
+  t[1U] = cach[4U];   // TC
+  t[2U] = cach[8U];   // LCSS1
+  t[3U] = cach[12U];  // LCSS0
+  t[4U] = cach[14U];  // H2
+  t[5U] = cach[18U];  // H1
+  t[6U] = cach[22U];  // H0
+
+  bool s0 = t[0U] ^ t[1U] ^ t[2U] ^ t[4U];
+  bool s1 = t[1U] ^ t[2U] ^ t[3U] ^ t[5U];
+  bool s2 = t[0U] ^ t[1U] ^ t[3U] ^ t[6U];
+
+  // The AT and the parity bits are not needed, an error in them leaves the
+  // rest as they are
+  switch ((s2 << 2) | (s1 << 1) | s0) {
+    case 0: case 1: case 2: case 4: case 5: break;
+    case 7: t[1U] = !t[1U]; break;
+    case 3: t[2U] = !t[2U]; break;
+    case 6: t[3U] = !t[3U]; break;
+    default: return false;
+  }
+
+  tc   = t[1U];
+  lcss = (t[2U] ? 2U : 0U) | (t[3U] ? 1U : 0U);
+
+  return true;
+}
+
+// Hamming(17,12,3), correcting one bit
+bool CDMRShortLC::decode17123(bool* d)
+{
+  bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[6] ^ d[7] ^ d[9];
+  bool c1 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[7] ^ d[8] ^ d[10];
+  bool c2 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[8] ^ d[9] ^ d[11];
+  bool c3 = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
+  bool c4 = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
+
+  uint8_t n = 0x00U;
+  n |= (c0 != d[12]) ? 0x01U : 0x00U;
+  n |= (c1 != d[13]) ? 0x02U : 0x00U;
+  n |= (c2 != d[14]) ? 0x04U : 0x00U;
+  n |= (c3 != d[15]) ? 0x08U : 0x00U;
+  n |= (c4 != d[16]) ? 0x10U : 0x00U;
+
+  switch (n) {
+    // Parity bit errors
+    case 0x01U: d[12] = !d[12]; return true;
+    case 0x02U: d[13] = !d[13]; return true;
+    case 0x04U: d[14] = !d[14]; return true;
+    case 0x08U: d[15] = !d[15]; return true;
+    case 0x10U: d[16] = !d[16]; return true;
+
+    // Data bit errors
+    case 0x1BU: d[0]  = !d[0];  return true;
+    case 0x1FU: d[1]  = !d[1];  return true;
+    case 0x17U: d[2]  = !d[2];  return true;
+    case 0x07U: d[3]  = !d[3];  return true;
+    case 0x0EU: d[4]  = !d[4];  return true;
+    case 0x1CU: d[5]  = !d[5];  return true;
+    case 0x11U: d[6]  = !d[6];  return true;
+    case 0x0BU: d[7]  = !d[7];  return true;
+    case 0x16U: d[8]  = !d[8];  return true;
+    case 0x05U: d[9]  = !d[9];  return true;
+    case 0x0AU: d[10] = !d[10]; return true;
+    case 0x14U: d[11] = !d[11]; return true;
+
+    // No bit errors
+    case 0x00U: return true;
+
+    // Unrecoverable errors
+    default: return false;
+  }
+}
+
+// x^8 + x^2 + x + 1, preset to zero
+uint8_t CDMRShortLC::crc8(const uint8_t* data, uint8_t length)
+{
+  uint8_t crc = 0x00U;
+
+  for (uint8_t i = 0U; i < length; i++) {
+    crc ^= data[i];
+    for (uint8_t j = 0U; j < 8U; j++)
+      crc = (crc & 0x80U) ? uint8_t((crc << 1) ^ 0x07U) : uint8_t(crc << 1);
+  }
+
+  return crc;
+}
+
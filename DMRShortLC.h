@@ -0,0 +1,77 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(DMRSHORTLC_H)
+#define  DMRSHORTLC_H
+
+#include <stdint.h>
+
+// Short LC opcodes, ETSI TS 102 361-2 and -4
+enum DMR_SLCO : uint8_t {
+  DMRSLCO_NULL        = 0x00U,
+  DMRSLCO_ACT_UPDT    = 0x01U,   // Activity of both slots
+  DMRSLCO_C_SYS_PARMS = 0x02U,   // System identity, sent on a Tier III control channel
+  DMRSLCO_P_SYS_PARMS = 0x03U    // System identity, sent on a Tier III payload channel
+};
+
+// Reassembles the Short LC a BS spreads over the CACH of four bursts
+class CDMRShortLC {
+public:
+  CDMRShortLC();
+
+  // Takes the 24 bits of one CACH, one bool per bit. Returns true when it
+  // ends a Short LC that passes its Hamming, parity and CRC checks.
+  bool decode(const bool* cach);
+
+  // The activity type the site last reported for the slot, zero when idle.
+  // Returns false when it has not reported any lately.
+  bool getActivity(uint8_t slot, uint8_t& activity) const;
+
+  // Activity reported lately on either slot
+  bool isBusy() const;
+
+  // The 14-bit system identity code, model and network and site, of the
+  // last SYS_Parms. Returns false when there has been none lately.
+  bool getSystem(uint16_t& sysCode, bool& controlChannel) const;
+
+  void reset();
+
+  // The TC and LCSS of the TACT of a CACH, 24 bools, the Hamming(7,4)
+  // correcting one bit. Returns false when it cannot.
+  static bool decodeTACT(const bool* cach, bool& tc, uint8_t& lcss);
+
+private:
+  bool     m_rawData[68U];
+  uint8_t  m_fragments;
+  uint8_t  m_activity[2U];
+  bool     m_actValid;
+  uint32_t m_actMs;
+  uint16_t m_sysCode;
+  bool     m_controlChannel;
+  bool     m_sysValid;
+  uint32_t m_sysMs;
+
+  bool decodeLC();
+
+  static bool    decode17123(bool* d);
+  static uint8_t crc8(const uint8_t* data, uint8_t length);
+};
+
+#endif
+
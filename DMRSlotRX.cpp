@@ -25,7 +25,9 @@
 #include "DMRSlotRX.h"
 #include "DMRSlotType.h"
 #include "DMRLC.h"
+#include "DMRCSBK.h"
 #include "BPTC19696.h"
+#include "QR1676.h"
 #include "Utils.h"
 #include <string.h>
 #include <stdio.h>
@@ -40,21 +42,42 @@ const uint8_t CONTROL_NONE  = 0x00U;
 const uint8_t CONTROL_VOICE = 0x20U;
 const uint8_t CONTROL_DATA  = 0x40U;
 
-const uint8_t BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
+// Burst cost, an estimate of its bit errors, for what the decoders cannot
+// count: a flywheeled burst, an uncorrectable slot type and a bad LC
+const uint8_t COST_NO_SYNC   = MAX_SYNC_BYTES_ERRS + 1U;
+const uint8_t COST_RS_FAILED = 32U;
+// A flywheeled burst with nothing to check it against, or that fails the
+// check of its EMB or of its sync against MAX_FLYWHEEL_SYNC_ERRS
+const uint8_t COST_UNCHECKED = 32U;
 
-#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
-#define READ_BIT1(p,i)    ((p[(i)>>3] & BIT_MASK_TABLE[(i)&7]) >> (7 - ((i)&7)))
+const uint8_t MAX_FLYWHEEL_SYNC_ERRS = DMR_SYNC_LENGTH_BITS / 4U;
 
-CDMRSlotRX::CDMRSlotRX() :
+// Default cost limits, see setQuality()
+const uint8_t DEFAULT_FORWARD_COST  = 28U;
+const uint8_t DEFAULT_START_COST    = 28U;
+const uint8_t DEFAULT_FLYWHEEL_COST = 32U;
+
+// Bits from the end of the sync word to the end of the burst
+const uint16_t SYNC_TO_END_BITS = DMR_SLOT_TYPE_LENGTH_BITS / 2U + DMR_INFO_LENGTH_BITS / 2U;
+
+CDMRSlotRX::CDMRSlotRX(CBitHistory& history, uint8_t receiver) :
+m_history(history),
+m_receiver(receiver),
+m_lhBase(receiver * 2U),
 m_slot(false),
-m_patternBuffer(0x00U),
-m_buffer(),
 m_dataPtr(0U),
+m_frameBuffer(),
+frame(m_frameBuffer + DMR_FRAME_HEADROOM),
 m_syncPtr(0U),
 m_startPtr(0U),
 m_endPtr(NOENDPTR),
 m_control(CONTROL_NONE),
 m_inverted(false),
+m_syncErrs(0U),
+m_burstCost(0U),
+m_forwardCost(DEFAULT_FORWARD_COST),
+m_startCost(DEFAULT_START_COST),
+m_flywheelCost(DEFAULT_FLYWHEEL_COST),
 m_delayPtr(0U),
 m_colorCode(0U),
 m_delay(0U)
@@ -63,8 +86,8 @@ m_delay(0U)
   m_slotTimer(0U),
   m_syncLocked(false),
   m_slotHysteresis(0U),
-  m_bitsReceived(0U),
-  m_terminator_count(0U)
+  m_terminator_count(0U),
+  m_shortLC()
 #endif
 {
   for (uint8_t i = 0U; i < 2U; i++) {
@@ -73,7 +96,10 @@ m_delay(0U)
     m_n[i] = 0U;
     m_type[i] = 0U;
     m_callStartMs[i] = 0U;
+    m_syncTime[i]    = 0U;
+    m_endTime[i]     = 0U;
     m_callActive[i]  = false;
+    m_callFiltered[i] = false;
 
 #if defined(MS_MODE)
     m_lcValid[i] = false;
@@ -89,11 +115,8 @@ void CDMRSlotRX::start(bool slot)
 
 void CDMRSlotRX::reset()
 {
-  m_dataPtr   = 0U;
+  // The bit history is kept, only this receiver's state goes
   m_delayPtr  = 0U;
-  m_patternBuffer = 0U;
-
-  memset(m_buffer, 0, sizeof(m_buffer));
 
   m_syncPtr   = 0U;
   m_control   = CONTROL_NONE;
@@ -102,12 +125,15 @@ void CDMRSlotRX::reset()
   m_endPtr    = NOENDPTR;
   
   for (uint8_t i = 0U; i < 2U; i++) {
+    dmrLastHeard.end(m_lhBase + i, DMRLHE_ABORTED);
+
     m_syncCount[i] = 0U;
     m_state[i]     = DMRRXS_NONE;
     m_n[i]         = 0U;
     m_type[i]      = 0U;
     m_callStartMs[i] = 0U;
     m_callActive[i]  = false;
+    m_callFiltered[i] = false;
 #if defined(MS_MODE)
     m_lcValid[i] = false;
 #endif
@@ -118,14 +144,14 @@ void CDMRSlotRX::reset()
   m_slotTimer = 0U;
   m_syncLocked = false;
   m_slotHysteresis = 0U;
-  m_bitsReceived = 0U;
   m_syncLocked = false;
   m_terminator_count = 0U;
   memset(m_lcData, 0, sizeof(m_lcData));
+  m_shortLC.reset();
 #endif
 }
 
-bool CDMRSlotRX::databit(bool bit)
+bool CDMRSlotRX::databit()
 {
   uint16_t min, max;
 
@@ -139,17 +165,8 @@ bool CDMRSlotRX::databit(bool bit)
     return (m_state[slot] != DMRRXS_NONE || m_control != CONTROL_NONE);
   }
 
-  WRITE_BIT1(m_buffer, m_dataPtr, bit);
+  m_dataPtr = m_history.getPtr();
 
-  m_patternBuffer <<= 1;
-  if (bit)
-    m_patternBuffer |= 0x01U;
-
-#if defined(MS_MODE)
-  if (m_bitsReceived < DMR_BUFFER_LENGTH_BITS)
-    m_bitsReceived++;
-#endif
-    
 #if defined(MS_MODE)
   // Slot timing logic for MS mode
   m_slotTimer++;
@@ -195,11 +212,6 @@ bool CDMRSlotRX::databit(bool bit)
   }
 #endif
 
-  m_dataPtr++;
-
-  if (m_dataPtr >= DMR_BUFFER_LENGTH_BITS)
-    m_dataPtr = 0U;
-
 #if defined(MS_MODE)
   if (m_syncLocked)
     return true;
@@ -217,10 +229,19 @@ void CDMRSlotRX::procSlot2()
 #endif
 
   if (m_dataPtr == m_endPtr) {
-  
-    frame[0U] = m_control;
+    // The end of the burst is SYNC_TO_END_BITS after the last sync bit, this
+    // holds for flywheeled bursts too
+    m_endTime[slot]  = io.getRXTime(m_receiver);
+    m_syncTime[slot] = m_endTime[slot] - 2U * SYNC_TO_END_BITS;
 
-    bitsToBytes(m_startPtr, DMR_FRAME_LENGTH_BYTES, frame + 1U);
+    m_history.getBytes(m_startPtr, DMR_FRAME_LENGTH_BYTES, frame + 1U);
+
+    uint8_t colorCode = 0U;
+    uint8_t dataType  = 0U;
+    uint8_t payload[12U];
+    scoreBurst(slot, colorCode, dataType, payload);
+
+    frame[0U] = m_control;
 
 #if defined(MS_MODE)
     // Transpose BS sync to MS sync so MMDVMHost recognizes the traffic.
@@ -252,12 +273,12 @@ void CDMRSlotRX::procSlot2()
     }
 #endif
 
+    if (m_control != CONTROL_NONE)
+      dmrLastHeard.addSync(m_lhBase + slot, m_syncErrs);
+
     if (m_control == CONTROL_DATA) {
       // Data sync
-      uint8_t colorCode;
-      uint8_t dataType;
       CDMRSlotType slotType;
-      slotType.decode(frame + 1U, colorCode, dataType);
 
 #if defined(MS_MODE)
       // ETSI DMR standard (TS 102 361-1) compliant terminator handling.
@@ -273,6 +294,7 @@ void CDMRSlotRX::procSlot2()
 #endif
             m_state[slot] = DMRRXS_TERMINATOR;
           }
+          endSlot();
           return; // Do not process any further.
       }
 #endif
@@ -296,6 +318,8 @@ void CDMRSlotRX::procSlot2()
 
         switch (dataType) {
           case DT_DATA_HEADER:
+            if (m_burstCost > m_startCost)
+              break;
             writeRSSIData();
             m_state[slot] = DMRRXS_DATA;
             m_type[slot]  = 0x00U;
@@ -314,18 +338,26 @@ void CDMRSlotRX::procSlot2()
             DEBUG2I("BS burst CC (sent to host):", colorCode);
             DEBUG2I("Pi-Star configured CC:     ", m_colorCode);
 #endif
+            // Extract and embed Link Control (LC) data in the frame
+            DMRLC_T lc;
+
+            bool lcValid = CDMRLC::decodePayload(payload, DT_VOICE_LC_HEADER, &lc);
+            if (!lcValid)
+              m_burstCost += COST_RS_FAILED;
+
+            if (m_state[slot] != DMRRXS_VOICE && m_burstCost > m_startCost)
+              break;
+
             // Treat this as a new call only when both slots are idle.
             // In MS_MODE the flywheel can transiently flip slot labels.
             const bool newVoiceCall = (m_state[0U] == DMRRXS_NONE && m_state[1U] == DMRRXS_NONE);
             m_state[slot] = DMRRXS_VOICE;
+            // The next voice burst is A, should the flywheel have to find it
+            m_n[slot] = 5U;
 #if defined(MS_MODE)
             if (newVoiceCall)
               m_state[slot ^ 1U] = DMRRXS_NONE;  // Only one slot active at call start
 #endif
-              // Extract and embed Link Control (LC) data in the frame
-              DMRLC_T lc;
-              
-              bool lcValid = CDMRLC::decode(frame, DT_VOICE_LC_HEADER, &lc);
 
 #if defined(ENABLE_DEBUG)
               if (lcValid) {
@@ -342,8 +374,17 @@ void CDMRSlotRX::procSlot2()
                 m_callActive[slot] = true;
                 m_callStartMs[slot] = millis();
         #if defined(MS_MODE)
+                if (m_callActive[slot ^ 1U])
+                  dmrLastHeard.end(m_lhBase + (slot ^ 1U), DMRLHE_ABORTED);
                 m_callActive[slot ^ 1U] = false;
+                m_callFiltered[slot ^ 1U] = false;
         #endif
+                // The TG/ID filter is evaluated once, at the start of the call
+                m_callFiltered[slot] = !dmrFilter.check(lc);
+                if (m_callFiltered[slot])
+                  DEBUG2I("DMRSlotRX: call filtered, DstID", lc.dstId);
+
+                dmrLastHeard.start(m_lhBase + slot, lc, m_callFiltered[slot]);
               }
 
               
@@ -383,11 +424,14 @@ void CDMRSlotRX::procSlot2()
           }
 
           case DT_VOICE_PI_HEADER:
+            if (m_state[slot] != DMRRXS_VOICE && m_burstCost > m_startCost)
+              break;
             if (m_state[slot] == DMRRXS_VOICE) {
              
               writeRSSIData();
             }
             m_state[slot] = DMRRXS_VOICE;
+            m_n[slot] = 5U;
             break;
 
           case DT_TERMINATOR_WITH_LC:
@@ -397,7 +441,9 @@ void CDMRSlotRX::procSlot2()
                                 // Extract and embed Link Control (LC) data in the terminator frame
                 DMRLC_T lc;
                 
-                bool lcValid = CDMRLC::decode(frame, DT_TERMINATOR_WITH_LC, &lc);
+                bool lcValid = CDMRLC::decodePayload(payload, DT_TERMINATOR_WITH_LC, &lc);
+                if (!lcValid)
+                  m_burstCost += COST_RS_FAILED;
                 
 #if defined(ENABLE_DEBUG)
                 if (lcValid) {
@@ -429,13 +475,27 @@ void CDMRSlotRX::procSlot2()
 
                 if (m_callActive[slot]) {
                   m_callActive[slot] = false;
+                  dmrLastHeard.end(m_lhBase + slot, DMRLHE_TERMINATOR);
                 }
+                m_callFiltered[slot] = false;
 
               }
               m_state[slot]  = DMRRXS_NONE;
             }
             break;
-          default:    // DT_CSBK
+          case DT_CSBK: {
+            // Signalling before, between or within calls, it never ends one
+            DMRCSBK_T csbk;
+            if (!CDMRCSBK::decodePayload(payload, &csbk))
+              break;
+            if (m_receiver == 0U)
+              dmrTrunk.grant(csbk);
+            if (dmrFilter.check(csbk))
+              writeRSSIData();
+            break;
+          }
+
+          default:
             
             writeRSSIData();
             m_state[slot]  = DMRRXS_NONE;
@@ -453,29 +513,18 @@ void CDMRSlotRX::procSlot2()
       // receives the header BEFORE any voice payload frames.
 #if defined(MS_MODE)
       if (m_state[slot] == DMRRXS_VOICE) {
-        // Superframe position tracking:
-        //   m_n[slot] == 0  → voice A-frame (CONTROL_VOICE = 0x20, send with RSSI)
-        //   m_n[slot] == 1..5 → voice B–F continuation (sequence byte 1–5, no RSSI)
-        // MMDVMHost CDMRSlot::writeModem() uses the sequence byte to position each
-        // 9-byte AMBE chunk correctly within the 27-byte AMBE superframe.
-        if (m_n[slot] == 0U) {
-          // Voice A-frame: frame[0] already = CONTROL_VOICE (0x20), send with RSSI
-          writeRSSIData();
-          m_n[slot] = 1U;
-        } else {
-          // Voice B–F continuation: set sequence byte and send without RSSI
-          frame[0U] = m_n[slot];
-          serial.writeDMRData(slot ? true : false, &frame[1], DMR_FRAME_LENGTH_BYTES);
-          if (m_n[slot] >= 5U)
-            m_n[slot] = 0U;   // F-frame sent; next sync starts a new superframe
-          else
-            m_n[slot]++;
-        }
+        // Only the A burst of a superframe carries a voice sync, m_n[slot] is
+        // the position of the last burst so the flywheel numbers B to F
+        // (sequence bytes 1 to 5) from here
+        writeRSSIData();
+        m_n[slot] = 0U;
       }
       // else: discard — MMDVMHost hasn't seen the header yet
 #else
-      writeRSSIData();
-      m_state[slot] = DMRRXS_VOICE;
+      if (m_state[slot] == DMRRXS_VOICE || m_burstCost <= m_startCost) {
+        writeRSSIData();
+        m_state[slot] = DMRRXS_VOICE;
+      }
 #endif
       // In MS_MODE the flywheel alternates m_currentSlot every burst, so 'slot'
       // oscillates between 0 and 1. Resetting only syncCount[slot] leaves the
@@ -490,45 +539,61 @@ void CDMRSlotRX::procSlot2()
 #endif
     } else {
 #if defined(MS_MODE)
-      m_syncCount[slot]++;
-  if (m_syncCount[slot] >= MAX_SYNC_LOST_FRAMES) {
-         
+      if (m_burstCost <= m_flywheelCost) {
+        // The burst passed its check, it counts as heard
+        m_syncCount[0U] = 0U;
+        m_syncCount[1U] = 0U;
+      } else {
+        m_syncCount[slot]++;
+      }
+      if (m_syncCount[slot] >= MAX_SYNC_LOST_FRAMES) {
 #if defined(ENABLE_DEBUG)
-          DEBUG2("DMRSlotRX: Sync lost in MS_MODE", m_syncCount[slot]);
-    #endif      
+        DEBUG2("DMRSlotRX: Sync lost in MS_MODE", m_syncCount[slot]);
+#endif
 
-      if (m_state[slot] == DMRRXS_VOICE || m_state[slot] == DMRRXS_TERMINATOR) {
-        if (m_state[slot] == DMRRXS_TERMINATOR) {
+        if (m_state[slot] == DMRRXS_VOICE || m_state[slot] == DMRRXS_TERMINATOR) {
+          if (m_state[slot] == DMRRXS_TERMINATOR) {
 #if defined(ENABLE_DEBUG)
-          DEBUG1("DMRSlotRX: Sync lost after terminator, ending call cleanly");
-#endif
-        } else if (m_callActive[slot]) {
-          uint32_t dtMs = millis() - m_callStartMs[slot];
-          uint32_t sec10 = (dtMs + 50U) / 100U;
-          uint32_t secI = sec10 / 10U;
-          uint32_t secF = sec10 % 10U;
-          char rfLostLine[128];
-          snprintf(rfLostLine, sizeof(rfLostLine), "DMR Slot %u, RF voice transmission lost, %lu.%lu seconds, BER: 0.0%%", slot + 1U, (unsigned long)secI, (unsigned long)secF);
-          DEBUG1(rfLostLine);
+            DEBUG1("DMRSlotRX: Sync lost after terminator, ending call cleanly");
+#endif
+            dmrLastHeard.end(m_lhBase + slot, DMRLHE_TERMINATOR);
+          } else if (m_callActive[slot] && !m_callFiltered[slot]) {
+            uint32_t dtMs = millis() - m_callStartMs[slot];
+            uint32_t sec10 = (dtMs + 50U) / 100U;
+            uint32_t secI = sec10 / 10U;
+            uint32_t secF = sec10 % 10U;
+            char rfLostLine[128];
+            snprintf(rfLostLine, sizeof(rfLostLine), "DMR Slot %u, RF voice transmission lost, %lu.%lu seconds, BER: 0.0%%", slot + 1U, (unsigned long)secI, (unsigned long)secF);
+            DEBUG1(rfLostLine);
+          }
+
+          m_callActive[slot] = false;
+          dmrLastHeard.end(m_lhBase + slot, DMRLHE_SYNC_LOST);
+          if (!m_callFiltered[slot])
+            writeLost(slot);
         }
 
-        m_callActive[slot] = false;
-        serial.writeDMRLost(slot);
-        // If a voice call was active on the OTHER slot, notify MMDVMHost for that slot too
+        // If a voice call was active on the OTHER slot, notify MMDVMHost for
+        // that slot too, the count of the idle slot can run out first
         uint8_t otherSlot = slot ^ 1U;
         if (m_callActive[otherSlot]) {
           m_callActive[otherSlot] = false;
-          serial.writeDMRLost(otherSlot);
+          dmrLastHeard.end(m_lhBase + otherSlot, DMRLHE_SYNC_LOST);
+          if (!m_callFiltered[otherSlot])
+            writeLost(otherSlot);
         }
+        reset(); // ALWAYS reset after sync is lost to prevent looping
       }
-      reset(); // ALWAYS reset after sync is lost to prevent looping
-    }
-  }
 #else
       if (m_state[slot] != DMRRXS_NONE) {
-        m_syncCount[slot]++;
+        if (m_burstCost <= m_flywheelCost)
+          m_syncCount[slot] = 0U;
+        else
+          m_syncCount[slot]++;
         if (m_syncCount[slot] >= MAX_SYNC_LOST_FRAMES) {
-          serial.writeDMRLost(slot);
+          dmrLastHeard.end(m_lhBase + slot, DMRLHE_SYNC_LOST);
+          if (!m_callFiltered[slot])
+            writeLost(slot);
           reset();
         }
       }
@@ -537,13 +602,14 @@ void CDMRSlotRX::procSlot2()
       if (m_state[slot] == DMRRXS_VOICE) {
         if (m_n[slot] >= 5U) {
           frame[0U] = CONTROL_VOICE;
-          serial.writeDMRData(slot, &frame[1], DMR_FRAME_LENGTH_BYTES);
           m_n[slot] = 0U;
         } else {
           frame[0U] = ++m_n[slot];
-          serial.writeDMRData(slot, &frame[1], DMR_FRAME_LENGTH_BYTES);
         }
 
+        if (!m_callFiltered[slot])
+          writeHost(slot, &frame[1], DMR_FRAME_LENGTH_BYTES);
+
         // [debug removed - high frequency]
         // [debug removed - high frequency]
       } else if (m_state[slot] == DMRRXS_DATA) {
@@ -554,20 +620,114 @@ void CDMRSlotRX::procSlot2()
       }
     }
 
-    // End of this slot, reset some items for the next slot.
-    m_control = CONTROL_NONE;
-    m_inverted = false;
+    endSlot();
+  }
+}
+
+void CDMRSlotRX::endSlot()
+{
+  // End of this slot, reset some items for the next slot.
+  m_control = CONTROL_NONE;
+  m_inverted = false;
 
 #if defined(MS_MODE)
-    // Advance pointers for next slot (flywheel)
+  // Advance pointers for next slot (flywheel), unless sync was just lost
+  if (m_endPtr != NOENDPTR) {
     m_syncPtr  = (m_syncPtr  + 288U) % DMR_BUFFER_LENGTH_BITS;
     m_startPtr = (m_startPtr + 288U) % DMR_BUFFER_LENGTH_BITS;
     m_endPtr   = (m_endPtr   + 288U) % DMR_BUFFER_LENGTH_BITS;
-    // Slot toggle is now deferred to decodeCACH() to prevent timing races
-    // during slot identity correction.
+  }
+  // Slot toggle is now deferred to decodeCACH() to prevent timing races
+  // during slot identity correction.
 #endif
+}
+
+void CDMRSlotRX::scoreBurst(uint8_t slot, uint8_t& colorCode, uint8_t& dataType, uint8_t* payload)
+{
+  if (m_control == CONTROL_DATA) {
+    CDMRSlotType slotType;
+    uint8_t errs = slotType.decode(frame + 1U, colorCode, dataType);
+    m_burstCost = m_syncErrs + errs;
+
+    // A sync and slot type too poor to act on, the burst is scored as
+    // a missed one below
+    if (errs > DMR_SLOT_TYPE_MAX_ERRS || m_burstCost > m_flywheelCost)
+      m_control = CONTROL_NONE;
   }
 
+  if (m_control == CONTROL_DATA) {
+    // Bursts carrying BPTC(196,96) add the bits it had to correct, the
+    // payload is kept for the LC and CSBK decoders
+    switch (dataType) {
+      case DT_VOICE_PI_HEADER:
+      case DT_VOICE_LC_HEADER:
+      case DT_TERMINATOR_WITH_LC:
+      case DT_CSBK:
+      case DT_DATA_HEADER:
+      case DT_RATE_12_DATA:
+      case DT_IDLE: {
+          CBPTC19696 bptc;
+          m_burstCost += bptc.decode(frame + 1U, payload);
+        }
+        break;
+      default:
+        break;
+    }
+  } else if (m_control == CONTROL_VOICE) {
+    m_burstCost = m_syncErrs;
+  } else if (m_state[slot] == DMRRXS_VOICE && m_n[slot] < 5U) {
+    // Voice B to F carry the EMB where the sync would be
+    m_burstCost = COST_NO_SYNC + embCost();
+  } else if (m_state[slot] == DMRRXS_VOICE) {
+    m_burstCost = syncDistance(DMR_BS_VOICE_SYNC_BITS, DMR_MS_VOICE_SYNC_BITS);
+  } else if (m_state[slot] == DMRRXS_DATA) {
+    m_burstCost = syncDistance(DMR_BS_DATA_SYNC_BITS, DMR_MS_DATA_SYNC_BITS);
+  } else {
+    m_burstCost = COST_NO_SYNC + COST_UNCHECKED;
+  }
+}
+
+// Distance of a flywheeled burst from the sync it should have carried, as
+// correlateSync() matches it, in either polarity
+uint8_t CDMRSlotRX::syncDistance(uint64_t bs, uint64_t ms) const
+{
+  // Bits 108 to 155 of the burst
+  uint64_t pattern = 0U;
+  for (uint8_t i = 14U; i <= 20U; i++)
+    pattern = (pattern << 8) | frame[i];
+  pattern = (pattern >> 4) & DMR_SYNC_BITS_MASK;
+
+  uint8_t bsErrs = countBits64(pattern ^ bs);
+  uint8_t msErrs = countBits64(pattern ^ ms);
+
+  uint8_t errs = bsErrs < msErrs ? bsErrs : msErrs;
+  if (errs > DMR_SYNC_LENGTH_BITS / 2U)
+    errs = DMR_SYNC_LENGTH_BITS - errs;
+
+  if (errs > MAX_FLYWHEEL_SYNC_ERRS)
+    return COST_NO_SYNC + COST_UNCHECKED;
+
+  return errs;
+}
+
+uint8_t CDMRSlotRX::embCost() const
+{
+  // The two halves either side of the embedded signalling, bits 108 to 115
+  // and 148 to 155 of the burst
+  uint16_t emb = ((frame[14U] & 0x0FU) << 12) | ((frame[15U] & 0xF0U) << 4) |
+                 ((frame[19U] & 0x0FU) << 4)  | ((frame[20U] & 0xF0U) >> 4);
+
+  uint8_t data;
+  uint8_t errs;
+  if (!CQR1676::decode(emb, data, errs))
+    return COST_UNCHECKED;
+
+  // The colour code is in the top four data bits
+  if (m_colorCode != 0U && (data >> 3) != m_colorCode)
+    return COST_UNCHECKED;
+
+  return errs;
+}
 
 void CDMRSlotRX::correlateSync()
 {
@@ -581,78 +741,67 @@ void CDMRSlotRX::correlateSync()
   uint16_t startPtr;
   uint16_t endPtr;
   uint8_t  control = CONTROL_NONE;
+  uint64_t sync    = 0U;
+  uint64_t pattern = m_history.getPattern() & DMR_SYNC_BITS_MASK;
 
-  if (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_BS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
+  if (countBits64(pattern ^ DMR_BS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
     control = CONTROL_DATA;
+    sync = DMR_BS_DATA_SYNC_BITS;
     m_inverted = false;
-  } else if (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_BS_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
+  } else if (countBits64(pattern ^ DMR_BS_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
     control = CONTROL_VOICE;
+    sync = DMR_BS_VOICE_SYNC_BITS;
     m_inverted = false;
-  } else if (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_BS_DATA_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) {
+  } else if (countBits64(pattern ^ DMR_BS_DATA_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) {
     control = CONTROL_DATA;
+    sync = DMR_BS_DATA_SYNC_BITS_INV;
     m_inverted = true;
-  } else if (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_BS_VOICE_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) {
+  } else if (countBits64(pattern ^ DMR_BS_VOICE_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) {
     control = CONTROL_VOICE;
+    sync = DMR_BS_VOICE_SYNC_BITS_INV;
     m_inverted = true;
-  } else if (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
+  } else if (countBits64(pattern ^ DMR_MS_DATA_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
     control = CONTROL_DATA;
+    sync = DMR_MS_DATA_SYNC_BITS;
     m_inverted = false;
-  } else if (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
+  } else if (countBits64(pattern ^ DMR_MS_VOICE_SYNC_BITS) <= MAX_SYNC_BYTES_ERRS) {
     control = CONTROL_VOICE;
+    sync = DMR_MS_VOICE_SYNC_BITS;
     m_inverted = false;
-  } else if (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_DATA_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) {
+  } else if (countBits64(pattern ^ DMR_MS_DATA_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) {
     control = CONTROL_DATA;
+    sync = DMR_MS_DATA_SYNC_BITS_INV;
     m_inverted = true;
-  } else if (countBits64((m_patternBuffer & DMR_SYNC_BITS_MASK) ^ DMR_MS_VOICE_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) {
+  } else if (countBits64(pattern ^ DMR_MS_VOICE_SYNC_BITS_INV) <= MAX_SYNC_BYTES_ERRS) {
     control = CONTROL_VOICE;
+    sync = DMR_MS_VOICE_SYNC_BITS_INV;
     m_inverted = true;
   }
 
   if (control != CONTROL_NONE) {
+    // Bit errors in the matched sync word, used for the call BER estimate
+    m_syncErrs = countBits64(pattern ^ sync);
+
 #if defined(MS_MODE)
     // Set sync lock when we find a BS sync pattern
-    if (control != CONTROL_NONE && m_bitsReceived >= MIN_BITS_FOR_CACH_READ) {
+    if (control != CONTROL_NONE && m_history.getCount() >= MIN_BITS_FOR_CACH_READ) {
       // Determine the correct timeslot from this burst's own CACH.
       // The CACH for the current burst starts 179 bits before the sync end
       // (sync ends at bit 179 of the 288-bit slot; CACH is at bits 0-23).
-      // Bit 1 of the CACH is the TC bit: TC=0 → TS1 (m_currentSlot=1),
-      //                                  TC=1 → TS2 (m_currentSlot=2).
       // The TC bit in the CACH describes the identity of the current burst
       // (TC=0 → TS1, TC=1 → TS2).
       uint16_t tcCachStart = (m_dataPtr + DMR_BUFFER_LENGTH_BITS - 179U) % DMR_BUFFER_LENGTH_BITS;
-      bool t[7];
-      t[0] = READ_BIT1(m_buffer, (tcCachStart + 0U) % DMR_BUFFER_LENGTH_BITS); // AT
-      t[1] = READ_BIT1(m_buffer, (tcCachStart + 1U) % DMR_BUFFER_LENGTH_BITS); // TC
-      t[2] = READ_BIT1(m_buffer, (tcCachStart + 5U) % DMR_BUFFER_LENGTH_BITS); // LCSS1
-      t[3] = READ_BIT1(m_buffer, (tcCachStart + 6U) % DMR_BUFFER_LENGTH_BITS); // LCSS0
-      t[4] = READ_BIT1(m_buffer, (tcCachStart + 10U) % DMR_BUFFER_LENGTH_BITS); // H2
-      t[5] = READ_BIT1(m_buffer, (tcCachStart + 11U) % DMR_BUFFER_LENGTH_BITS); // H1
-      t[6] = READ_BIT1(m_buffer, (tcCachStart + 15U) % DMR_BUFFER_LENGTH_BITS); // H0
-
-      // Hamming(7,4) check
-      bool s0 = t[0] ^ t[1] ^ t[2] ^ t[4];
-      bool s1 = t[1] ^ t[2] ^ t[3] ^ t[5];
-      bool s2 = t[0] ^ t[1] ^ t[3] ^ t[6];
-
-      uint8_t s = (s2 << 2) | (s1 << 1) | s0;
-      if (s != 0) {
-        // Single bit error correction
-        switch (s) {
-          case 5: t[0] = !t[0]; break;
-          case 7: t[1] = !t[1]; break;
-          case 3: t[2] = !t[2]; break;
-          case 6: t[3] = !t[3]; break;
-          case 1: t[4] = !t[4]; break;
-          case 2: t[5] = !t[5]; break;
-          case 4: t[6] = !t[6]; break;
-          default: break; // Multi-bit error - use raw bit
-        }
-      }
+      bool c[24];
+      for (uint8_t i = 0; i < 24; i++)
+        c[i] = m_history.getBit((tcCachStart + i) % DMR_BUFFER_LENGTH_BITS);
 
-      // The TC bit indicates the identity of the burst that follows the CACH.
-      // Since this CACH precedes the current burst, it identifies the current burst.
-      // (TC=0 → TS1, TC=1 → TS2)
-      uint8_t indicated_current_slot = t[1] ? 2U : 1U;
+      // The TACT is interleaved with the Short LC, an uncorrectable one
+      // leaves the raw TC bit
+      bool tc = c[4];
+      uint8_t lcss;
+      CDMRShortLC::decodeTACT(c, tc, lcss);
+
+      uint8_t indicated_current_slot = tc ? 2U : 1U;
       if (!m_syncLocked) {
         m_currentSlot = indicated_current_slot;
         m_syncLocked = true;
@@ -715,44 +864,21 @@ void CDMRSlotRX::decodeCACH()
 
   bool c[24];
   for (uint8_t i = 0; i < 24; i++) {
-    c[i] = READ_BIT1(m_buffer, (cachStartPtr + i) % DMR_BUFFER_LENGTH_BITS);
+    c[i] = m_history.getBit((cachStartPtr + i) % DMR_BUFFER_LENGTH_BITS);
   }
 
-  // TACT bits
-  bool t[7];
-  t[0] = c[0];  // AT
-  t[1] = c[1];  // TC
-  t[2] = c[5];  // LCSS1
-  t[3] = c[6];  // LCSS0
-  t[4] = c[10]; // H2
-  t[5] = c[11]; // H1
-  t[6] = c[15]; // H0
-
-  // Hamming(7,4) check
-  bool s0 = t[0] ^ t[1] ^ t[2] ^ t[4];
-  bool s1 = t[1] ^ t[2] ^ t[3] ^ t[5];
-  bool s2 = t[0] ^ t[1] ^ t[3] ^ t[6];
-
-  uint8_t s = (s2 << 2) | (s1 << 1) | s0;
-  if (s != 0) {
-    // Single bit error correction
-    switch (s) {
-      case 5: t[0] = !t[0]; break;
-      case 7: t[1] = !t[1]; break;
-      case 3: t[2] = !t[2]; break;
-      case 6: t[3] = !t[3]; break;
-      case 1: t[4] = !t[4]; break;
-      case 2: t[5] = !t[5]; break;
-      case 4: t[6] = !t[6]; break;
-      default: return; // Multi-bit error
-    }
-  }
+  m_shortLC.decode(c);
+
+  bool tc;
+  uint8_t lcss;
+  if (!CDMRShortLC::decodeTACT(c, tc, lcss))
+    return;
 
   // TC bit to logical timeslot mapping per DMR spec (ETSI TS 102 361-1):
   // TC=0 → TS1, TC=1 → TS2. This CACH identifies the burst currently being received.
   // Since we just toggled m_currentSlot, we verify it matches the TC bit's 
   // indication with 2-burst hysteresis.
-  uint8_t indicated_next_slot = t[1] ? 2U : 1U;
+  uint8_t indicated_next_slot = tc ? 2U : 1U;
   if (m_currentSlot != indicated_next_slot) {
     if (++m_slotHysteresis >= 2U) {
       //DEBUG2("Slot changed at CACH to", indicated_next_slot);
@@ -764,45 +890,6 @@ void CDMRSlotRX::decodeCACH()
   }
 }
 
-void CDMRSlotRX::bitsToBytes(uint16_t start, uint8_t count, uint8_t* buffer)
-{
-  for (uint8_t i = 0U; i < count; i++) {
-    buffer[i]  = 0U;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 7;
-    start++;
-    if (start >= DMR_BUFFER_LENGTH_BITS)
-      start -= DMR_BUFFER_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 6;
-    start++;
-    if (start >= DMR_BUFFER_LENGTH_BITS)
-      start -= DMR_BUFFER_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 5;
-    start++;
-    if (start >= DMR_BUFFER_LENGTH_BITS)
-      start -= DMR_BUFFER_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 4;
-    start++;
-    if (start >= DMR_BUFFER_LENGTH_BITS)
-      start -= DMR_BUFFER_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 3;
-    start++;
-    if (start >= DMR_BUFFER_LENGTH_BITS)
-      start -= DMR_BUFFER_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 2;
-    start++;
-    if (start >= DMR_BUFFER_LENGTH_BITS)
-      start -= DMR_BUFFER_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 1;
-    start++;
-    if (start >= DMR_BUFFER_LENGTH_BITS)
-      start -= DMR_BUFFER_LENGTH_BITS;
-    buffer[i] |= READ_BIT1(m_buffer, start) << 0;
-    start++;
-    if (start >= DMR_BUFFER_LENGTH_BITS)
-      start -= DMR_BUFFER_LENGTH_BITS;
-  }
-}
-
 void CDMRSlotRX::setColorCode(uint8_t colorCode)
 {
   m_colorCode = colorCode;
@@ -813,6 +900,42 @@ void CDMRSlotRX::setDelay(uint8_t delay)
   m_delay = delay / 5;
 }
 
+uint8_t CDMRSlotRX::setQuality(uint8_t forward, uint8_t start, uint8_t flywheel)
+{
+  // An unchecked flywheeled burst must never count as heard, or a lost
+  // call would never end
+  if (flywheel >= COST_NO_SYNC + COST_UNCHECKED)
+    return 4U;
+
+  m_forwardCost  = forward;
+  m_startCost    = start;
+  m_flywheelCost = flywheel;
+
+  return 0U;
+}
+
+uint32_t CDMRSlotRX::getSyncTime(uint8_t slot) const
+{
+  return m_syncTime[slot & 1U];
+}
+
+bool CDMRSlotRX::isActive(uint8_t slot) const
+{
+  return m_state[slot & 1U] != DMRRXS_NONE;
+}
+
+bool CDMRSlotRX::hasCall(uint8_t slot) const
+{
+  return m_state[slot & 1U] != DMRRXS_NONE && m_state[slot & 1U] != DMRRXS_TERMINATOR;
+}
+
+#if defined(MS_MODE)
+const CDMRShortLC& CDMRSlotRX::getShortLC() const
+{
+  return m_shortLC;
+}
+#endif
+
 void CDMRSlotRX::writeRSSIData()
 {
 #if defined(MS_MODE)
@@ -821,28 +944,70 @@ void CDMRSlotRX::writeRSSIData()
 #else
   uint8_t slot = m_slot ? 1U : 0U;
 #endif
+
+  // Bursts of calls rejected by the TG/ID filter never reach the host
+  if (m_callFiltered[slot])
+    return;
   
 #if defined(SEND_RSSI_DATA)
   uint16_t rssi = io.readRSSI();
 
+  dmrLastHeard.addRSSI(m_lhBase + slot, rssi);
+
   frame[34U] = (rssi >> 8) & 0xFFU;
   frame[35U] = (rssi >> 0) & 0xFFU;
 
 #if defined(MS_MODE)
-  // Forward every burst immediately in MS_MODE so Pi-Star/MMDVMHost
-  // sees BS downlink traffic as if it were MS uplink. Rely on the host
-  // to discard any invalid frames rather than suppressing here.
-  serial.writeDMRData(slot, frame, DMR_FRAME_LENGTH_BYTES + 3U);
+  // Forward the burst immediately in MS_MODE so Pi-Star/MMDVMHost
+  // sees BS downlink traffic as if it were MS uplink, writeHost() keeps
+  // back the ones too poor to be worth the host's time.
+  writeHost(slot, frame, DMR_FRAME_LENGTH_BYTES + 3U);
 #else
-  serial.writeDMRData(slot, frame, DMR_FRAME_LENGTH_BYTES + 3U);
+  writeHost(slot, frame, DMR_FRAME_LENGTH_BYTES + 3U);
 #endif
 #else
 #if defined(MS_MODE)
-  serial.writeDMRData(slot, &frame[1], DMR_FRAME_LENGTH_BYTES);
+  writeHost(slot, &frame[1], DMR_FRAME_LENGTH_BYTES);
 #else
-  serial.writeDMRData(slot, &frame[1], DMR_FRAME_LENGTH_BYTES);
+  writeHost(slot, &frame[1], DMR_FRAME_LENGTH_BYTES);
+#endif
+#endif
+}
+
+void CDMRSlotRX::writeHost(uint8_t slot, uint8_t* data, uint8_t length)
+{
+  // Without RSSI data the serial header lands on the control byte
+  uint8_t control = frame[0U];
+
+  // Too poor for the host, below the combiner so the other copy can win
+  if (m_burstCost > m_forwardCost)
+    return;
+
+#if defined(DUAL_RX)
+  // Both receivers offer their copy, the combiner forwards one of them
+  if (dmrDiversity.isEnabled()) {
+    dmrDiversity.write(m_receiver, slot ? true : false, control, data, length, m_burstCost, m_endTime[slot]);
+    return;
+  }
 #endif
+
+  serial.writeDMRFrame(slot ? true : false, data, length, m_receiver);
+
+  // From the last bit of the burst on air to the frame being queued for the
+  // UART, the time it then waits for and spends on the wire is not included
+  dmrLatency.add(control, io.getTicks() - m_endTime[slot]);
+}
+
+void CDMRSlotRX::writeLost(uint8_t slot)
+{
+#if defined(DUAL_RX)
+  if (dmrDiversity.isEnabled()) {
+    dmrDiversity.writeLost(m_receiver, slot ? true : false);
+    return;
+  }
 #endif
+
+  serial.writeDMRLost(slot ? true : false, m_receiver);
 }
 
 #endif
@@ -25,8 +25,10 @@
 #if defined(DUPLEX)
 
 #include "DMRDefines.h"
+#include "BitHistory.h"
+#include "DMRShortLC.h"
 
-const uint16_t DMR_BUFFER_LENGTH_BITS = 576U;
+const uint16_t DMR_BUFFER_LENGTH_BITS = BIT_HISTORY_LENGTH_BITS;
 
 enum DMR_RX_STATE : uint8_t {
   DMRRXS_NONE,
@@ -38,35 +40,69 @@ enum DMR_RX_STATE : uint8_t {
 
 class CDMRSlotRX {
 public:
-  CDMRSlotRX();
+  // Receiver 1 is the second downlink of a DUAL_RX build
+  CDMRSlotRX(CBitHistory& history, uint8_t receiver);
 
   void start(bool slot);
 
-  bool databit(bool bit);
+  // Processes the newest bit in the bit history
+  bool databit();
 
   void setColorCode(uint8_t colorCode);
   void setDelay(uint8_t delay);
 
+  // Burst cost limits: to be forwarded, to start a call or data transfer,
+  // and to count as heard rather than missed by the flywheel. 255 turns the
+  // first two off.
+  uint8_t setQuality(uint8_t forward, uint8_t start, uint8_t flywheel);
+
+  // Bit clock tick of the sync word in the last burst on the slot. Only
+  // CDMRTrunk reads it, and it reaches the host only as the retune to sync
+  // latency of MMDVM_DMR_TRUNK_STATUS.
+  uint32_t getSyncTime(uint8_t slot) const;
+
+  // A call or data transfer is in progress on the slot
+  bool isActive(uint8_t slot) const;
+
+  // As isActive(), until the call's terminator rather than the sync loss
+  // that follows it
+  bool hasCall(uint8_t slot) const;
+
+#if defined(MS_MODE)
+  // What the site reports of itself in the CACH
+  const CDMRShortLC& getShortLC() const;
+#endif
+
   void reset();
 
 private:
+  CBitHistory& m_history;
+  uint8_t m_receiver;
+  uint8_t m_lhBase;
   bool m_slot;
-  uint64_t m_patternBuffer;
-  uint8_t m_buffer[DMR_BUFFER_LENGTH_BITS / 8U];  // 72 bytes
   uint16_t m_dataPtr;
 
-  uint8_t frame[DMR_FRAME_LENGTH_BYTES + 3U];
+  uint8_t m_frameBuffer[DMR_FRAME_HEADROOM + DMR_FRAME_LENGTH_BYTES + 3U];
+  uint8_t* frame;
   uint16_t m_syncPtr;
   uint16_t m_startPtr;
   uint16_t m_endPtr;
   uint8_t m_control;
   bool m_inverted;
+  uint8_t m_syncErrs;
+  uint8_t m_burstCost;
+  uint8_t m_forwardCost;
+  uint8_t m_startCost;
+  uint8_t m_flywheelCost;
   uint8_t m_syncCount[2];
   DMR_RX_STATE m_state[2];
   uint8_t m_n[2];
   uint8_t m_type[2];
   uint32_t m_callStartMs[2];
+  uint32_t m_syncTime[2];
+  uint32_t m_endTime[2];
   bool m_callActive[2];
+  bool m_callFiltered[2];
 
 
   uint16_t m_delayPtr;
@@ -80,15 +116,22 @@ private:
   uint8_t m_lcData[12];  // Store LC data for embedding in voice frames
   bool m_lcValid[2];     // Flag indicating if LC data is valid
   uint8_t m_slotHysteresis;
-  uint16_t m_bitsReceived;
   uint8_t m_terminator_count;
+  CDMRShortLC m_shortLC;
 #endif
 
   void procSlot2();
+  void endSlot();
+  // Decodes the BPTC(196,96) of the bursts that carry it into payload, once,
+  // for the LC and CSBK decoders after it
+  void scoreBurst(uint8_t slot, uint8_t& colorCode, uint8_t& dataType, uint8_t* payload);
+  uint8_t syncDistance(uint64_t bs, uint64_t ms) const;
+  uint8_t embCost() const;
   void decodeCACH();
   void correlateSync();
-  void bitsToBytes(uint16_t start, uint8_t count, uint8_t* buffer);
   void writeRSSIData();
+  void writeHost(uint8_t slot, uint8_t* data, uint8_t length);
+  void writeLost(uint8_t slot);
 };
 
 #endif
@@ -19,20 +19,25 @@
 #if !defined(DMRSLOTTYPE_H)
 #define  DMRSLOTTYPE_H
 
+// Golay(20,8) has a minimum distance of eight, a slot type further than this
+// from its nearest codeword cannot be trusted
+const uint8_t DMR_SLOT_TYPE_MAX_ERRS = 3U;
+
 class CDMRSlotType {
 public:
   CDMRSlotType();
 
-  void decode(const uint8_t* frame, uint8_t& colorCode, uint8_t& dataType) const;
+  // Decodes to the nearest codeword, returns how many of the 20 received
+  // bits differ from it
+  uint8_t decode(const uint8_t* frame, uint8_t& colorCode, uint8_t& dataType) const;
 
   void encode(uint8_t colorCode, uint8_t dataType, uint8_t* frame) const;
 
 private:
 
-  uint8_t  decode2087(const uint8_t* data) const;
+  uint8_t  decode2087(uint32_t code, uint8_t& errs) const;
+  uint16_t parity2087(uint8_t data) const;
   uint32_t getSyndrome1987(uint32_t pattern) const;
-  uint32_t getSyndrome2087(uint32_t pattern) const;
-  uint8_t  correct(uint8_t* data) const;
 };
 
 #endif
@@ -28,14 +28,54 @@
 #include "DMRDefines.h"
 #include "Utils.h"
 
+const uint8_t BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
+
+#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
+#define READ_BIT1(p,i)    (p[(i)>>3] & BIT_MASK_TABLE[(i)&7])
+
+// The host sends the 68 bits of the Short LC with its FEC and interleaving
+const uint8_t DMR_SHORTLC_LENGTH_BYTES = 9U;
+
+// An all zero Short LC is a valid Null message
+const uint8_t NULL_SHORTLC[DMR_SHORTLC_LENGTH_BYTES] = {0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U};
+
+const uint8_t CACH_LCSS[] = {DMR_LCSS_FIRST, DMR_LCSS_CONTINUATION, DMR_LCSS_CONTINUATION, DMR_LCSS_LAST};
+
+const uint8_t CONTROL_DATA = 0x40U;
+
+// The host sends a TS2 frame every 60 ms
+const uint32_t TX_FRAME_MS = 60U;
+
+const uint8_t TX_MAX_PREFILL = SERIAL_RINGBUFFER_SIZE / (DMR_FRAME_LENGTH_BYTES + 1U);
+
+// Bits on air ahead of the next burst or CACH made, a burst and a CACH
+const uint16_t TX_LEAD_BITS = 288U;
+
 CDMRTX::CDMRTX() :
 m_state(DMRTXSTATE_IDLE),
-//m_cachPtr(0U),
+m_cach(),
+m_cachSet(0U),
+m_newCACH(false),
+m_cachPtr(0U),
 m_poLen(0U),
 m_poPtr(0U),
-m_frameCount(0U)
+m_frameCount(0U),
+m_prefill(1U),
+m_hang(),
+m_last(DMRTXL_DATA),
+m_waiting(false),
+m_waitMs(0U),
+m_underrun(false),
+m_underruns(0U),
+m_midCallIdles(0U),
+m_peak(0U)
 //m_control_old(0U)
 {
+  // A voice call may go on after a late frame, data and a terminator end it
+  m_hang[DMRTXL_VOICE]      = 20U;
+  m_hang[DMRTXL_DATA]       = 10U;
+  m_hang[DMRTXL_TERMINATOR] = 5U;
+
   m_fifo[0].reset();
   m_fifo[1].reset();
 
@@ -44,6 +84,8 @@ m_frameCount(0U)
 
   memset(m_idle, 0U, DMR_FRAME_LENGTH_BYTES);
   m_idle[0] = (DT_IDLE << 0);
+
+  encodeCACH(NULL_SHORTLC, 0U);
 }
 
 uint8_t CDMRTX::writeData1(const uint8_t* data, uint8_t length)
@@ -75,15 +117,23 @@ uint8_t CDMRTX::writeData2(const uint8_t* data, uint8_t length)
   for (uint8_t i = 0U; i < (DMR_FRAME_LENGTH_BYTES + 1U); i++)
     m_fifo[1].put(data[i]);
 
+  uint8_t frames = getFrames();
+  if (frames > m_peak)
+    m_peak = frames;
+
   return 0U;
 }
 
 uint8_t CDMRTX::writeShortLC(const uint8_t* data, uint8_t length)
 
 {
-  (void)data;
-  (void)length;
-  DEBUG1("DMRTX : writeShortLC");
+  if (length != DMR_SHORTLC_LENGTH_BYTES)
+    return 4U;
+
+  // Goes on air from the next first fragment
+  encodeCACH(data, m_cachSet ^ 1U);
+  m_newCACH = true;
+
   return 0U;
 }
 
@@ -109,23 +159,72 @@ void CDMRTX::reset()
   m_fifo[0].reset();
   m_fifo[1].reset();
   m_state = DMRTXSTATE_IDLE;
+  m_waiting = false;
   io.setRX();
 }
 
 void CDMRTX::process()
 
 {
-  
+  // The last burst or CACH goes into the ring whole before the next one is
+  // made, so the state machine runs at the slot rate
+  if (m_poLen > 0U) {
+    // Whole bytes that leave at least a bit of space in the ring
+    uint16_t space = io.getSpace();
+    if (space <= 8U)
+      return;
+
+    uint16_t n = (space - 1U) / 8U;
+    if (n > (m_poLen - m_poPtr))
+      n = m_poLen - m_poPtr;
+
+    io.writeBytes(m_poBuffer + m_poPtr, n);
+    m_poPtr += n;
+
+    if (m_poPtr >= m_poLen) {
+      m_poPtr = 0U;
+      m_poLen = 0U;
+    }
+
+    return;
+  }
+
+  // A frame is taken from the FIFO no sooner than the ring needs it, or
+  // the ring would draw on the prefill
+  if (m_state != DMRTXSTATE_IDLE && m_state != DMRTXSTATE_REQUEST_CHANNEL && io.getTXData() >= TX_LEAD_BITS)
+    return;
+
   switch (m_state) {
-  case DMRTXSTATE_IDLE:
-    if (m_fifo[1].getData() >= (DMR_FRAME_LENGTH_BYTES + 1U)) {
-      m_state = DMRTXSTATE_REQUEST_CHANNEL;
+  case DMRTXSTATE_IDLE: {
+      uint8_t frames = getFrames();
+      if (frames == 0U) {
+        m_waiting = false;
+        break;
+      }
+
+      if (!m_waiting) {
+        m_waiting = true;
+        m_waitMs  = millis();
+      }
+
+      // Keys with the prefill queued, or once the first frame has waited as
+      // long as the rest take to arrive, so that a short burst of data goes
+      if (frames >= m_prefill || (millis() - m_waitMs) >= ((m_prefill - 1U) * TX_FRAME_MS)) {
+        m_waiting = false;
+        m_state = DMRTXSTATE_REQUEST_CHANNEL;
+      }
     }
     break;
 
   case DMRTXSTATE_REQUEST_CHANNEL:
+    // Wait for the end of a switch back to RX
+    if (io.isSwitching())
+      break;
+
     io.setTX();
     m_frameCount = 0U;
+    m_cachPtr = 0U;
+    m_underrun = false;
     m_state = DMRTXSTATE_SLOT1;
     DEBUG1("DMRTX : requestChannel");
     break;
@@ -136,18 +235,30 @@ void CDMRTX::process()
     break;
 
   case DMRTXSTATE_CACH1:
-    createCACH(0, 1);
+    createCACH(1U, 0U);
     m_state = DMRTXSTATE_SLOT2;
     break;
 
   case DMRTXSTATE_SLOT2:
-    if (m_fifo[1].getData() >= (DMR_FRAME_LENGTH_BYTES + 1U)) {
+    if (getFrames() > 0U) {
       createData(1, false);
       m_frameCount = 0U;
+      m_underrun = false;
     } else {
       createData(1, true);
+
+      // Voice stopping short of its terminator, the host is late
+      if (m_last == DMRTXL_VOICE) {
+        if (!m_underrun)
+          m_underruns++;
+        m_underrun = true;
+        m_midCallIdles++;
+      }
+
       m_frameCount++;
-      if (m_frameCount > 20U) {
+      if (m_frameCount > m_hang[m_last]) {
+        // The idle burst would key the transmitter again
+        m_poLen = 0U;
         m_state = DMRTXSTATE_IDLE;
         io.setRX();
         return;
@@ -157,27 +268,13 @@ void CDMRTX::process()
     break;
 
   case DMRTXSTATE_CACH2:
-    createCACH(1, 0);
+    createCACH(0U, 1U);
     m_state = DMRTXSTATE_SLOT1;
     break;
 
   default:
     break;
   }
-
-  if (m_poLen > 0U) {
-    uint16_t space = io.getSpace();
-    while (space > 8U) {
-      writeByte(m_poBuffer[m_poPtr++], 0x00U);
-      space -= 8U;
-
-      if (m_poPtr >= m_poLen) {
-        m_poPtr = 0U;
-        m_poLen = 0U;
-        return;
-      }
-    }
-  }
 }
 
 uint8_t CDMRTX::getSpace1() const
@@ -195,6 +292,53 @@ void CDMRTX::setColorCode(uint8_t colorCode)
   (void)colorCode;
 }
 
+uint8_t CDMRTX::setBuffer(const uint8_t* data, uint8_t length)
+{
+  if (length != 4U)
+    return 4U;
+
+  if (data[0U] == 0U || data[0U] > TX_MAX_PREFILL)
+    return 4U;
+
+  m_prefill                 = data[0U];
+  m_hang[DMRTXL_VOICE]      = data[1U];
+  m_hang[DMRTXL_DATA]       = data[2U];
+  m_hang[DMRTXL_TERMINATOR] = data[3U];
+
+  return 0U;
+}
+
+uint8_t CDMRTX::readStatus(uint8_t* data, uint8_t length) const
+{
+  if (length < DMR_TX_STATUS_LENGTH)
+    return 0U;
+
+  data[0U] = m_prefill;
+  data[1U] = m_hang[DMRTXL_VOICE];
+  data[2U] = m_hang[DMRTXL_DATA];
+  data[3U] = m_hang[DMRTXL_TERMINATOR];
+  data[4U] = getFrames();
+  data[5U] = m_peak;
+  data[6U] = (m_underruns >> 8) & 0xFFU;
+  data[7U] = (m_underruns >> 0) & 0xFFU;
+  data[8U] = (m_midCallIdles >> 8) & 0xFFU;
+  data[9U] = (m_midCallIdles >> 0) & 0xFFU;
+
+  return DMR_TX_STATUS_LENGTH;
+}
+
+void CDMRTX::resetStatus()
+{
+  m_underruns    = 0U;
+  m_midCallIdles = 0U;
+  m_peak         = getFrames();
+}
+
+uint8_t CDMRTX::getFrames() const
+{
+  return m_fifo[1].getData() / (DMR_FRAME_LENGTH_BYTES + 1U);
+}
+
 void CDMRTX::createData(uint8_t slotIndex, bool forceIdle)
 {
   uint8_t frame[DMR_FRAME_LENGTH_BYTES + 1];
@@ -204,6 +348,23 @@ void CDMRTX::createData(uint8_t slotIndex, bool forceIdle)
   } else {
     for (unsigned int i = 0U; i < (DMR_FRAME_LENGTH_BYTES + 1U); i++)
       frame[i] = m_fifo[slotIndex].get();
+
+    if ((frame[0] & CONTROL_DATA) == CONTROL_DATA) {
+      switch (frame[0] & 0x0FU) {
+        case DT_VOICE_LC_HEADER:
+        case DT_VOICE_PI_HEADER:
+          m_last = DMRTXL_VOICE;
+          break;
+        case DT_TERMINATOR_WITH_LC:
+          m_last = DMRTXL_TERMINATOR;
+          break;
+        default:
+          m_last = DMRTXL_DATA;
+          break;
+      }
+    } else {
+      m_last = DMRTXL_VOICE;
+    }
   }
 
   uint8_t dataType = frame[0] & 0x0FU;
@@ -230,23 +391,63 @@ void CDMRTX::createData(uint8_t slotIndex, bool forceIdle)
   m_poPtr = 0U;
 }
 
+// txSlotIndex is the slot of the burst that follows the CACH
 void CDMRTX::createCACH(uint8_t txSlotIndex, uint8_t rxSlotIndex)
 {
-  (void)txSlotIndex;
-  (void)rxSlotIndex;
-  m_poLen = 3U;
-  memset(m_poBuffer, 0, 3);
+  if (m_cachPtr >= 4U)
+    m_cachPtr = 0U;
+
+  if (m_cachPtr == 0U && m_newCACH) {
+    m_cachSet ^= 1U;
+    m_newCACH = false;
+  }
+
+  uint8_t at = m_fifo[rxSlotIndex].getData() > 0U ? 1U : 0U;
+
+  memcpy(m_poBuffer, m_cach[m_cachSet][m_cachPtr][at][txSlotIndex], DMR_CACH_LENGTH_BYTES);
+  m_cachPtr++;
+
+  m_poLen = DMR_CACH_LENGTH_BYTES;
   m_poPtr = 0U;
 }
 
-void CDMRTX::writeByte(uint8_t c, uint8_t control)
+// Builds every CACH the Short LC can be sent in, so that createCACH() only
+// copies one
+void CDMRTX::encodeCACH(const uint8_t* shortLC, uint8_t set)
 {
-  (void)control;
-  uint8_t bit;
-  uint8_t mask = 0x80U;
-  for (uint8_t i = 0U; i < 8U; i++, c <<= 1) {
-    bit = (c & mask) ? 1U : 0U;
-    io.write(&bit, 1);
+  for (uint8_t n = 0U; n < 4U; n++) {
+    uint8_t payload[DMR_CACH_LENGTH_BYTES] = {0x00U, 0x00U, 0x00U};
+    for (uint8_t i = 0U; i < 17U; i++) {
+      bool b = READ_BIT1(shortLC, n * 17U + i) != 0U;
+      WRITE_BIT1(payload, DMR_CACH_PAYLOAD[i], b);
+    }
+
+    bool ls1 = (CACH_LCSS[n] & 0x02U) == 0x02U;
+    bool ls0 = (CACH_LCSS[n] & 0x01U) == 0x01U;
+
+    for (uint8_t at = 0U; at < 2U; at++) {
+      for (uint8_t tc = 0U; tc < 2U; tc++) {
+        // AT, TC, LCSS and Hamming(7,4)
+        bool t[7U];
+        t[0U] = at == 1U;
+        t[1U] = tc == 1U;
+        t[2U] = ls1;
+        t[3U] = ls0;
+        t[4U] = t[0U] ^ t[1U] ^ t[2U];
+        t[5U] = t[1U] ^ t[2U] ^ t[3U];
+        t[6U] = t[0U] ^ t[1U] ^ t[3U];
+
+        uint8_t* cach = m_cach[set][n][at][tc];
+        memcpy(cach, payload, DMR_CACH_LENGTH_BYTES);
+        WRITE_BIT1(cach, 0U,  t[0U]);
+        WRITE_BIT1(cach, 4U,  t[1U]);
+        WRITE_BIT1(cach, 8U,  t[2U]);
+        WRITE_BIT1(cach, 12U, t[3U]);
+        WRITE_BIT1(cach, 14U, t[4U]);
+        WRITE_BIT1(cach, 18U, t[5U]);
+        WRITE_BIT1(cach, 22U, t[6U]);
+      }
+    }
   }
 }
 
@@ -23,6 +23,10 @@
 
 #include "Config.h"
 
+#include <stdint.h>
+
+const uint8_t DMR_TX_STATUS_LENGTH = 10U;
+
 #if defined(DUPLEX)
 
 #include "DMRDefines.h"
@@ -39,6 +43,14 @@ enum DMRTXSTATE {
   DMRTXSTATE_CAL
 };
 
+// What the last frame sent from the host was, for the hang time after it
+enum DMR_TX_LAST : uint8_t {
+  DMRTXL_VOICE,       // Voice header or burst, more voice is due
+  DMRTXL_DATA,
+  DMRTXL_TERMINATOR,
+  DMRTXL_COUNT
+};
+
 class CDMRTX {
 public:
   CDMRTX();
@@ -58,24 +70,46 @@ public:
 
   void setColorCode(uint8_t colorCode);
 
+  // Frames queued before the transmitter keys, then the idle bursts it
+  // hangs on for after voice, data and a terminator
+  uint8_t setBuffer(const uint8_t* data, uint8_t length);
+
+  // The settings, FIFO depth, peak depth, underruns and idle bursts sent
+  // mid-call, DMR_TX_STATUS_LENGTH bytes
+  uint8_t readStatus(uint8_t* data, uint8_t length) const;
+  void    resetStatus();
+
 private:
   CSerialRB                        m_fifo[2U];
   DMRTXSTATE                       m_state;
   uint8_t                          m_idle[DMR_FRAME_LENGTH_BYTES];
-  //uint8_t                          m_cachPtr;
-  //uint8_t                          m_shortLC[12U];
-  //uint8_t                          m_newShortLC[12U];
+  // Whole CACHs by Short LC fragment, AT and TC, a set on air and a set for
+  // the next Short LC
+  uint8_t                          m_cach[2U][4U][2U][2U][DMR_CACH_LENGTH_BYTES];
+  uint8_t                          m_cachSet;
+  bool                             m_newCACH;
+  uint8_t                          m_cachPtr;
   //uint8_t                          m_markBuffer[40U];
   uint8_t                          m_poBuffer[40U];
   uint16_t                         m_poLen;
   uint16_t                         m_poPtr;
   uint32_t                         m_frameCount;
+  uint8_t                          m_prefill;
+  uint8_t                          m_hang[DMRTXL_COUNT];
+  DMR_TX_LAST                      m_last;
+  bool                             m_waiting;
+  uint32_t                         m_waitMs;
+  bool                             m_underrun;
+  uint16_t                         m_underruns;
+  uint16_t                         m_midCallIdles;
+  uint8_t                          m_peak;
   //bool                             m_abort[2U];
   //uint8_t                          m_control_old;
 
   void createData(uint8_t slotIndex, bool forceIdle = false);
   void createCACH(uint8_t txSlotIndex, uint8_t rxSlotIndex);
-  void writeByte(uint8_t c, uint8_t control);
+  uint8_t getFrames() const;
+  void encodeCACH(const uint8_t* shortLC, uint8_t set);
 };
 
 #endif
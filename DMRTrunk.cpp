@@ -0,0 +1,261 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "Config.h"
+
+#if defined(DUPLEX)
+
+#include "Globals.h"
+#include "DMRTrunk.h"
+
+// Longest wait for the first sync on a granted channel, 500 ms
+const uint32_t TRUNK_ACQUIRE_TIME = 9600U;
+
+// Longest wait for the granted call to start after the retune, 1 s
+const uint32_t TRUNK_START_TIME   = 19200U;
+
+// A grant for the call that has just ended is the control channel still
+// repeating it for late entry, for up to 1 s
+const uint32_t TRUNK_REPEAT_TIME  = 19200U;
+
+CDMRTrunk::CDMRTrunk() :
+m_state(DMRTS_OFF),
+m_channels(),
+m_count(0U),
+m_pos(0U),
+m_slot(0U),
+m_granted(false),
+m_grantPos(0U),
+m_grantSlot(0U),
+m_srcId(0U),
+m_dstId(0U),
+m_ended(false),
+m_endTime(0U),
+m_callSeen(false),
+m_retuneTime(0U),
+m_grants(0U),
+m_followed(0U),
+m_missed(0U),
+m_unknown(0U),
+m_latencyLast(0U),
+m_latencyMin(0U),
+m_latencyMax(0U),
+m_latencyCount(0U),
+m_latencySum(0U)
+{
+}
+
+void CDMRTrunk::setPlan(const uint16_t* channels, uint8_t count)
+{
+  if (count > DMR_TRUNK_MAX_CHANNELS)
+    count = DMR_TRUNK_MAX_CHANNELS;
+
+  for (uint8_t i = 0U; i < count; i++)
+    m_channels[i] = channels[i];
+
+  m_count    = count;
+  m_pos      = 0U;
+  m_granted  = false;
+  m_ended    = false;
+  m_state    = (count > 0U) ? DMRTS_CONTROL : DMRTS_OFF;
+
+  DEBUG2("DMRTrunk: channels", count);
+}
+
+void CDMRTrunk::grant(const DMRCSBK_T& csbk)
+{
+  if (m_state != DMRTS_CONTROL || csbk.csbkClass != DMRCC_GRANT)
+    return;
+
+  m_grants++;
+
+  if (!dmrFilter.check(csbk.srcId, csbk.dstId))
+    return;
+
+  if (m_ended && csbk.srcId == m_srcId && csbk.dstId == m_dstId && (io.getTicks() - m_endTime) < TRUNK_REPEAT_TIME)
+    return;
+
+  for (uint8_t i = 0U; i < m_count; i++) {
+    if (m_channels[i] == csbk.channel) {
+      // Tuned to from the scheduler, not from inside the receiver
+      m_granted   = true;
+      m_grantPos  = i;
+      m_grantSlot = csbk.slot;
+      m_srcId     = csbk.srcId;
+      m_dstId     = csbk.dstId;
+      m_ended     = false;
+      return;
+    }
+  }
+
+  m_unknown++;
+  DEBUG2("DMRTrunk: grant to an unknown channel", csbk.channel);
+}
+
+void CDMRTrunk::clock()
+{
+  switch (m_state) {
+    case DMRTS_CONTROL:
+      if (!m_granted)
+        break;
+      m_granted = false;
+      m_slot    = m_grantSlot;
+      retune(m_grantPos);
+      if (m_state == DMRTS_OFF)
+        break;
+      m_state = DMRTS_ACQUIRE;
+      DEBUG3("DMRTrunk: following channel/slot", m_channels[m_pos], m_slot + 1U);
+      break;
+
+    case DMRTS_ACQUIRE:
+      // Bits from before the retune were dropped, so any sync time after it
+      // is from the granted channel
+      for (uint8_t i = 0U; i < 2U; i++) {
+        uint32_t syncTime = dmrRX.getSyncTime(i);
+        if (int32_t(syncTime - m_retuneTime) >= 0) {
+          addLatency(syncTime - m_retuneTime);
+          m_state = DMRTS_FOLLOW;
+          return;
+        }
+      }
+
+      if ((io.getTicks() - m_retuneTime) >= TRUNK_ACQUIRE_TIME) {
+        DEBUG2("DMRTrunk: no sync on channel", m_channels[m_pos]);
+        m_missed++;
+        retune(0U);
+        if (m_state != DMRTS_OFF)
+          m_state = DMRTS_CONTROL;
+      }
+      break;
+
+    case DMRTS_FOLLOW:
+      // The terminator, or the flywheel giving up after a sync loss, ends
+      // the call
+      if (dmrRX.hasCall(m_slot)) {
+        m_callSeen = true;
+      } else if (m_callSeen || (io.getTicks() - m_retuneTime) >= TRUNK_START_TIME) {
+        if (m_callSeen) {
+          m_followed++;
+          m_ended   = true;
+          m_endTime = io.getTicks();
+        } else {
+          m_missed++;
+        }
+        DEBUG2("DMRTrunk: back to the control channel", m_callSeen ? 1 : 0);
+        retune(0U);
+        if (m_state != DMRTS_OFF)
+          m_state = DMRTS_CONTROL;
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+bool CDMRTrunk::isEnabled() const
+{
+  return m_state != DMRTS_OFF;
+}
+
+uint8_t CDMRTrunk::read(uint8_t* data, uint8_t length) const
+{
+  if (length < DMR_TRUNK_STATUS_LENGTH)
+    return 0U;
+
+  uint16_t channel = (m_count > 0U) ? m_channels[m_pos] : 0U;
+  uint16_t mean    = (m_latencyCount > 0U) ? uint16_t(m_latencySum / m_latencyCount) : 0U;
+
+  data[0U]  = m_state;
+  data[1U]  = (channel >> 8) & 0xFFU;
+  data[2U]  = (channel >> 0) & 0xFFU;
+  data[3U]  = m_slot;
+  data[4U]  = (m_grants >> 8) & 0xFFU;
+  data[5U]  = (m_grants >> 0) & 0xFFU;
+  data[6U]  = (m_followed >> 8) & 0xFFU;
+  data[7U]  = (m_followed >> 0) & 0xFFU;
+  data[8U]  = (m_missed >> 8) & 0xFFU;
+  data[9U]  = (m_missed >> 0) & 0xFFU;
+  data[10U] = (m_unknown >> 8) & 0xFFU;
+  data[11U] = (m_unknown >> 0) & 0xFFU;
+  data[12U] = (m_latencyLast >> 8) & 0xFFU;
+  data[13U] = (m_latencyLast >> 0) & 0xFFU;
+  data[14U] = (m_latencyMin >> 8) & 0xFFU;
+  data[15U] = (m_latencyMin >> 0) & 0xFFU;
+  data[16U] = (m_latencyMax >> 8) & 0xFFU;
+  data[17U] = (m_latencyMax >> 0) & 0xFFU;
+  data[18U] = (mean >> 8) & 0xFFU;
+  data[19U] = (mean >> 0) & 0xFFU;
+
+  return DMR_TRUNK_STATUS_LENGTH;
+}
+
+void CDMRTrunk::reset()
+{
+  m_grants       = 0U;
+  m_followed     = 0U;
+  m_missed       = 0U;
+  m_unknown      = 0U;
+  m_latencyLast  = 0U;
+  m_latencyMin   = 0U;
+  m_latencyMax   = 0U;
+  m_latencyCount = 0U;
+  m_latencySum   = 0U;
+}
+
+void CDMRTrunk::retune(uint8_t pos)
+{
+  // A SET_FREQ to another band drops the plan
+  if (!io.tuneTrunk(pos)) {
+    m_count = 0U;
+    m_state = DMRTS_OFF;
+    return;
+  }
+
+  // Start the search for sync afresh, the new channel need not share the
+  // slot timing of the last
+  dmrRX.reset();
+
+  m_pos        = pos;
+  m_callSeen   = false;
+  m_retuneTime = io.getTicks();
+}
+
+void CDMRTrunk::addLatency(uint32_t ticks)
+{
+  uint16_t latency = (ticks > 0xFFFFU) ? 0xFFFFU : uint16_t(ticks);
+
+  if (m_latencyCount == 0U || latency < m_latencyMin)
+    m_latencyMin = latency;
+  if (latency > m_latencyMax)
+    m_latencyMax = latency;
+
+  m_latencyLast = latency;
+
+  // Stops before the mean can overflow
+  if (m_latencyCount < 0xFFFFU) {
+    m_latencyCount++;
+    m_latencySum += latency;
+  }
+
+  DEBUG2I("DMRTrunk: retune to sync (ticks)", latency);
+}
+
+#endif
+
@@ -0,0 +1,92 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(DMRTRUNK_H)
+#define  DMRTRUNK_H
+
+#include "DMRCSBK.h"
+
+#include <stdint.h>
+
+const uint8_t DMR_TRUNK_MAX_CHANNELS = 16U;
+
+// Bytes in the serial status reply
+const uint8_t DMR_TRUNK_STATUS_LENGTH = 20U;
+
+enum DMR_TRUNK_STATE : uint8_t {
+  DMRTS_OFF,
+  DMRTS_CONTROL,    // On the control channel, waiting for a grant
+  DMRTS_ACQUIRE,    // On the granted channel, waiting for its first sync
+  DMRTS_FOLLOW      // In the granted call
+};
+
+// Follows the calls a Tier III control channel grants onto its traffic
+// channels, with the main receiver
+class CDMRTrunk {
+public:
+  CDMRTrunk();
+
+  // The logical channel numbers of the channels CIO::setTrunk() loaded, the
+  // control channel first. A count of zero stops following.
+  void setPlan(const uint16_t* channels, uint8_t count);
+
+  // A grant heard on the control channel
+  void grant(const DMRCSBK_T& csbk);
+
+  // Retunes, from the scheduler
+  void clock();
+
+  bool isEnabled() const;
+
+  // Returns the number of bytes written
+  uint8_t read(uint8_t* data, uint8_t length) const;
+
+  void reset();
+
+private:
+  DMR_TRUNK_STATE m_state;
+  uint16_t        m_channels[DMR_TRUNK_MAX_CHANNELS];
+  uint8_t         m_count;
+  uint8_t         m_pos;
+  uint8_t         m_slot;
+  bool            m_granted;       // A grant not yet tuned to
+  uint8_t         m_grantPos;
+  uint8_t         m_grantSlot;
+  uint32_t        m_srcId;         // Of the call granted last
+  uint32_t        m_dstId;
+  bool            m_ended;         // That call ended at m_endTime
+  uint32_t        m_endTime;
+  bool            m_callSeen;
+  uint32_t        m_retuneTime;
+  uint16_t        m_grants;
+  uint16_t        m_followed;
+  uint16_t        m_missed;
+  uint16_t        m_unknown;
+  uint16_t        m_latencyLast;
+  uint16_t        m_latencyMin;
+  uint16_t        m_latencyMax;
+  uint16_t        m_latencyCount;
+  uint32_t        m_latencySum;
+
+  void retune(uint8_t pos);
+  void addLatency(uint32_t ticks);
+};
+
+#endif
+
@@ -1,6 +1,7 @@
 /*
  *   Copyright (C) 2009-2016,2020 by Jonathan Naylor G4KLX
  *   Copyright (C) 2016,2017,2018 by Andy Uribe CA6JAU
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
  *
  *   This program is free software; you can redistribute it and/or modify
  *   it under the terms of the GNU General Public License as published by
@@ -18,40 +19,61 @@
  */
 
 #include "Config.h"
+
+#if defined(MODE_DSTAR)
+
 #include "Globals.h"
 #include "DStarRX.h"
 #include "Utils.h"
 
 const unsigned int MAX_SYNC_BITS = 100U * DSTAR_DATA_LENGTH_BITS;
 
-// D-Star preamble sequence (only 32 bits of 101010...)
-const uint64_t PREAMBLE_MASK = 0x00000000FFFFFFFFU;
-const uint64_t PREAMBLE_DATA = 0x00000000AAAAAAAAU;
-const uint8_t  PREAMBLE_ERRS = 2U;
-
-// D-Star bit order version of 0x55 0x55 0x6E 0x0A
-const uint64_t FRAME_SYNC_DATA = 0x0000000000557650U;
-const uint64_t FRAME_SYNC_MASK = 0x0000000000FFFFFFU;
-const uint8_t  FRAME_SYNC_ERRS = 2U;
-
 // D-Star bit order version of 0x55 0x2D 0x16
 const uint64_t DATA_SYNC_DATA = 0x0000000000AAB468U;
 const uint64_t DATA_SYNC_MASK = 0x0000000000FFFFFFU;
 const uint8_t  DATA_SYNC_ERRS = 3U;
 
+enum {
+  NONE_PREAMBLE,
+  NONE_FRAME_SYNC,
+  NONE_DATA_SYNC
+};
+
+const BITHISTORY_PATTERN NONE_PATTERNS[] = {
+  // D-Star preamble sequence (only 32 bits of 101010...)
+  {0x00000000AAAAAAAAU, 0x00000000FFFFFFFFU, 2U},
+  // D-Star bit order version of 0x55 0x55 0x6E 0x0A
+  {0x0000000000557650U, 0x0000000000FFFFFFU, 2U},
+  // Exact matching of the data sync
+  {DATA_SYNC_DATA, DATA_SYNC_MASK, 0U}};
+
 // D-Star bit order version of 0x55 0x55 0xC8 0x7A
-const uint64_t END_SYNC_DATA = 0x0000AAAAAAAA135EU;
-const uint64_t END_SYNC_MASK = 0x0000FFFFFFFFFFFFU;
-const uint8_t  END_SYNC_ERRS = 1U;
+const BITHISTORY_PATTERN END_SYNC_PATTERN[] = {{0x0000AAAAAAAA135EU, 0x0000FFFFFFFFFFFFU, 1U}};
+
+const BITHISTORY_PATTERN DATA_SYNC_PATTERN[] = {{DATA_SYNC_DATA, DATA_SYNC_MASK, DATA_SYNC_ERRS}};
+
+// The data sync arriving one to three bits late
+const BITHISTORY_PATTERN LATE_SYNC_PATTERNS[] = {
+  {DATA_SYNC_DATA >> 1, DATA_SYNC_MASK >> 1, DATA_SYNC_ERRS},
+  {DATA_SYNC_DATA >> 2, DATA_SYNC_MASK >> 2, DATA_SYNC_ERRS},
+  {DATA_SYNC_DATA >> 3, DATA_SYNC_MASK >> 3, DATA_SYNC_ERRS}};
+
+// Header convolutional code, K=3 with 328 data bits and two flush bits
+const uint16_t VITERBI_STEPS = DSTAR_FEC_SECTION_LENGTH_BITS / 2U;
+
+// Survivors held before a traceback, the oldest VITERBI_BLOCK bits are
+// then final. The rest is more than five constraint lengths.
+const uint8_t VITERBI_WINDOW = 64U;
+const uint8_t VITERBI_BLOCK  = 32U;
+
+// Symbol sent when a state is entered from the predecessor with a zero oldest
+// bit, and the number of set bits in a two bit symbol
+const uint8_t VITERBI_OUTPUT[] = {0x00U, 0x03U, 0x02U, 0x01U};
+const uint8_t VITERBI_COST[]   = {0U, 1U, 1U, 2U};
 
-const uint8_t BIT_MASK_TABLE0[] = {0x7FU, 0xBFU, 0xDFU, 0xEFU, 0xF7U, 0xFBU, 0xFDU, 0xFEU};
-const uint8_t BIT_MASK_TABLE1[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
 const uint8_t BIT_MASK_TABLE2[] = {0xFEU, 0xFDU, 0xFBU, 0xF7U, 0xEFU, 0xDFU, 0xBFU, 0x7FU};
 const uint8_t BIT_MASK_TABLE3[] = {0x01U, 0x02U, 0x04U, 0x08U, 0x10U, 0x20U, 0x40U, 0x80U};
 
-#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE1[(i)&7]) : (p[(i)>>3] & BIT_MASK_TABLE0[(i)&7])
-#define READ_BIT1(p,i)    (p[(i)>>3] & BIT_MASK_TABLE1[(i)&7])
-
 #define WRITE_BIT2(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE3[(i)&7]) : (p[(i)>>3] & BIT_MASK_TABLE2[(i)&7])
 #define READ_BIT2(p,i)    (p[(i)>>3] & BIT_MASK_TABLE3[(i)&7])
 
@@ -238,33 +260,26 @@ const uint16_t CCITT_TABLE[] = {
 
 CDStarRX::CDStarRX() :
 m_rxState(DSRXS_NONE),
-m_patternBuffer(0x00U),
 m_rxBuffer(),
 m_rxBufferBits(0U),
-m_dataBits(0U),
-m_mar(0U),
-m_pathMetric(),
-m_pathMemory0(),
-m_pathMemory1(),
-m_pathMemory2(),
-m_pathMemory3(),
-m_fecOutput()
+m_dataBits(0U)
 {
 }
 
 void CDStarRX::reset()
 {
-  m_rxState       = DSRXS_NONE;
-  m_patternBuffer = 0x00U;
-  m_rxBufferBits  = 0U;
-  m_dataBits      = 0U;
+  m_rxState      = DSRXS_NONE;
+  m_rxBufferBits = 0U;
+  m_dataBits     = 0U;
 }
 
-void CDStarRX::databit(bool bit)
-{ 
+void CDStarRX::databit()
+{
+  bool bit = (bitHistory.getPattern() & 0x01U) == 0x01U;
+
   switch (m_rxState) {
     case DSRXS_NONE:
-      processNone(bit);
+      processNone();
       break;
     case DSRXS_HEADER:
       processHeader(bit);
@@ -277,14 +292,12 @@ void CDStarRX::databit(bool bit)
   }
 }
 
-void CDStarRX::processNone(bool bit)
+void CDStarRX::processNone()
 {
-  m_patternBuffer <<= 1;
-  if (bit)
-    m_patternBuffer |= 0x01U;
+  uint8_t match = bitHistory.match(NONE_PATTERNS, 3U);
 
   // Fuzzy matching of the preamble sync sequence
-  if (countBits64((m_patternBuffer & PREAMBLE_MASK) ^ PREAMBLE_DATA) <= PREAMBLE_ERRS) {
+  if (match == NONE_PREAMBLE) {
 
     // Extend scan period in D-Star, once preamble is detected
     m_modeTimerCnt = 0;
@@ -295,7 +308,7 @@ void CDStarRX::processNone(bool bit)
   }
 
   // Fuzzy matching of the frame sync sequence
-  if (countBits64((m_patternBuffer & FRAME_SYNC_MASK) ^ FRAME_SYNC_DATA) <= FRAME_SYNC_ERRS) {
+  if (match == NONE_FRAME_SYNC) {
     DEBUG1("DStarRX: found frame sync in None, fuzzy");
 
     ::memset(m_rxBuffer, 0x00U, DSTAR_FEC_SECTION_LENGTH_BYTES);
@@ -306,7 +319,7 @@ void CDStarRX::processNone(bool bit)
   }
 
   // Exact matching of the data sync bit sequence
-  if (countBits64((m_patternBuffer & DATA_SYNC_MASK) ^ DATA_SYNC_DATA) == 0U) {
+  if (match == NONE_DATA_SYNC) {
     DEBUG1("DStarRX: found data sync in None, exact");
 
     io.setDecode(true);
@@ -325,10 +338,6 @@ void CDStarRX::processNone(bool bit)
 
 void CDStarRX::processHeader(bool bit)
 {
-  m_patternBuffer <<= 1;
-  if (bit)
-    m_patternBuffer |= 0x01U;
-
   WRITE_BIT2(m_rxBuffer, m_rxBufferBits, bit);
 
   m_rxBufferBits++;
@@ -338,7 +347,7 @@ void CDStarRX::processHeader(bool bit)
   // A full FEC header
   if (m_rxBufferBits == DSTAR_FEC_SECTION_LENGTH_BITS) {
     // Process the scrambling, interleaving and FEC, then return if the chcksum was correct
-    unsigned char header[DSTAR_HEADER_LENGTH_BYTES];
+    unsigned char header[DSTAR_HEADER_LENGTH_BYTES + 2U];
     bool ok = rxHeader(m_rxBuffer, header);
     if (ok) {
       io.setDecode(true);
@@ -359,10 +368,6 @@ void CDStarRX::processHeader(bool bit)
 
 void CDStarRX::processData(bool bit)
 {
-  m_patternBuffer <<= 1;
-  if (bit)
-    m_patternBuffer |= 0x01U;
-
   WRITE_BIT2(m_rxBuffer, m_rxBufferBits, bit);
 
   m_rxBufferBits++;
@@ -370,7 +375,7 @@ void CDStarRX::processData(bool bit)
     reset();
 
   // Fuzzy matching of the end frame sequences
-  if (countBits64((m_patternBuffer & END_SYNC_MASK) ^ END_SYNC_DATA) <= END_SYNC_ERRS) {
+  if (bitHistory.match(END_SYNC_PATTERN, 1U) == 0U) {
     DEBUG1("DStarRX: Found end sync in Data");
     io.setDecode(false);
 
@@ -383,7 +388,7 @@ void CDStarRX::processData(bool bit)
   // Fuzzy matching of the data sync bit sequence
   bool syncSeen = false;
   if (m_rxBufferBits >= (DSTAR_DATA_LENGTH_BITS - 3U)) {
-    if (countBits64((m_patternBuffer & DATA_SYNC_MASK) ^ DATA_SYNC_DATA) <= DATA_SYNC_ERRS) {
+    if (bitHistory.match(DATA_SYNC_PATTERN, 1U) == 0U) {
       m_rxBufferBits = DSTAR_DATA_LENGTH_BITS;
       m_dataBits     = MAX_SYNC_BITS;
       syncSeen       = true;
@@ -392,14 +397,9 @@ void CDStarRX::processData(bool bit)
 
   // Check to see if the sync is arriving late
   if (m_rxBufferBits == DSTAR_DATA_LENGTH_BITS && !syncSeen) {
-    for (uint8_t i = 1U; i <= 3U; i++) {
-      uint64_t syncMask = DATA_SYNC_MASK >> i;
-      uint64_t syncData = DATA_SYNC_DATA >> i;
-      if (countBits64((m_patternBuffer & syncMask) ^ syncData) <= DATA_SYNC_ERRS) {
-        m_rxBufferBits -= i;
-        break;
-      }
-    }
+    uint8_t late = bitHistory.match(LATE_SYNC_PATTERNS, 3U);
+    if (late < 3U)
+      m_rxBufferBits -= late + 1U;
   }
 
   m_dataBits--;
@@ -485,151 +485,92 @@ bool CDStarRX::rxHeader(uint8_t* in, uint8_t* out)
     }
   }
 
-  for (i = 0; i < 4; i++)
-    m_pathMetric[i] = 0;
+  viterbiDecode(intermediate, out);
 
-  int decodeData[2U];
+  return checksum(out);
+}
 
-  m_mar = 0U;
-  for (i = 0; i < 660; i += 2) {
-    if (intermediate[i >> 3] & (0x80U >> (i & 7)))
-      decodeData[1U] = 1U;
-    else
-      decodeData[1U] = 0U;
+// Hard decision Viterbi for G1 = 1 + D + D^2, G2 = 1 + D^2. The state is
+// the last two input bits, newest in bit 0. Path metrics stay within a few
+// bits of each other so they are kept in bytes and rebased every step.
+// Survivors take one bit per state, two steps to a byte, and are traced
+// back every VITERBI_BLOCK steps so only VITERBI_WINDOW steps are held.
+void CDStarRX::viterbiDecode(const uint8_t* in, uint8_t* out) const
+{
+  uint8_t metric[4U] = {0U, 8U, 8U, 8U};
+  uint8_t survivors[VITERBI_WINDOW / 2U];
 
-    if (intermediate[i >> 3] & (0x40U >> (i & 7)))
-      decodeData[0U] = 1U;
-    else
-      decodeData[0U] = 0U;
+  for (uint8_t i = 0U; i < DSTAR_HEADER_LENGTH_BYTES; i++)
+    out[i] = 0x00U;
 
-    viterbiDecode(decodeData);
-  }
+  uint16_t done = 0U;
+  uint8_t  pos  = 0U;
 
-  traceBack();
+  for (uint16_t n = 0U; n < VITERBI_STEPS; n++) {
+    // G1 then G2, MSB first
+    uint8_t symbol = (in[n >> 2] >> (6U - ((n & 0x03U) * 2U))) & 0x03U;
 
-  for (i = 0; i < int(DSTAR_HEADER_LENGTH_BYTES); i++)
-    out[i] = 0x00U;
+    uint8_t next[4U];
+    uint8_t decisions = 0x00U;
+    uint8_t min = 0xFFU;
 
-  unsigned int j = 0;
-  for (i = 329; i >= 0; i--) {
-    if (READ_BIT1(m_fecOutput, i))
-      out[j >> 3] |= (0x01U << (j & 7));
+    for (uint8_t s = 0U; s < 4U; s++) {
+      // The two previous states differ in the oldest bit, which both outputs
+      // use, so the second branch costs the complement of the first
+      uint8_t cost = VITERBI_COST[symbol ^ VITERBI_OUTPUT[s]];
+      uint8_t m0   = metric[s >> 1] + cost;
+      uint8_t m1   = metric[(s >> 1) | 0x02U] + (2U - cost);
 
-    j++;
-  }
+      if (m1 < m0) {
+        m0         = m1;
+        decisions |= 0x01U << s;
+      }
 
-  return checksum(out);
-}
+      next[s] = m0;
+      if (m0 < min)
+        min = m0;
+    }
 
-void CDStarRX::acs(int* metric)
-{
-  int tempMetric[4U];
-
-  unsigned int j = m_mar >> 3;
-  unsigned int k = m_mar & 7;
-
-  // Pres. state = S0, Prev. state = S0 & S2
-  int m1 = metric[0U] + m_pathMetric[0U];
-  int m2 = metric[4U] + m_pathMetric[2U];
-  tempMetric[0U] = m1 < m2 ? m1 : m2;
-  if (m1 < m2)
-    m_pathMemory0[j] &= BIT_MASK_TABLE0[k];
-  else
-    m_pathMemory0[j] |= BIT_MASK_TABLE1[k];
-
-  // Pres. state = S1, Prev. state = S0 & S2
-  m1 = metric[1U] + m_pathMetric[0U];
-  m2 = metric[5U] + m_pathMetric[2U];
-  tempMetric[1U] = m1 < m2 ? m1 : m2;
-  if (m1 < m2)
-    m_pathMemory1[j] &= BIT_MASK_TABLE0[k];
-  else
-    m_pathMemory1[j] |= BIT_MASK_TABLE1[k];
-
-  // Pres. state = S2, Prev. state = S2 & S3
-  m1 = metric[2U] + m_pathMetric[1U];
-  m2 = metric[6U] + m_pathMetric[3U];
-  tempMetric[2U] = m1 < m2 ? m1 : m2;
-  if (m1 < m2)
-    m_pathMemory2[j] &= BIT_MASK_TABLE0[k];
-  else
-    m_pathMemory2[j] |= BIT_MASK_TABLE1[k];
-
-  // Pres. state = S3, Prev. state = S1 & S3
-  m1 = metric[3U] + m_pathMetric[1U];
-  m2 = metric[7U] + m_pathMetric[3U];
-  tempMetric[3U] = m1 < m2 ? m1 : m2;
-  if (m1 < m2)
-    m_pathMemory3[j] &= BIT_MASK_TABLE0[k];
-  else
-    m_pathMemory3[j] |= BIT_MASK_TABLE1[k];
-
-  for (unsigned int i = 0U; i < 4U; i++)
-    m_pathMetric[i] = tempMetric[i];
-
-  m_mar++;
-}
- 
-void CDStarRX::viterbiDecode(int* data)
-{
-  int metric[8U];
-  
-  metric[0] = (data[1] ^ 0) + (data[0] ^ 0);
-  metric[1] = (data[1] ^ 1) + (data[0] ^ 1);
-  metric[2] = (data[1] ^ 1) + (data[0] ^ 0);
-  metric[3] = (data[1] ^ 0) + (data[0] ^ 1);
-  metric[4] = (data[1] ^ 1) + (data[0] ^ 1);
-  metric[5] = (data[1] ^ 0) + (data[0] ^ 0);
-  metric[6] = (data[1] ^ 0) + (data[0] ^ 1);
-  metric[7] = (data[1] ^ 1) + (data[0] ^ 0);
-  
-  acs(metric);
-}
+    for (uint8_t s = 0U; s < 4U; s++)
+      metric[s] = next[s] - min;
 
-void CDStarRX::traceBack()
-{
-  // Start from the S0, t=31
-  unsigned int j = 0U;
-  unsigned int k = 0U;
-  for (int i = 329; i >= 0; i--) {
-    switch (j) {
-      case 0U: // if state = S0
-        if (!READ_BIT1(m_pathMemory0, i))
-          j = 0U;
-        else
-          j = 2U;
-        WRITE_BIT1(m_fecOutput, k, false);
-        k++;
-        break;
-
-
-      case 1U: // if state = S1
-        if (!READ_BIT1(m_pathMemory1, i))
-          j = 0U;
-        else
-          j = 2U;
-        WRITE_BIT1(m_fecOutput, k, true);
-        k++;
-        break;
-
-      case 2U: // if state = S1
-        if (!READ_BIT1(m_pathMemory2, i))
-          j = 1U;
-        else
-          j = 3U;
-        WRITE_BIT1(m_fecOutput, k, false);
-        k++;
-        break;
-
-      case 3U: // if state = S1
-        if (!READ_BIT1(m_pathMemory3, i))
-          j = 1U;
-        else
-          j = 3U;
-        WRITE_BIT1(m_fecOutput, k, true);
-        k++;
-        break;
+    if ((pos & 0x01U) == 0x00U)
+      survivors[pos >> 1] = decisions;
+    else
+      survivors[pos >> 1] |= decisions << 4;
+
+    pos++;
+    if (pos >= VITERBI_WINDOW)
+      pos = 0U;
+
+    bool last = n == (VITERBI_STEPS - 1U);
+    if ((n + 1U - done) < VITERBI_WINDOW && !last)
+      continue;
+
+    // The flush bits end the header in state zero, mid way the best state is as good
+    uint8_t state = 0U;
+    if (!last) {
+      for (uint8_t s = 1U; s < 4U; s++) {
+        if (metric[s] < metric[state])
+          state = s;
+      }
+    }
+
+    uint16_t keep = last ? n + 1U : done + VITERBI_BLOCK;
+
+    uint8_t p = pos;
+    for (uint16_t step = n + 1U; step > done; ) {
+      step--;
+      p = (p == 0U) ? VITERBI_WINDOW - 1U : p - 1U;
+
+      if (step < keep && step < DSTAR_HEADER_LENGTH_BITS && (state & 0x01U) == 0x01U)
+        out[step >> 3] |= 0x01U << (step & 7U);
+
+      uint8_t d = (survivors[p >> 1] >> ((p & 0x01U) * 4U + state)) & 0x01U;
+      state = (state >> 1) | (d << 1);
     }
+
+    done = keep;
   }
 }
 
@@ -676,3 +617,5 @@ void CDStarRX::writeRSSIData(unsigned char* data)
   serial.writeDStarData(data, DSTAR_DATA_LENGTH_BYTES + 0U);
 #endif
 }
+
+#endif
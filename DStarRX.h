@@ -1,6 +1,7 @@
 /*
  *   Copyright (C) 2015,2016,2020 by Jonathan Naylor G4KLX
  *   Copyright (C) 2016,2017 by Andy Uribe CA6JAU
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
  *
  *   This program is free software; you can redistribute it and/or modify
  *   it under the terms of the GNU General Public License as published by
@@ -34,31 +35,22 @@ class CDStarRX {
 public:
   CDStarRX();
 
-  void databit(bool bit);
+  // Processes the newest bit in the shared bit history
+  void databit();
 
   void reset();
 
 private:
   DSRX_STATE   m_rxState;
-  uint64_t     m_patternBuffer;
   uint8_t      m_rxBuffer[DSTAR_BUFFER_LENGTH_BITS / 8U];
   unsigned int m_rxBufferBits;
   unsigned int m_dataBits;
-  unsigned int m_mar;
-  int          m_pathMetric[4U];
-  unsigned int m_pathMemory0[42U];
-  unsigned int m_pathMemory1[42U];
-  unsigned int m_pathMemory2[42U];
-  unsigned int m_pathMemory3[42U];
-  uint8_t      m_fecOutput[42U];
 
-  void    processNone(bool bit);
+  void    processNone();
   void    processHeader(bool bit);
   void    processData(bool bit);
   bool    rxHeader(uint8_t* in, uint8_t* out);
-  void    acs(int* metric);
-  void    viterbiDecode(int* data);
-  void    traceBack();
+  void    viterbiDecode(const uint8_t* in, uint8_t* out) const;
   bool    checksum(const uint8_t* header) const;
   void    writeRSSIHeader(unsigned char* header);
   void    writeRSSIData(unsigned char* data);
@@ -102,13 +102,36 @@ extern CIO io;
 
 #include "IO.h"
 #include "SerialPort.h"
+#include "BitHistory.h"
 #include "DMRDMORX.h"
 #include "DMRDMOTX.h"
+#include "DMRFilter.h"
+#include "DMRLastHeard.h"
+#include "DMRLatency.h"
+#include "DMRTrunk.h"
+#include "DMRTX.h"
+#include "SyncRX.h"
+
+#if defined(MODE_YSF)
+#include "YSFRX.h"
+#endif
+#if defined(MODE_P25)
+#include "P25RX.h"
+#endif
+#if defined(MODE_NXDN)
+#include "NXDNRX.h"
+#endif
+#if defined(MODE_DSTAR)
+#include "DStarRX.h"
+#endif
+#if defined(MODE_M17)
+#include "M17RX.h"
+#endif
 
 #if defined(DUPLEX)
 #include "DMRIdleRX.h"
 #include "DMRRX.h"
-#include "DMRTX.h"
+#include "DMRDiversity.h"
 
 #ifndef HIGH
 #define HIGH 1U
@@ -124,6 +147,7 @@ extern CIO io;
 #include "Debug.h"
 #include "Utils.h"
 #include "I2CHost.h"
+#include "Scheduler.h"
 
 extern CSerialPort serial;
 
@@ -135,6 +159,30 @@ extern uint8_t m_control;
 extern CDMRIdleRX dmrIdleRX;
 extern CDMRRX dmrRX;
 extern CDMRTX dmrTX;
+extern CDMRFilter dmrFilter;
+extern CDMRLastHeard dmrLastHeard;
+extern CDMRLatency dmrLatency;
+extern CDMRTrunk dmrTrunk;
+#endif
+
+extern CBitHistory bitHistory;
+
+#if defined(DUAL_RX)
+extern CBitHistory bitHistory2;
+extern CDMRRX dmrRX2;
+extern CDMRDiversity dmrDiversity;
+#endif
+
+#if defined(SYNCRX_ENABLED)
+extern CSyncRX syncRX;
+#endif
+
+#if defined(MODE_DSTAR)
+extern CDStarRX dstarRX;
+#endif
+
+#if defined(MODE_M17)
+extern CM17RX m17RX;
 #endif
 
 extern CDMRDMORX dmrDMORX;
@@ -148,6 +196,8 @@ extern CCalRSSI calRSSI;
 
 extern CCWIdTX cwIdTX;
 
+extern CScheduler scheduler;
+
 #if defined(STM32_I2C_HOST)
 extern CI2CHost i2c;
 #endif
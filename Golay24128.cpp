@@ -0,0 +1,108 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "Config.h"
+
+#if defined(MODE_M17)
+
+#include "Globals.h"
+#include "Golay24128.h"
+
+const uint32_t GOLAY_POLY = 0xC75U;
+
+// Syndromes of single errors in the twelve data bits, the parity bits are their own syndrome
+const uint16_t DATA_SYNDROMES[] = {0x475U, 0x49FU, 0x54BU, 0x6E3U, 0x1B3U, 0x366U, 0x6CCU, 0x1EDU, 0x3DAU, 0x7B4U, 0x31DU, 0x63AU};
+
+uint16_t CGolay24128::syndrome(uint32_t code)
+{
+  for (uint8_t i = 22U; i >= 11U; i--) {
+    if ((code >> i) & 0x01U)
+      code ^= GOLAY_POLY << (i - 11U);
+  }
+
+  return code & 0x7FFU;
+}
+
+uint32_t CGolay24128::encode24128(uint16_t data)
+{
+  uint32_t code = uint32_t(data & 0xFFFU) << 11;
+  code |= syndrome(code);
+
+  return (code << 1) | (countBits32(code) & 0x01U);
+}
+
+bool CGolay24128::decode24128(uint32_t code, uint16_t& data, uint8_t& errs)
+{
+  uint32_t code23 = (code >> 1) & 0x7FFFFFU;
+  uint16_t s      = syndrome(code23);
+
+  // The (23,12) code is perfect, one pattern of at most three errors
+  // matches every syndrome. Walk the data bit errors by weight, whatever
+  // syndrome is left over has to be parity bit errors.
+  uint32_t error = 0xFFFFFFFFU;
+
+  if (countBits16(s) <= 3U) {
+    error = s;
+  } else {
+    for (uint8_t i = 0U; i < 12U && error == 0xFFFFFFFFU; i++) {
+      uint16_t si = s ^ DATA_SYNDROMES[i];
+      if (countBits16(si) <= 2U) {
+        error = (0x800U << i) | si;
+        break;
+      }
+
+      for (uint8_t j = i + 1U; j < 12U; j++) {
+        uint16_t sj = si ^ DATA_SYNDROMES[j];
+        if (countBits16(sj) <= 1U) {
+          error = (0x800U << i) | (0x800U << j) | sj;
+          break;
+        }
+
+        for (uint8_t k = j + 1U; k < 12U; k++) {
+          if (sj == DATA_SYNDROMES[k]) {
+            error = (0x800U << i) | (0x800U << j) | (0x800U << k);
+            break;
+          }
+        }
+
+        if (error != 0xFFFFFFFFU)
+          break;
+      }
+    }
+  }
+
+  if (error == 0xFFFFFFFFU)
+    return false;
+
+  code23 ^= error;
+  errs = countBits32(error);
+
+  // The overall parity bit catches a fourth error
+  if ((countBits32(code23) & 0x01U) != (code & 0x01U))
+    errs++;
+
+  if (errs > 3U)
+    return false;
+
+  data = (code23 >> 11) & 0xFFFU;
+
+  return true;
+}
+
+#endif
@@ -0,0 +1,39 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(GOLAY24128_H)
+#define  GOLAY24128_H
+
+#include <stdint.h>
+
+// Extended Golay(24,12) with the generator polynomial 0xC75, the data is in
+// the top 12 bits of the codeword
+class CGolay24128 {
+public:
+  static uint32_t encode24128(uint16_t data);
+
+  // Corrects up to three bit errors, returns false when the codeword is
+  // beyond that. errs is the number of bits corrected.
+  static bool decode24128(uint32_t code, uint16_t& data, uint8_t& errs);
+
+private:
+  static uint16_t syndrome(uint32_t code);
+};
+
+#endif
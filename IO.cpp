@@ -27,17 +27,51 @@ uint32_t    m_frequency_tx;
 uint32_t    m_pocsag_freq_tx;
 uint8_t     m_power;
 
+// Service LED timing in ticks, housekeeping() runs on a period rather than
+// on every pass of the main loop
+const uint32_t LED_BLINK_TICKS    = 9600U;     // Running, 1 Hz
+const uint32_t LED_IDLE_TICKS     = 96000U;    // Not started yet
+const uint32_t LED_DISCREET_TICKS = 192000U;   // One flash in this long
+const uint32_t LED_FLASH_TICKS    = 4000U;
+
 CIO::CIO():
 m_started(false),
 m_rxBuffer(1024U),
+#if defined(DUAL_RX)
+m_rxBuffer2(512U),
+m_dualRX(false),
+m_dualReg0(0U),
+m_dualReg1(0U),
+#endif
 m_txBuffer(1024U),
 m_LoDevYSF(false),
 m_ledCount(0U),
+m_ledTime(0U),
 m_scanEnable(false),
 m_scanPauseCnt(0U),
 m_scanPos(0U),
+m_chanReg0(),
+m_chanFreq(),
+m_chanReg1(0U),
+m_chanHome(0U),
+m_chanCount(0U),
+m_chanPos(0U),
+m_chanHold(false),
+m_chanDwell(0U),
+m_chanTimer(0U),
+m_tunePending(false),
+m_trunk(false),
 m_ledValue(true),
 m_watchdog(0U),
+m_ticks(0U),
+m_turnStart(0U),
+m_turnTX(0U),
+m_turnRX(0U),
+m_turnMaxTX(0U),
+m_turnMaxRX(0U),
+#if defined(SEND_RSSI_DATA)
+m_rssi(0U),
+#endif
 m_int1counter(0U),
 m_int2counter(0U),
 m_last_clk2(0U)
@@ -111,13 +145,13 @@ void CIO::selfTest()
   }
 }
 
-void CIO::process()
+void CIO::housekeeping()
 {
-  uint8_t bit;
   uint32_t scantime;
-  uint8_t  control;
 
-  m_ledCount++;
+  uint32_t now = m_ticks;
+  m_ledCount += now - m_ledTime;
+  m_ledTime   = now;
 
   if (m_started) {
     // Two seconds timeout
@@ -146,26 +180,26 @@ void CIO::process()
 #elif defined(CONSTANT_SRV_LED_INVERTED)
     LED_pin(LOW);
 #elif defined(DISCREET_SRV_LED)
-    if (m_ledCount == 10000U) LED_pin(LOW);
-    if (m_ledCount >= 480000U) {
+    if (m_ledCount >= LED_FLASH_TICKS) LED_pin(LOW);
+    if (m_ledCount >= LED_DISCREET_TICKS) {
       m_ledCount = 0U;
       LED_pin(HIGH);
     };
 #elif defined(DISCREET_SRV_LED_INVERTED)
-    if (m_ledCount == 10000U) LED_pin(HIGH);
-    if (m_ledCount >= 480000U) {
+    if (m_ledCount >= LED_FLASH_TICKS) LED_pin(HIGH);
+    if (m_ledCount >= LED_DISCREET_TICKS) {
       m_ledCount = 0U;
       LED_pin(LOW);
     };
 #else
-    if (m_ledCount >= 24000U) {
+    if (m_ledCount >= LED_BLINK_TICKS) {
       m_ledCount = 0U;
       m_ledValue = !m_ledValue;
       LED_pin(m_ledValue);
     }
 #endif
   } else {
-    if (m_ledCount >= 240000U) {
+    if (m_ledCount >= LED_IDLE_TICKS) {
       m_ledCount = 0U;
       m_ledValue = !m_ledValue;
       LED_pin(m_ledValue);
@@ -173,23 +207,6 @@ void CIO::process()
     return;
   }
 
-  // Switch off the transmitter if needed
-  if (m_txBuffer.getData() == 0U && m_tx) {
-    if(m_cwid_state) { // check for CW ID end of transmission
-      m_cwid_state = false;
-      // Restoring previous mode
-      if (m_TotalModes)
-        io.ifConf(m_modemState_prev, true);
-    }
-    if(m_pocsag_state) { // check for POCSAG end of transmission
-      m_pocsag_state = false;
-      // Restoring previous mode
-      if (m_TotalModes)
-        io.ifConf(m_modemState_prev, true);
-    }
-    setRX(false);
-  }
-
   if(m_modemState_prev == STATE_DSTAR)
     scantime = SCAN_TIME;
   else if(m_modemState_prev == STATE_DMR)
@@ -218,37 +235,169 @@ void CIO::process()
 #endif
   }
 
+  scanChannels();
+
+  // Keep and report each new worst case TX/RX turnaround
+  if (m_turnTX > m_turnMaxTX || m_turnRX > m_turnMaxRX) {
+    if (m_turnTX > m_turnMaxTX)
+      m_turnMaxTX = m_turnTX;
+    if (m_turnRX > m_turnMaxRX)
+      m_turnMaxRX = m_turnRX;
+    DEBUG3("IO: turnaround to TX/to RX (ticks)", m_turnTX, m_turnRX);
+  }
+}
+
+void CIO::scanChannels()
+{
+  if (m_trunk || m_chanCount < 2U || m_tx || m_modemState != STATE_DMR)
+    return;
+
+  uint32_t now = m_ticks;
+
+  // Stay on the channel for the whole call, sync loss or a terminator drops
+  // the DCD, and then for one more dwell in case the channel keys up again
+  bool busy = m_dcd;
+#if defined(DUPLEX) && defined(MS_MODE)
+  // An idle BS keeps the sync locked and the DCD up, so hold on a call in
+  // progress, or on a site that reports activity in its Short LC, instead
+  busy = dmrRX.isActive(0U) || dmrRX.isActive(1U) || dmrRX.getShortLC().isBusy();
+#endif
+
+  if (busy) {
+    if (!m_chanHold) {
+      m_chanHold = true;
+      DEBUG2I("IO: channel scan holding on", m_chanFreq[m_chanPos]);
+    }
+
+    m_chanTimer = now;
+    return;
+  }
+
+  if ((now - m_chanTimer) < m_chanDwell)
+    return;
+
+  m_chanHold  = false;
+  m_chanTimer = now;
+
+  tuneChannel((m_chanPos + 1U) % m_chanCount);
+}
+
+bool CIO::tuneTrunk(uint8_t pos)
+{
+  if (!m_trunk || pos >= m_chanCount)
+    return false;
+
+  tuneChannel(pos);
+  if (m_chanCount == 0U) {
+    m_trunk = false;
+    return false;
+  }
+
+  // Bits of the last channel would only hold up the sync search on this one
+  uint8_t bit, control;
+  while (m_rxBuffer.getData() > 0U)
+    m_rxBuffer.get(bit, control);
+
+  return true;
+}
+
+void CIO::process()
+{
+  uint8_t bit;
+  uint8_t control;
+
+  if (!m_started)
+    return;
+
+  // Switch off the transmitter if needed
+  if (m_txBuffer.getData() == 0U && m_tx && !isSwitching()) {
+    if(m_cwid_state) { // check for CW ID end of transmission
+      m_cwid_state = false;
+      // Restoring previous mode
+      if (m_TotalModes)
+        io.ifConf(m_modemState_prev, true);
+    }
+    if(m_pocsag_state) { // check for POCSAG end of transmission
+      m_pocsag_state = false;
+      // Restoring previous mode
+      if (m_TotalModes)
+        io.ifConf(m_modemState_prev, true);
+    }
+    setRX(false);
+  }
+
+  // Data written while the transmitter was still switching off
+  if (m_txBuffer.getData() > 0U && !m_tx && !isSwitching())
+    setTX();
+
+  // A retune held back while the switch had the bus
+  if (m_tunePending && !isSwitching())
+    tuneRX();
+
   if (m_rxBuffer.getData() >= 1U) {
     m_rxBuffer.get(bit, control);
 
+    // Recorded once, the receivers read it back from the history
+    bitHistory.add(bit != 0U);
+
     switch (m_modemState_prev) {
       
       case STATE_DMR:
 #if defined(DUPLEX)
         if (m_duplex) {
 #if defined(MS_MODE)
-          dmrRX.databit(bit, control);
+          dmrRX.databit(control);
 #else
           if (m_tx)
-            dmrRX.databit(bit, control);
+            dmrRX.databit(control);
           else
-            dmrIdleRX.databit(bit);
+            dmrIdleRX.databit();
 #endif
         } else
-          dmrDMORX.databit(bit);
+          dmrDMORX.databit();
 #else
-        dmrDMORX.databit(bit);
+        dmrDMORX.databit();
+#endif
+        break;
+
+#if defined(MODE_DSTAR)
+      case STATE_DSTAR:
+        dstarRX.databit();
+        break;
 #endif
+
+#if defined(SYNCRX_ENABLED)
+      case STATE_YSF:
+      case STATE_P25:
+      case STATE_NXDN:
+        syncRX.databit();
         break;
+#endif
    
+#if defined(MODE_M17)
       case STATE_M17:
-        //m17RX.databit(bit);
+        m17RX.databit();
         break;
+#endif
       default:
         break;
     }
 
   }
+
+#if defined(DUAL_RX)
+  // The second downlink is always DMR, it only runs while DMR is
+  if (m_rxBuffer2.getData() >= 1U) {
+    m_rxBuffer2.get(bit, control);
+
+    bitHistory2.add(bit != 0U);
+
+    if (m_modemState_prev == STATE_DMR)
+      dmrRX2.databit(control);
+  }
+
+  dmrDiversity.clock();
+#endif
 }
 
 void CIO::start()
@@ -312,11 +461,21 @@ void CIO::write(uint8_t* data, uint16_t length, const uint8_t* control)
       m_txBuffer.put(data[i], control[i]);
   }
 
-  // Switch the transmitter on if needed
-  if (!m_tx) {
+  // Switch the transmitter on if needed, process() does it once a pending
+  // switch to RX is over
+  if (!m_tx && !isSwitching())
+    setTX();
+}
+
+void CIO::writeBytes(const uint8_t* data, uint16_t length)
+{
+  if (!m_started)
+    return;
+
+  m_txBuffer.putBytes(data, length);
+
+  if (!m_tx && !isSwitching())
     setTX();
-    m_tx = true;
-  }
 }
 
 uint16_t CIO::getSpace() const
@@ -324,6 +483,24 @@ uint16_t CIO::getSpace() const
   return m_txBuffer.getSpace();
 }
 
+uint16_t CIO::getTXData() const
+{
+  return m_txBuffer.getData();
+}
+
+uint16_t CIO::getRXData() const
+{
+#if defined(DUAL_RX)
+  // The larger backlog, process() drains both rings a bit at a time
+  uint16_t data  = m_rxBuffer.getData();
+  uint16_t data2 = m_rxBuffer2.getData();
+
+  return (data2 > data) ? data2 : data;
+#else
+  return m_rxBuffer.getData();
+#endif
+}
+
 bool CIO::hasTXOverflow()
 {
   return m_txBuffer.hasOverflowed();
@@ -331,7 +508,13 @@ bool CIO::hasTXOverflow()
 
 bool CIO::hasRXOverflow()
 {
+#if defined(DUAL_RX)
+  bool overflow = m_rxBuffer.hasOverflowed();
+
+  return m_rxBuffer2.hasOverflowed() || overflow;
+#else
   return m_rxBuffer.hasOverflowed();
+#endif
 }
 
 #if defined(ZUMSPOT_ADF7021) || defined(LONESTAR_USB) || defined(SKYBRIDGE_HS)
@@ -515,6 +698,47 @@ uint32_t CIO::getWatchdog()
   return m_watchdog;
 }
 
+uint32_t CIO::getTicks() const
+{
+  return m_ticks;
+}
+
+uint32_t CIO::getRXTime(uint8_t receiver) const
+{
+#if defined(DUAL_RX)
+  if (receiver == 1U)
+    return m_ticks - 2U * m_rxBuffer2.getData();
+#else
+  (void)receiver;
+#endif
+
+  // Two ticks per bit, the clock interrupts on both edges
+  return m_ticks - 2U * m_rxBuffer.getData();
+}
+
+uint8_t CIO::readStatus(uint8_t* data, uint8_t length) const
+{
+  if (length < IO_STATUS_LENGTH)
+    return 0U;
+
+  data[0U] = (m_turnTX >> 8) & 0xFFU;
+  data[1U] = (m_turnTX >> 0) & 0xFFU;
+  data[2U] = (m_turnMaxTX >> 8) & 0xFFU;
+  data[3U] = (m_turnMaxTX >> 0) & 0xFFU;
+  data[4U] = (m_turnRX >> 8) & 0xFFU;
+  data[5U] = (m_turnRX >> 0) & 0xFFU;
+  data[6U] = (m_turnMaxRX >> 8) & 0xFFU;
+  data[7U] = (m_turnMaxRX >> 0) & 0xFFU;
+
+  return IO_STATUS_LENGTH;
+}
+
+void CIO::resetStatus()
+{
+  m_turnMaxTX = m_turnTX;
+  m_turnMaxRX = m_turnRX;
+}
+
 void CIO::getIntCounter(uint16_t &int1, uint16_t &int2)
 {
   int1 = m_int1counter;
@@ -528,4 +752,7 @@ extern CIO io;
 uint32_t get_watchdog_count() {
   return io.getWatchdog();
 }
+uint32_t get_tick_count() {
+  return io.getTicks();
+}
 #endif
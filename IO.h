@@ -44,6 +44,20 @@
 #define SCAN_TIME  1920
 #define SCAN_PAUSE 20000
 
+// Bytes of the IO status reply
+const uint8_t IO_STATUS_LENGTH = 8U;
+
+// Bytes of the register shadow counters in the IO status reply
+const uint8_t SHADOW_STATUS_LENGTH = 6U;
+
+// Channel scan, dwell in ms
+#define SCAN_MAX_CHANNELS 16U
+#define SCAN_MIN_DWELL    100U
+
+#if defined(DUAL_RX) && !(defined(DUPLEX) && defined(MS_MODE))
+#error "DUAL_RX needs DUPLEX and MS_MODE"
+#endif
+
 #if defined(DUPLEX)
 #if defined(STM32_USB_HOST)
 #define CAL_DLY_LOOP 98950U
@@ -110,17 +124,35 @@ public:
 
   // IO API
   void      write(uint8_t* data, uint16_t length, const uint8_t* control = NULL);
+  // As write(), for packed bytes sent MSB first
+  void      writeBytes(const uint8_t* data, uint16_t length);
   uint16_t  getSpace(void) const;
+  uint16_t  getTXData(void) const;
   void      process(void);
+  void      housekeeping(void);
+  uint16_t  getRXData(void) const;
   bool      hasTXOverflow(void);
   bool      hasRXOverflow(void);
   uint8_t   setFreq(uint32_t frequency_rx, uint32_t frequency_tx, uint8_t rf_power, uint32_t pocsag_freq_tx);
+  uint8_t   setChannels(const uint32_t* frequencies, uint8_t count, uint16_t dwell);
+  // Trunk plan, the control channel first, the scan stops while it is set
+  uint8_t   setTrunk(const uint32_t* frequencies, uint8_t count);
+  // Retunes to a channel of the trunk plan and drops the bits still queued
+  // from the last one, returns false once the plan has been dropped
+  bool      tuneTrunk(uint8_t pos);
+#if defined(DUAL_RX)
+  // Second DMR downlink for the first ADF7021, zero stops it
+  uint8_t   setDualRX(uint32_t frequency);
+#endif
   void      setPower(uint8_t power);
   void      setMode(MMDVM_STATE modemState);
   void      setDecode(bool dcd);
   void      setLoDevYSF(bool ysfLoDev);
   void      resetWatchdog(void);
   uint32_t  getWatchdog(void);
+  uint32_t  getTicks(void) const;
+  // Tick the next RX bit handed out by process() was received on
+  uint32_t  getRXTime(uint8_t receiver = 0U) const;
   void      getIntCounter(uint16_t &int1, uint16_t &int2);
   void      selfTest(void);
 #if defined(ZUMSPOT_ADF7021) || defined(LONESTAR_USB) || defined(SKYBRIDGE_HS)
@@ -131,9 +163,27 @@ public:
   bool      isDualBand(void);
 #endif
 
+  // Radio register bus API, chip 1 is the second ADF7021 in duplex
+  void      busWrite(uint32_t word, uint8_t bits);
+  void      busLatch(uint8_t chip);
+  uint16_t  busReadback(uint8_t chip, uint16_t word);
+
   // RF interface API
   void      setTX(void);
   void      setRX(bool doSle = true);
+  bool      isSwitching(void) const;
+  // Ticks from the last setTX() and setRX(false) to the interrupt latching
+  // the new REG0
+  void      getTurnaround(uint16_t& toTX, uint16_t& toRX) const;
+
+  // The last and the worst turnaround to TX and to RX, IO_STATUS_LENGTH
+  // bytes, returns the number written
+  uint8_t   readStatus(uint8_t* data, uint8_t length) const;
+  void      resetStatus(void);
+  // The register writes and chip resets the shadow skipped, and the bus
+  // time that saved in ms, SHADOW_STATUS_LENGTH bytes
+  uint8_t   readShadowStatus(uint8_t* data, uint8_t length) const;
+  void      resetShadowStatus(void);
   void      ifConf(MMDVM_STATE modemState, bool reset);
 #if defined(DUPLEX)
   void      ifConf2(MMDVM_STATE modemState);
@@ -174,19 +224,52 @@ private:
 
   bool               m_started;
   CBitRB             m_rxBuffer;
+#if defined(DUAL_RX)
+  CBitRB             m_rxBuffer2;
+  bool               m_dualRX;
+  uint32_t           m_dualReg0;
+  uint32_t           m_dualReg1;
+#endif
   CBitRB             m_txBuffer;
   bool               m_LoDevYSF;
   uint32_t           m_ledCount;
+  uint32_t           m_ledTime;
   bool               m_scanEnable;
   uint32_t           m_scanPauseCnt;
   uint8_t            m_scanPos;
   uint8_t            m_TotalModes;
   MMDVM_STATE        m_Modes[6];
+  uint32_t           m_chanReg0[SCAN_MAX_CHANNELS];
+  uint32_t           m_chanFreq[SCAN_MAX_CHANNELS];
+  uint32_t           m_chanReg1;
+  uint32_t           m_chanHome;
+  uint8_t            m_chanCount;
+  uint8_t            m_chanPos;
+  bool               m_chanHold;
+  uint32_t           m_chanDwell;
+  uint32_t           m_chanTimer;
+  bool               m_tunePending;
+  bool               m_trunk;
   bool               m_ledValue;
   volatile uint32_t  m_watchdog;
+  volatile uint32_t  m_ticks;
+  uint32_t           m_turnStart;
+  volatile uint16_t  m_turnTX;
+  volatile uint16_t  m_turnRX;
+  uint16_t           m_turnMaxTX;
+  uint16_t           m_turnMaxRX;
+#if defined(SEND_RSSI_DATA)
+  uint16_t           m_rssi;
+#endif
   volatile uint16_t  m_int1counter;
   volatile uint16_t  m_int2counter;
   uint8_t            m_last_clk2;
+
+  void      scanChannels(void);
+  void      tuneChannel(uint8_t pos);
+  void      tuneRX(void);
+  void      waitSwitch(void);
+  bool      loadChannels(const uint32_t* frequencies, uint8_t count);
 };
 
 #endif
@@ -354,6 +354,75 @@ void CIO::COS_pin(bool on)
   digitalWrite(PIN_COS_LED, on ? HIGH : LOW);
 }
 
+#if defined (__STM32F1__)
+// Straight to the port, digitalWrite() checks and looks up the pin on every call
+#define BUS_WRITE(pin, on)  gpio_write_bit(PIN_MAP[pin].gpio_device, PIN_MAP[pin].gpio_bit, (on) ? 1U : 0U)
+#define BUS_READ(pin)       (gpio_read_bit(PIN_MAP[pin].gpio_device, PIN_MAP[pin].gpio_bit) != 0U)
+#else
+#define BUS_WRITE(pin, on)  digitalWrite(pin, (on) ? HIGH : LOW)
+#define BUS_READ(pin)       (digitalRead(pin) == HIGH)
+#endif
+
+static void busSLE(uint8_t chip, bool on)
+{
+#if defined(DUPLEX)
+  if (chip == 1U) {
+    BUS_WRITE(PIN_SLE2, on);
+    return;
+  }
+#endif
+  BUS_WRITE(PIN_SLE, on);
+}
+
+void CIO::busWrite(uint32_t word, uint8_t bits)
+{
+  for (int8_t n = bits - 1; n >= 0; n--) {
+    BUS_WRITE(PIN_SDATA, bitRead(word, n) == HIGH);
+
+    dlybit();
+    BUS_WRITE(PIN_SCLK, true);
+    dlybit();
+    BUS_WRITE(PIN_SCLK, false);
+  }
+
+  // to keep SDATA signal at defined level when idle (not required)
+  BUS_WRITE(PIN_SDATA, false);
+}
+
+void CIO::busLatch(uint8_t chip)
+{
+  busSLE(chip, true);
+  dlybit();
+  busSLE(chip, false);
+}
+
+uint16_t CIO::busReadback(uint8_t chip, uint16_t word)
+{
+  uint16_t value = 0U;
+
+  // Readback register, 9 bits
+  busWrite(word, 9U);
+
+  busSLE(chip, true);
+  dlybit();
+
+  // One clock before and after the 16 data bits
+  for (int8_t n = 17; n >= 0; n--) {
+    BUS_WRITE(PIN_SCLK, true);
+    dlybit();
+
+    if ((n != 17) && (n != 0))
+      value |= (BUS_READ(PIN_SREAD) ? 1U : 0U) << (n - 1);
+
+    BUS_WRITE(PIN_SCLK, false);
+    dlybit();
+  }
+
+  busSLE(chip, false);
+
+  return value;
+}
+
 void CIO::delay_us(uint32_t us) {
   ::delayMicroseconds(us);
 }
@@ -0,0 +1,149 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "Config.h"
+
+#if defined(MODE_M17)
+
+#include "Globals.h"
+#include "M17Convolution.h"
+
+const uint8_t PUNCTURE_P1[] = {
+  1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U,
+  1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U};
+
+const uint8_t PUNCTURE_P2[] = {1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 0U};
+
+const uint16_t LINK_SETUP_BITS = 240U;
+const uint16_t DATA_BITS       = 144U;
+
+// Flushes the encoder back to state zero
+const uint16_t TAIL_BITS = 4U;
+
+const uint8_t BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
+
+#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
+#define READ_BIT1(p,i)    (p[(i)>>3] & BIT_MASK_TABLE[(i)&7])
+
+CM17Convolution::CM17Convolution() :
+m_decisions()
+{
+}
+
+uint16_t CM17Convolution::decodeLinkSetup(const uint8_t* in, uint8_t* out)
+{
+  return decode(in, PUNCTURE_P1, sizeof(PUNCTURE_P1), out, LINK_SETUP_BITS);
+}
+
+uint16_t CM17Convolution::decodeData(const uint8_t* in, uint8_t* out)
+{
+  return decode(in, PUNCTURE_P2, sizeof(PUNCTURE_P2), out, DATA_BITS);
+}
+
+// The state is the last four input bits, newest in bit 3. The encoder
+// outputs G1 = 1 + D^3 + D^4 and G2 = 1 + D + D^2 + D^4.
+uint16_t CM17Convolution::decode(const uint8_t* in, const uint8_t* puncture, uint8_t punctureLength, uint8_t* out, uint16_t outBits)
+{
+  uint16_t steps = outBits + TAIL_BITS;
+
+  uint16_t metrics[16U];
+  uint16_t next[16U];
+
+  // The encoder starts in state zero
+  metrics[0U] = 0U;
+  for (uint8_t s = 1U; s < 16U; s++)
+    metrics[s] = 0x7FFFU;
+
+  uint16_t inPtr = 0U;
+  uint8_t  punPtr = 0U;
+
+  for (uint16_t n = 0U; n < steps; n++) {
+    // A punctured bit is an erasure and costs nothing on either branch
+    int8_t r1 = -1;
+    if (puncture[punPtr] == 1U) {
+      r1 = READ_BIT1(in, inPtr) ? 1 : 0;
+      inPtr++;
+    }
+    punPtr++;
+    if (punPtr >= punctureLength)
+      punPtr = 0U;
+
+    int8_t r2 = -1;
+    if (puncture[punPtr] == 1U) {
+      r2 = READ_BIT1(in, inPtr) ? 1 : 0;
+      inPtr++;
+    }
+    punPtr++;
+    if (punPtr >= punctureLength)
+      punPtr = 0U;
+
+    uint16_t decisions = 0U;
+
+    for (uint8_t ns = 0U; ns < 16U; ns++) {
+      uint8_t bit = ns >> 3;
+
+      // The two states that lead here only differ in the bit shifted out
+      uint8_t  ps0 = (ns & 0x07U) << 1;
+      uint8_t  ps1 = ps0 | 0x01U;
+
+      uint8_t  g10 = bit ^ ((ps0 >> 1) & 0x01U) ^ (ps0 & 0x01U);
+      uint8_t  g20 = bit ^ ((ps0 >> 3) & 0x01U) ^ ((ps0 >> 2) & 0x01U) ^ (ps0 & 0x01U);
+
+      // Moving to ps1 flips the D^4 tap, which both outputs use
+      uint8_t  g11 = g10 ^ 0x01U;
+      uint8_t  g21 = g20 ^ 0x01U;
+
+      uint16_t m0 = metrics[ps0];
+      uint16_t m1 = metrics[ps1];
+      if (r1 >= 0) {
+        m0 += uint8_t(r1) ^ g10;
+        m1 += uint8_t(r1) ^ g11;
+      }
+      if (r2 >= 0) {
+        m0 += uint8_t(r2) ^ g20;
+        m1 += uint8_t(r2) ^ g21;
+      }
+
+      if (m1 < m0) {
+        next[ns] = m1;
+        decisions |= 0x01U << ns;
+      } else {
+        next[ns] = m0;
+      }
+    }
+
+    m_decisions[n] = decisions;
+    for (uint8_t s = 0U; s < 16U; s++)
+      metrics[s] = next[s];
+  }
+
+  // The flush bits bring the encoder back to state zero
+  uint8_t state = 0U;
+  for (uint16_t n = steps; n > 0U; n--) {
+    if ((n - 1U) < outBits)
+      WRITE_BIT1(out, n - 1U, state >> 3);
+
+    uint8_t b = (m_decisions[n - 1U] >> state) & 0x01U;
+    state = ((state & 0x07U) << 1) | b;
+  }
+
+  return metrics[0U];
+}
+
+#endif
@@ -0,0 +1,46 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(M17CONVOLUTION_H)
+#define  M17CONVOLUTION_H
+
+#include <stdint.h>
+
+// Link setup, 240 bits plus the four flush bits
+const uint16_t M17_CONV_MAX_STEPS = 244U;
+
+// Hard decision Viterbi decoder for the M17 K=5 rate 1/2 code. Only one
+// survivor bit per state is kept for each step, which is 16 bits a step.
+class CM17Convolution {
+public:
+  CM17Convolution();
+
+  // 368 punctured bits in, the 240 bit link setup frame out, returns the path metric
+  uint16_t decodeLinkSetup(const uint8_t* in, uint8_t* out);
+
+  // 272 punctured bits in, the frame number and 128 payload bits out, returns the path metric
+  uint16_t decodeData(const uint8_t* in, uint8_t* out);
+
+private:
+  uint16_t m_decisions[M17_CONV_MAX_STEPS];
+
+  uint16_t decode(const uint8_t* in, const uint8_t* puncture, uint8_t punctureLength, uint8_t* out, uint16_t outBits);
+};
+
+#endif
@@ -37,5 +37,24 @@ const uint16_t M17_LINK_SETUP_SYNC_BITS = 0x55F7U;
 const uint16_t M17_STREAM_SYNC_BITS     = 0xFF5DU;
 const uint16_t M17_EOT_SYNC_BITS        = 0x555DU;
 
+const unsigned int M17_PAYLOAD_LENGTH_BITS = M17_FRAME_LENGTH_BITS - M17_SYNC_LENGTH_BITS;
+
+const unsigned int M17_LSF_LENGTH_BYTES    = 30U;
+
+// Four Golay(24,12) codewords at the start of a stream frame
+const unsigned int M17_LICH_LENGTH_BITS    = 96U;
+const unsigned int M17_LICH_LENGTH_BYTES   = 6U;
+
+const unsigned int M17_FN_LENGTH_BYTES     = 2U;
+const unsigned int M17_PAYLOAD_LENGTH_BYTES = 16U;
+
+const uint16_t M17_FN_EOS = 0x8000U;
+
+// XORed over the interleaved payload of every frame
+const uint8_t M17_SCRAMBLER[] = {
+  0xD6U, 0xB5U, 0xE2U, 0x30U, 0x82U, 0xFFU, 0x84U, 0x62U, 0xBAU, 0x4EU, 0x96U, 0x90U, 0xD8U, 0x98U, 0xDDU, 0x5DU,
+  0x0CU, 0xC8U, 0x52U, 0x43U, 0x91U, 0x1DU, 0xF8U, 0x6EU, 0x68U, 0x2FU, 0x35U, 0xDAU, 0x14U, 0xEAU, 0xCDU, 0x76U,
+  0x19U, 0x8DU, 0xD5U, 0x80U, 0xD1U, 0x33U, 0x87U, 0x13U, 0x57U, 0x18U, 0x2DU, 0x29U, 0x78U, 0xC3U};
+
 #endif
 
@@ -0,0 +1,295 @@
+/*
+ *   Copyright (C) 2009-2018,2020,2021 by Jonathan Naylor G4KLX
+ *   Copyright (C) 2016,2017,2018 by Andy Uribe CA6JAU
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "Config.h"
+
+#if defined(MODE_M17)
+
+#include "Globals.h"
+#include "M17RX.h"
+#include "Golay24128.h"
+#include "Utils.h"
+
+const uint8_t MAX_SYNC_BIT_START_ERRS = 0U;
+const uint8_t MAX_SYNC_BIT_RUN_ERRS   = 2U;
+
+const unsigned int MAX_SYNC_FRAMES = 3U + 1U;
+
+// Above this a stream frame is taken as noise, its frame number is not trusted
+const uint16_t MAX_STREAM_PATH_METRIC = 16U;
+
+const uint16_t LSF_CRC_POLY = 0x5935U;
+
+const uint8_t BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
+
+#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
+#define READ_BIT1(p,i)    (p[(i)>>3] & BIT_MASK_TABLE[(i)&7])
+
+CM17RX::CM17RX() :
+m_state(M17RXS_NONE),
+m_confirmed(false),
+m_outBuffer(),
+m_buffer(NULL),
+m_bufferPtr(0U),
+m_lostCount(0U),
+m_convolution()
+{
+  m_buffer = m_outBuffer + 1U;
+}
+
+void CM17RX::reset()
+{
+  m_state     = M17RXS_NONE;
+  m_confirmed = false;
+  m_bufferPtr = 0U;
+  m_lostCount = 0U;
+}
+
+void CM17RX::databit()
+{
+  // The sync words are 16 bits, the bottom of the shared pattern
+  uint16_t pattern = uint16_t(bitHistory.getPattern());
+
+  if (m_state == M17RXS_NONE)
+    processNone(pattern);
+  else
+    processData((pattern & 0x01U) == 0x01U, pattern);
+}
+
+void CM17RX::processNone(uint16_t pattern)
+{
+  // Fuzzy matching of the link setup sync bit sequence
+  if (countBits16(pattern ^ M17_LINK_SETUP_SYNC_BITS) <= MAX_SYNC_BIT_START_ERRS) {
+    DEBUG1("M17RX: link setup sync found in None");
+    for (uint8_t i = 0U; i < M17_SYNC_LENGTH_BYTES; i++)
+      m_buffer[i] = M17_LINK_SETUP_SYNC_BYTES[i];
+
+    m_lostCount = MAX_SYNC_FRAMES;
+    m_bufferPtr = M17_SYNC_LENGTH_BITS;
+    m_state     = M17RXS_LINK_SETUP;
+  }
+
+  // Fuzzy matching of the stream sync bit sequence
+  if (countBits16(pattern ^ M17_STREAM_SYNC_BITS) <= MAX_SYNC_BIT_START_ERRS) {
+    DEBUG1("M17RX: stream sync found in None");
+    for (uint8_t i = 0U; i < M17_SYNC_LENGTH_BYTES; i++)
+      m_buffer[i] = M17_STREAM_SYNC_BYTES[i];
+
+    m_lostCount = MAX_SYNC_FRAMES;
+    m_bufferPtr = M17_SYNC_LENGTH_BITS;
+    m_state     = M17RXS_STREAM;
+  }
+}
+
+void CM17RX::processData(bool bit, uint16_t pattern)
+{
+  WRITE_BIT1(m_buffer, m_bufferPtr, bit);
+
+  m_bufferPtr++;
+  if (m_bufferPtr > M17_FRAME_LENGTH_BITS) {
+    reset();
+    return;
+  }
+
+  // Only search for a sync in the right place +-2 bits
+  if (m_bufferPtr >= (M17_SYNC_LENGTH_BITS - 2U) && m_bufferPtr <= (M17_SYNC_LENGTH_BITS + 2U)) {
+    // Fuzzy matching of the stream and EOT sync bit sequences
+    if (countBits16(pattern ^ M17_STREAM_SYNC_BITS) <= MAX_SYNC_BIT_RUN_ERRS) {
+      DEBUG2("M17RX: found stream sync, pos", m_bufferPtr - M17_SYNC_LENGTH_BITS);
+      m_lostCount = MAX_SYNC_FRAMES;
+      m_bufferPtr = M17_SYNC_LENGTH_BITS;
+      m_state     = M17RXS_STREAM;
+    } else if (countBits16(pattern ^ M17_EOT_SYNC_BITS) <= MAX_SYNC_BIT_RUN_ERRS) {
+      DEBUG2("M17RX: found EOT sync, pos", m_bufferPtr - M17_SYNC_LENGTH_BITS);
+      if (m_confirmed) {
+        io.setDecode(false);
+        serial.writeM17EOT();
+      }
+      reset();
+      return;
+    }
+  }
+
+  if (m_bufferPtr != M17_FRAME_LENGTH_BITS)
+    return;
+
+  bool     valid;
+  uint16_t fn = 0U;
+  if (m_state == M17RXS_LINK_SETUP)
+    valid = decodeLinkSetup();
+  else
+    valid = decodeStream(fn);
+
+  // A 16 bit sync is not enough on its own, the decode is not signalled
+  // until the first frame decodes cleanly
+  if (!m_confirmed) {
+    if (!valid) {
+      DEBUG1("M17RX: first frame did not decode, false sync");
+      reset();
+      return;
+    }
+
+    m_confirmed = true;
+    io.setDecode(true);
+  }
+
+  m_lostCount--;
+  // We've not seen a data sync for too long, signal RXLOST and change to RX_NONE
+  if (m_lostCount == 0U) {
+    DEBUG1("M17RX: sync timed out, lost lock");
+    io.setDecode(false);
+    serial.writeM17Lost();
+    reset();
+    return;
+  }
+
+  // Write data to host
+  m_outBuffer[0U] = m_lostCount == (MAX_SYNC_FRAMES - 1U) ? 0x01U : 0x00U;
+
+  if (m_state == M17RXS_LINK_SETUP) {
+    writeRSSILinkSetup(m_outBuffer);
+    m_state = M17RXS_STREAM;
+  } else {
+    writeRSSIStream(m_outBuffer);
+  }
+
+  // Start the next frame
+  ::memset(m_outBuffer, 0x00U, M17_FRAME_LENGTH_BYTES + 3U);
+  m_bufferPtr = 0U;
+
+  // The last stream frame says so, no need to wait for the EOT sync
+  if ((fn & M17_FN_EOS) == M17_FN_EOS) {
+    DEBUG2("M17RX: end of stream, fn", fn & 0x7FFFU);
+    io.setDecode(false);
+    serial.writeM17EOT();
+    reset();
+  }
+}
+
+// Undoes the scrambler and the QPP interleaver, pi(i) = (45i + 92i^2) mod 368.
+// The interleaver is its own inverse, the index is stepped along instead of
+// being kept in a table.
+void CM17RX::descramble(uint8_t* payload) const
+{
+  uint16_t pos  = 0U;
+  uint16_t step = 137U;
+
+  for (uint16_t i = 0U; i < M17_PAYLOAD_LENGTH_BITS; i++) {
+    bool b = READ_BIT1(m_buffer, M17_SYNC_LENGTH_BITS + pos) != 0U;
+    if (READ_BIT1(M17_SCRAMBLER, pos))
+      b = !b;
+
+    WRITE_BIT1(payload, i, b);
+
+    pos += step;
+    if (pos >= M17_PAYLOAD_LENGTH_BITS)
+      pos -= M17_PAYLOAD_LENGTH_BITS;
+
+    step += 184U;
+    if (step >= M17_PAYLOAD_LENGTH_BITS)
+      step -= M17_PAYLOAD_LENGTH_BITS;
+  }
+}
+
+bool CM17RX::decodeLinkSetup()
+{
+  uint8_t payload[M17_PAYLOAD_LENGTH_BITS / 8U];
+  descramble(payload);
+
+  uint8_t lsf[M17_LSF_LENGTH_BYTES];
+  uint16_t metric = m_convolution.decodeLinkSetup(payload, lsf);
+
+  // CRC-16, polynomial 0x5935, over the whole frame including the CRC leaves zero
+  uint16_t crc = 0xFFFFU;
+  for (uint8_t i = 0U; i < M17_LSF_LENGTH_BYTES; i++) {
+    crc ^= uint16_t(lsf[i]) << 8;
+    for (uint8_t j = 0U; j < 8U; j++)
+      crc = (crc & 0x8000U) ? (crc << 1) ^ LSF_CRC_POLY : (crc << 1);
+  }
+
+  DEBUG3("M17RX: link setup, path metric/CRC", metric, crc == 0U ? 1 : 0);
+
+  return crc == 0U;
+}
+
+bool CM17RX::decodeStream(uint16_t& fn)
+{
+  uint8_t payload[M17_PAYLOAD_LENGTH_BITS / 8U];
+  descramble(payload);
+
+  uint8_t errs = 0U;
+  for (uint8_t i = 0U; i < (M17_LICH_LENGTH_BITS / 8U); i += 3U) {
+    uint32_t code = (uint32_t(payload[i + 0U]) << 16) | (uint32_t(payload[i + 1U]) << 8) | uint32_t(payload[i + 2U]);
+
+    uint16_t data;
+    uint8_t  n;
+    if (!CGolay24128::decode24128(code, data, n)) {
+      DEBUG1("M17RX: LICH does not decode");
+      return false;
+    }
+
+    errs += n;
+  }
+
+  uint8_t data[M17_FN_LENGTH_BYTES + M17_PAYLOAD_LENGTH_BYTES];
+  uint16_t metric = m_convolution.decodeData(payload + M17_LICH_LENGTH_BITS / 8U, data);
+
+  DEBUG3("M17RX: stream, LICH errs/path metric", errs, metric);
+
+  // Random bits pass all four LICH codewords about one time in ten, the
+  // convolutional code is far harder to fool
+  if (metric > MAX_STREAM_PATH_METRIC)
+    return false;
+
+  fn = (uint16_t(data[0U]) << 8) | data[1U];
+
+  return true;
+}
+
+void CM17RX::writeRSSILinkSetup(uint8_t* data)
+{
+#if defined(SEND_RSSI_DATA)
+  uint16_t rssi = io.readRSSI();
+
+  data[49U] = (rssi >> 8) & 0xFFU;
+  data[50U] = (rssi >> 0) & 0xFFU;
+
+  serial.writeM17LinkSetup(data, M17_FRAME_LENGTH_BYTES + 3U);
+#else
+  serial.writeM17LinkSetup(data, M17_FRAME_LENGTH_BYTES + 1U);
+#endif
+}
+
+void CM17RX::writeRSSIStream(uint8_t* data)
+{
+#if defined(SEND_RSSI_DATA)
+  uint16_t rssi = io.readRSSI();
+
+  data[49U] = (rssi >> 8) & 0xFFU;
+  data[50U] = (rssi >> 0) & 0xFFU;
+
+  serial.writeM17Stream(data, M17_FRAME_LENGTH_BYTES + 3U);
+#else
+  serial.writeM17Stream(data, M17_FRAME_LENGTH_BYTES + 1U);
+#endif
+}
+
+#endif
@@ -1,6 +1,7 @@
 /*
  *   Copyright (C) 2015-2018,2020,2021 by Jonathan Naylor G4KLX
  *   Copyright (C) 2016-2018 by Andy Uribe CA6JAU
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
  *
  *   This program is free software; you can redistribute it and/or modify
  *   it under the terms of the GNU General Public License as published by
@@ -21,6 +22,7 @@
 #define  M17RX_H
 
 #include "M17Defines.h"
+#include "M17Convolution.h"
 
 enum M17RX_STATE {
   M17RXS_NONE,
@@ -32,20 +34,25 @@ class CM17RX {
 public:
   CM17RX();
 
-  void databit(bool bit);
+  // Processes the newest bit in the shared bit history
+  void databit();
 
   void reset();
 
 private:
-  M17RX_STATE m_state;
-  uint16_t    m_bitBuffer;
-  uint8_t     m_outBuffer[M17_FRAME_LENGTH_BYTES + 3U];
-  uint8_t*    m_buffer;
-  uint16_t    m_bufferPtr;
-  uint16_t    m_lostCount;
-
-  void processNone(bool bit);
-  void processData(bool bit);
+  M17RX_STATE     m_state;
+  bool            m_confirmed;
+  uint8_t         m_outBuffer[M17_FRAME_LENGTH_BYTES + 3U];
+  uint8_t*        m_buffer;
+  uint16_t        m_bufferPtr;
+  uint16_t        m_lostCount;
+  CM17Convolution m_convolution;
+
+  void processNone(uint16_t pattern);
+  void processData(bool bit, uint16_t pattern);
+  void descramble(uint8_t* payload) const;
+  bool decodeLinkSetup();
+  bool decodeStream(uint16_t& fn);
   void writeRSSILinkSetup(uint8_t* data);
   void writeRSSIStream(uint8_t* data);
 };
@@ -55,14 +55,37 @@ bool m_dcd = false;
 CDMRIdleRX dmrIdleRX;
 CDMRRX     dmrRX;
 CDMRTX     dmrTX;
+CDMRFilter dmrFilter;
+CDMRLastHeard dmrLastHeard;
+CDMRLatency dmrLatency;
+CDMRTrunk dmrTrunk;
+#endif
+
+CBitHistory bitHistory;
+
+#if defined(DUAL_RX)
+CBitHistory bitHistory2;
+CDMRRX     dmrRX2(bitHistory2, 1U);
+CDMRDiversity dmrDiversity;
+#endif
+
+#if defined(SYNCRX_ENABLED)
+CSyncRX    syncRX;
 #endif
 
 CDMRDMORX  dmrDMORX;
 CDMRDMOTX  dmrDMOTX;
 
 
-//CM17RX     m17RX;
-//CM17TX     m17TX;
+#if defined(MODE_DSTAR)
+CDStarRX   dstarRX;
+#endif
+
+#if defined(MODE_M17)
+CM17RX     m17RX;
+#endif
+// CM17TX has no implementation yet
+// CM17TX     m17TX;
 
 CCalDMR    calDMR;
 
@@ -74,6 +97,7 @@ CCWIdTX    cwIdTX;
 
 CSerialPort serial;
 CIO io;
+CScheduler scheduler;
 
 void setup()
 {
@@ -82,36 +106,5 @@ void setup()
 
 void loop()
 {
-  serial.process();
-  io.process();
-
-  // The following is for transmitting
-
-
-  if (m_dmrEnable && m_modemState == STATE_DMR && m_calState == STATE_IDLE) {
-#if defined(DUPLEX)
-    if (m_duplex)
-      dmrTX.process();
-    else
-      dmrDMOTX.process();
-#else
-    dmrDMOTX.process();
-#endif
-  }
-
-
- // if (m_m17Enable && m_modemState == STATE_M17)
-    //m17TX.process();
-
-
-  if (m_calState == STATE_DMRCAL || m_calState == STATE_DMRDMO1K || m_calState == STATE_INTCAL)
-    calDMR.process();
-
-#if defined(SEND_RSSI_DATA)
-  if (m_calState == STATE_RSSICAL)
-    calRSSI.process();
-#endif
-
-  if (m_modemState == STATE_IDLE)
-    cwIdTX.process();
+  scheduler.process();
 }
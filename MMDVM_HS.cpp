@@ -52,7 +52,6 @@ bool m_tx  = false;
 bool m_dcd = false;
 
 // Removed modes - not used in MS_MODE wireless bridge
-// CDStarRX   dstarRX;
 // CDStarTX   dstarTX;
 
 uint8_t    m_control = 0x04U;
@@ -61,22 +60,42 @@ uint8_t    m_control = 0x04U;
 CDMRIdleRX dmrIdleRX;
 CDMRRX     dmrRX;
 CDMRTX     dmrTX;
+CDMRFilter dmrFilter;
+CDMRLastHeard dmrLastHeard;
+CDMRLatency dmrLatency;
+CDMRTrunk dmrTrunk;
+#endif
+
+CBitHistory bitHistory;
+
+#if defined(DUAL_RX)
+CBitHistory bitHistory2;
+CDMRRX     dmrRX2(bitHistory2, 1U);
+CDMRDiversity dmrDiversity;
+#endif
+
+#if defined(SYNCRX_ENABLED)
+CSyncRX    syncRX;
 #endif
 
 CDMRDMORX  dmrDMORX;
 CDMRDMOTX  dmrDMOTX;
 
 // Removed modes - not used in MS_MODE wireless bridge
-// CYSFRX     ysfRX;
 // CYSFTX     ysfTX;
-// CP25RX     p25RX;
 // CP25TX     p25TX;
 
+#if defined(MODE_DSTAR)
+CDStarRX   dstarRX;
+#endif
+
+#if defined(MODE_M17)
 CM17RX     m17RX;
-CM17TX     m17TX;
+#endif
+// CM17TX has no implementation yet
+// CM17TX     m17TX;
 
 // Removed modes - not used in MS_MODE wireless bridge
-// CNXDNRX    nxdnRX;
 // CNXDNTX    nxdnTX;
 // CPOCSAGTX  pocsagTX;
 
@@ -90,6 +109,7 @@ CCWIdTX    cwIdTX;
 
 CSerialPort serial;
 CIO io;
+CScheduler scheduler;
 
 #if defined(STM32_I2C_HOST)
 CI2CHost i2c;
@@ -102,50 +122,7 @@ void setup()
 
 void loop()
 {
-  serial.process();
-  io.process();
-
-  // The following is for transmitting
-  // Removed modes commented out - not used in MS_MODE
-  // if (m_dstarEnable && m_modemState == STATE_DSTAR)
-  //   dstarTX.process();
-
-  if (m_dmrEnable && m_modemState == STATE_DMR && m_calState == STATE_IDLE) {
-#if defined(DUPLEX)
-    if (m_duplex)
-      dmrTX.process();
-    else
-      dmrDMOTX.process();
-#else
-    dmrDMOTX.process();
-#endif
-  }
-  
-  // Removed modes commented out - not used in MS_MODE
-  // if (m_ysfEnable && m_modemState == STATE_YSF)
-  //   ysfTX.process();
-  // if (m_p25Enable && m_modemState == STATE_P25)
-  //   p25TX.process();
-  // if (m_nxdnEnable && m_modemState == STATE_NXDN)
-  //   nxdnTX.process();
-
-  if (m_m17Enable && m_modemState == STATE_M17)
-    m17TX.process();
-
-  // Removed modes commented out - not used in MS_MODE
-  // if (m_pocsagEnable && (m_modemState == STATE_POCSAG || pocsagTX.busy()))
-  //   pocsagTX.process();
-
-  if (m_calState == STATE_DMRCAL || m_calState == STATE_DMRDMO1K || m_calState == STATE_INTCAL)
-    calDMR.process();
-
-#if defined(SEND_RSSI_DATA)
-  if (m_calState == STATE_RSSICAL)
-    calRSSI.process();
-#endif
-
-  if (m_modemState == STATE_IDLE)
-    cwIdTX.process();
+  scheduler.process();
 }
 
 int main()
@@ -1,6 +1,7 @@
 /*
  *   Copyright (C) 2015,2016,2017,2018 by Jonathan Naylor G4KLX
  *   Copyright (C) 2016,2017,2018 by Andy Uribe CA6JAU
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
  *
  *   This program is free software; you can redistribute it and/or modify
  *   it under the terms of the GNU General Public License as published by
@@ -21,32 +22,8 @@
 #define  NXDNRX_H
 
 #include "NXDNDefines.h"
+#include "SyncRX.h"
 
-enum NXDNRX_STATE {
-  NXDNRXS_NONE,
-  NXDNRXS_DATA
-};
-
-class CNXDNRX {
-public:
-  CNXDNRX();
-
-  void databit(bool bit);
-
-  void reset();
-
-private:
-  NXDNRX_STATE m_state;
-  uint64_t     m_bitBuffer;
-  uint8_t      m_outBuffer[NXDN_FRAME_LENGTH_BYTES + 3U];
-  uint8_t*     m_buffer;
-  uint16_t     m_bufferPtr;
-  uint16_t     m_lostCount;
-
-  void processNone(bool bit);
-  void processData(bool bit);
-  void writeRSSIData(uint8_t* data);
-
-};
+extern const SYNCRX_DECODER NXDN_DECODER;
 
 #endif
@@ -0,0 +1,102 @@
+/*
+ *   Copyright (C) 2016,2017 by Jonathan Naylor G4KLX
+ *   Copyright (C) 2016,2017,2018 by Andy Uribe CA6JAU
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Config.h"
+
+#if defined(MODE_P25)
+
+#include "Globals.h"
+#include "P25RX.h"
+
+// Called once the NID is in, picks the length of the first frame from its DUID
+static uint16_t decodeNID(const uint8_t* frame, bool first)
+{
+  // FIXME: we should check and correct for errors in NID first!
+  uint8_t duid = frame[7U] & 0x0FU;
+  DEBUG2("P25RX: DUID", duid);
+
+  // After the first frame the DUID is only used to detect a TDU for EOT
+  if (!first)
+    return P25_LDU_FRAME_LENGTH_BITS;
+
+  switch (duid) {
+    case P25_DUID_HDU:
+      DEBUG1("P25RX: sync found in HDU");
+      return P25_HDR_FRAME_LENGTH_BITS;
+    case P25_DUID_TDU:
+      DEBUG1("P25RX: sync found in TDU");
+      return P25_TERM_FRAME_LENGTH_BITS;
+    case P25_DUID_TSDU:
+      DEBUG1("P25RX: sync found in TSDU");
+      return P25_TSDU_FRAME_LENGTH_BITS;
+    case P25_DUID_TDULC:
+      DEBUG1("P25RX: sync found in TDULC");
+      return P25_TERMLC_FRAME_LENGTH_BITS;
+    default:
+      return P25_LDU_FRAME_LENGTH_BITS;
+  }
+}
+
+static bool writeData(uint8_t* data, uint16_t lengthBits)
+{
+  if (lengthBits != P25_LDU_FRAME_LENGTH_BITS) {
+    data[0U] = 0x01U;
+    serial.writeP25Hdr(data, (lengthBits / 8U) + 1U);
+    return true;
+  }
+
+  uint8_t duid = data[8U] & 0x0FU;
+
+#if defined(SEND_RSSI_DATA)
+  uint16_t rssi = io.readRSSI();
+
+  data[217U] = (rssi >> 8) & 0xFFU;
+  data[218U] = (rssi >> 0) & 0xFFU;
+
+  serial.writeP25Ldu(data, P25_LDU_FRAME_LENGTH_BYTES + 3U);
+#else
+  serial.writeP25Ldu(data, P25_LDU_FRAME_LENGTH_BYTES + 1U);
+#endif
+
+  // Stop at a TDU to avoid a false "lost lock"
+  return duid != P25_DUID_TDU && duid != P25_DUID_TDULC;
+}
+
+static void writeLost()
+{
+  serial.writeP25Lost();
+}
+
+const SYNCRX_DECODER P25_DECODER = {
+  P25_SYNC_BITS,
+  P25_SYNC_BITS_MASK,
+  P25_SYNC_BYTES,
+  P25_SYNC_LENGTH_BITS,
+  2U,                               // Sync bit errors to start
+  4U,                               // Sync bit errors while running
+  3U + 1U,                          // Frames without sync before lost
+  P25_LDU_FRAME_LENGTH_BITS,
+  P25_SYNC_LENGTH_BITS + 16U,       // The DUID is the last nibble of the NID
+  decodeNID,
+  writeData,
+  writeLost
+};
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "Config.h"
+#include "Globals.h"
+#include "QR1676.h"
+
+// ETSI TS 102 361-1 table B.12, indexed by the data
+const uint16_t ENCODING_TABLE_1676[] = {
+  0x0000U, 0x0273U, 0x04E5U, 0x0696U, 0x09C9U, 0x0BBAU, 0x0D2CU, 0x0F5FU,
+  0x11E2U, 0x1391U, 0x1507U, 0x1774U, 0x182BU, 0x1A58U, 0x1CCEU, 0x1EBDU,
+  0x21B7U, 0x23C4U, 0x2552U, 0x2721U, 0x287EU, 0x2A0DU, 0x2C9BU, 0x2EE8U,
+  0x3055U, 0x3226U, 0x34B0U, 0x36C3U, 0x399CU, 0x3BEFU, 0x3D79U, 0x3F0AU,
+  0x411EU, 0x436DU, 0x45FBU, 0x4788U, 0x48D7U, 0x4AA4U, 0x4C32U, 0x4E41U,
+  0x50FCU, 0x528FU, 0x5419U, 0x566AU, 0x5935U, 0x5B46U, 0x5DD0U, 0x5FA3U,
+  0x60A9U, 0x62DAU, 0x644CU, 0x663FU, 0x6960U, 0x6B13U, 0x6D85U, 0x6FF6U,
+  0x714BU, 0x7338U, 0x75AEU, 0x77DDU, 0x7882U, 0x7AF1U, 0x7C67U, 0x7E14U,
+  0x804FU, 0x823CU, 0x84AAU, 0x86D9U, 0x8986U, 0x8BF5U, 0x8D63U, 0x8F10U,
+  0x91ADU, 0x93DEU, 0x9548U, 0x973BU, 0x9864U, 0x9A17U, 0x9C81U, 0x9EF2U,
+  0xA1F8U, 0xA38BU, 0xA51DU, 0xA76EU, 0xA831U, 0xAA42U, 0xACD4U, 0xAEA7U,
+  0xB01AU, 0xB269U, 0xB4FFU, 0xB68CU, 0xB9D3U, 0xBBA0U, 0xBD36U, 0xBF45U,
+  0xC151U, 0xC322U, 0xC5B4U, 0xC7C7U, 0xC898U, 0xCAEBU, 0xCC7DU, 0xCE0EU,
+  0xD0B3U, 0xD2C0U, 0xD456U, 0xD625U, 0xD97AU, 0xDB09U, 0xDD9FU, 0xDFECU,
+  0xE0E6U, 0xE295U, 0xE403U, 0xE670U, 0xE92FU, 0xEB5CU, 0xEDCAU, 0xEFB9U,
+  0xF104U, 0xF377U, 0xF5E1U, 0xF792U, 0xF8CDU, 0xFABEU, 0xFC28U, 0xFE5BU};
+
+uint16_t CQR1676::encode(uint8_t data)
+{
+  return ENCODING_TABLE_1676[data & 0x7FU];
+}
+
+bool CQR1676::decode(uint16_t code, uint8_t& data, uint8_t& errs)
+{
+  // 128 codewords are few enough to compare against them all
+  uint8_t best = 0U;
+  errs = 16U;
+
+  for (uint8_t i = 0U; i < 128U && errs > 0U; i++) {
+    uint8_t n = countBits16(code ^ ENCODING_TABLE_1676[i]);
+    if (n < errs) {
+      errs = n;
+      best = i;
+    }
+  }
+
+  data = best;
+
+  return errs <= 2U;
+}
@@ -0,0 +1,36 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(QR1676_H)
+#define  QR1676_H
+
+#include <stdint.h>
+
+// Quadratic residue (16,7,6) of the DMR EMB, the data is in the top 7 bits
+// of the codeword
+class CQR1676 {
+public:
+  static uint16_t encode(uint8_t data);
+
+  // Finds the nearest codeword, returns false when it is more than two bits
+  // away. errs is the number of bits that differ from it.
+  static bool decode(uint16_t code, uint8_t& data, uint8_t& errs);
+};
+
+#endif
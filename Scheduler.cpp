@@ -0,0 +1,211 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Config.h"
+#include "Globals.h"
+#include "Scheduler.h"
+
+static void taskSerial()
+{
+  serial.process();
+}
+
+static void taskDMRTX()
+{
+  if (m_dmrEnable && m_modemState == STATE_DMR && m_calState == STATE_IDLE) {
+#if defined(DUPLEX)
+    if (m_duplex)
+      dmrTX.process();
+    else
+      dmrDMOTX.process();
+#else
+    dmrDMOTX.process();
+#endif
+  }
+}
+
+#if defined(DUPLEX)
+static void taskTrunk()
+{
+  if (m_modemState == STATE_DMR)
+    dmrTrunk.clock();
+}
+#endif
+
+static void taskHousekeeping()
+{
+  io.housekeeping();
+}
+
+static void taskCalDMR()
+{
+  if (m_calState == STATE_DMRCAL || m_calState == STATE_DMRDMO1K || m_calState == STATE_INTCAL)
+    calDMR.process();
+}
+
+#if defined(SEND_RSSI_DATA)
+static void taskCalRSSI()
+{
+  if (m_calState == STATE_RSSICAL)
+    calRSSI.process();
+}
+#endif
+
+static void taskCWId()
+{
+  if (m_modemState == STATE_IDLE)
+    cwIdTX.process();
+}
+
+CScheduler::CScheduler() :
+m_tasks(),
+m_count(0U),
+m_missed(0U),
+m_reported(0U),
+m_lastMissed(0U),
+m_peakBacklog(0U),
+m_peakReported(0U),
+m_reportTime(0U)
+{
+  // Task, period, budget, deferrable
+#if defined(DUPLEX)
+  // First, so a grant is acted on right after the bits that carried it
+  add(taskTrunk,        0U,  4U, false);
+#endif
+  add(taskSerial,       0U,  8U, false);
+  add(taskDMRTX,        0U, 16U, false);
+  add(taskHousekeeping, SCHED_HOUSEKEEPING_PERIOD,  4U, true);
+  add(taskCalDMR,       SCHED_TX_FILL_PERIOD,      16U, true);
+#if defined(SEND_RSSI_DATA)
+  // Counts its own passes to pace the RSSI reads
+  add(taskCalRSSI,      0U,                        16U, true);
+#endif
+  add(taskCWId,         SCHED_TX_FILL_PERIOD,      16U, true);
+}
+
+void CScheduler::add(void (*run)(), uint16_t period, uint16_t budget, bool deferrable)
+{
+  if (m_count >= SCHED_MAX_TASKS)
+    return;
+
+  m_tasks[m_count].run        = run;
+  m_tasks[m_count].period     = period;
+  m_tasks[m_count].budget     = budget;
+  m_tasks[m_count].deferrable = deferrable;
+  m_tasks[m_count].last       = 0U;
+  m_tasks[m_count].missed     = 0U;
+  m_count++;
+}
+
+void CScheduler::process()
+{
+  // RX bit draining always comes first
+  drainRX();
+
+  for (uint8_t i = 0U; i < m_count; i++) {
+    SCHED_TASK& task = m_tasks[i];
+
+    uint32_t now     = io.getTicks();
+    uint32_t elapsed = now - task.last;
+
+    if (task.period > 0U && elapsed < task.period)
+      continue;
+
+    if (task.deferrable && io.getRXData() >= SCHED_RX_BACKLOG) {
+      if (elapsed < SCHED_MAX_DEFER)
+        continue;
+
+      // Held off for too long, run it anyway
+      miss(i);
+    } else if (task.period > 0U && task.last != 0U && elapsed >= 2U * uint32_t(task.period)) {
+      // Late, setup() does not count against the first run
+      miss(i);
+    }
+
+    task.run();
+    task.last = now;
+
+    if ((io.getTicks() - now) > task.budget)
+      miss(i);
+
+    drainRX();
+  }
+
+  report();
+}
+
+void CScheduler::drainRX()
+{
+  uint16_t n = 0U;
+
+  // At least one pass, CIO::process() also switches the transmitter off
+  do {
+    io.process();
+    n++;
+  } while (n < SCHED_RX_BURST && io.getRXData() > 0U);
+
+  uint16_t backlog = io.getRXData();
+  if (backlog > m_peakBacklog)
+    m_peakBacklog = backlog;
+  if (backlog > m_peakReported)
+    m_peakReported = backlog;
+}
+
+void CScheduler::miss(uint8_t n)
+{
+  m_tasks[n].missed++;
+  m_missed++;
+  m_lastMissed = n;
+}
+
+void CScheduler::report()
+{
+  uint32_t now = io.getTicks();
+  if ((now - m_reportTime) < SCHED_REPORT_TIME)
+    return;
+
+  m_reportTime = now;
+
+  if (m_missed != m_reported) {
+    DEBUG4("Sched: missed deadlines/peak RX backlog/last task", int16_t(m_missed - m_reported), int16_t(m_peakBacklog), m_lastMissed);
+    m_reported = m_missed;
+  }
+
+  m_peakBacklog = 0U;
+}
+
+uint8_t CScheduler::readStatus(uint8_t* data, uint8_t length) const
+{
+  if (length < SCHED_STATUS_LENGTH)
+    return 0U;
+
+  data[0U] = (m_missed >> 8) & 0xFFU;
+  data[1U] = (m_missed >> 0) & 0xFFU;
+  data[2U] = (m_peakReported >> 8) & 0xFFU;
+  data[3U] = (m_peakReported >> 0) & 0xFFU;
+  data[4U] = m_lastMissed;
+
+  return SCHED_STATUS_LENGTH;
+}
+
+void CScheduler::resetStatus()
+{
+  m_missed       = 0U;
+  m_reported     = 0U;
+  m_peakReported = 0U;
+}
@@ -0,0 +1,86 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(SCHEDULER_H)
+#define  SCHEDULER_H
+
+#include "Config.h"
+#include <stdint.h>
+
+// All times are in ticks of CIO::getTicks(), one tick per ADF7021 clock edge
+
+const uint8_t  SCHED_MAX_TASKS   = 8U;
+
+// Bits drained from the RX ring before and between every task
+const uint16_t SCHED_RX_BURST    = 64U;
+
+// RX backlog (bits) above which housekeeping tasks are held off
+const uint16_t SCHED_RX_BACKLOG  = 256U;
+
+// Longest a housekeeping task may be held off before it is run anyway
+const uint32_t SCHED_MAX_DEFER   = 9600U;
+
+// Interval between missed deadline reports
+const uint32_t SCHED_REPORT_TIME = 19200U;
+
+// Task periods. Housekeeping keeps the scan dwell and the service LED to
+// within a millisecond, the calibration and CW ID transmitters only have to
+// keep a 1024 bit TX ring from running dry
+const uint16_t SCHED_HOUSEKEEPING_PERIOD = 16U;
+const uint16_t SCHED_TX_FILL_PERIOD      = 96U;
+
+// Bytes of the scheduler status: missed deadlines and the peak RX backlog,
+// both 16-bit big-endian, then the last task to miss
+const uint8_t  SCHED_STATUS_LENGTH = 5U;
+
+struct SCHED_TASK {
+  void     (*run)();
+  uint16_t period;      // 0 = run on every pass
+  uint16_t budget;
+  bool     deferrable;
+  uint32_t last;
+  uint16_t missed;
+};
+
+class CScheduler {
+public:
+  CScheduler();
+
+  void process();
+
+  // Returns the number of bytes written
+  uint8_t readStatus(uint8_t* data, uint8_t length) const;
+  void    resetStatus();
+
+private:
+  SCHED_TASK m_tasks[SCHED_MAX_TASKS];
+  uint8_t    m_count;
+  uint16_t   m_missed;
+  uint16_t   m_reported;
+  uint8_t    m_lastMissed;
+  uint16_t   m_peakBacklog;
+  uint16_t   m_peakReported;
+  uint32_t   m_reportTime;
+
+  void add(void (*run)(), uint16_t period, uint16_t budget, bool deferrable);
+  void drainRX();
+  void miss(uint8_t n);
+  void report();
+};
+
+#endif
@@ -92,6 +92,45 @@ uint8_t CSerialPort::readInt(uint8_t n)
   }
 }
 
+// Drain what the port already holds in one pass, rather than a port switch
+// and an available() check per byte
+static uint16_t readStream(Stream& stream, uint8_t* data, uint16_t length)
+{
+  int n = stream.available();
+  if (n <= 0)
+    return 0U;
+
+  if (uint16_t(n) < length)
+    length = uint16_t(n);
+
+  for (uint16_t i = 0U; i < length; i++)
+    data[i] = stream.read();
+
+  return length;
+}
+
+uint16_t CSerialPort::readInt(uint8_t n, uint8_t* data, uint16_t length)
+{
+  switch (n) {
+    case 1U:
+    #if defined(STM32_USART1_HOST) && defined(__STM32F1__)
+      return readStream(Serial1, data, length);
+    #else
+      return readStream(Serial, data, length);
+    #endif
+    case 3U:
+    #if defined(SERIAL_REPEATER) && defined(__STM32F1__)
+      return readStream(Serial2, data, length);
+    #elif defined(SERIAL_REPEATER_USART1) && defined(__STM32F1__)
+      return readStream(Serial1, data, length);
+    #elif defined(SERIAL_REPEATER) && (defined(__MK20DX256__) || defined(__MK64FX512__) || defined(__MK66FX1M0__))
+      return readStream(Serial1, data, length);
+    #endif
+    default:
+      return 0U;
+  }
+}
+
 void CSerialPort::writeInt(uint8_t n, const uint8_t* data, uint16_t length, bool flush)
 {
   switch (n) {
@@ -75,6 +75,23 @@ const uint8_t MMDVM_SERIAL       = 0x80U;
 const uint8_t MMDVM_TRANSPARENT  = 0x90U;
 const uint8_t MMDVM_QSO_INFO     = 0x91U;
 
+// MS_MODE bridge extensions
+const uint8_t MMDVM_DMR_FILTER   = 0xA0U;
+const uint8_t MMDVM_DMR_LAST_HEARD = 0xA1U;
+const uint8_t MMDVM_SET_CHANNELS = 0xA2U;
+const uint8_t MMDVM_DMR_QUEUE_LATENCY = 0xA3U;
+const uint8_t MMDVM_DMR_DUAL_RX  = 0xA4U;
+const uint8_t MMDVM_DMR_QUALITY  = 0xA5U;
+const uint8_t MMDVM_DMR_CSBK_FILTER = 0xA6U;
+const uint8_t MMDVM_DMR_TRUNK    = 0xA7U;
+const uint8_t MMDVM_DMR_TRUNK_STATUS = 0xA8U;
+const uint8_t MMDVM_DMR_TX_BUFFER = 0xA9U;
+const uint8_t MMDVM_DMR_TX_STATUS = 0xAAU;
+const uint8_t MMDVM_IO_STATUS    = 0xABU;
+
+// Receiver tag of a second receiver's frames, the slot is in bit 0
+const uint8_t DUAL_RX_TAG_LOST   = 0x80U;
+
 const uint8_t MMDVM_DEBUG1       = 0xF1U;
 const uint8_t MMDVM_DEBUG2       = 0xF2U;
 const uint8_t MMDVM_DEBUG3       = 0xF3U;
@@ -83,6 +100,14 @@ const uint8_t MMDVM_DEBUG5       = 0xF5U;
 
 const uint8_t PROTOCOL_VERSION   = 1U;
 
+// Bytes taken from the host port per read, and the partial frame timeout in ms
+const uint16_t SERIAL_READ_LENGTH   = 64U;
+const uint32_t SERIAL_FRAME_TIMEOUT = 100U;
+
+// SET_CONFIG payload, the full protocol 1 layout and the DMR fields needed
+const uint8_t SET_CONFIG_LENGTH     = 23U;
+const uint8_t SET_CONFIG_MIN_LENGTH = 11U;
+
 #if defined(ENABLE_UDID)
 char UDID[] = "00000000000000000000000000000000";
 #endif
@@ -91,6 +116,7 @@ CSerialPort::CSerialPort() :
 m_buffer(),
 m_ptr(0U),
 m_len(0U),
+m_lastRX(0U),
 m_serial_buffer(),
 m_serial_len(0U),
 m_debug(false),
@@ -98,7 +124,7 @@ m_firstCal(false)
 {
 }
 
-void CSerialPort::sendACK()
+void CSerialPort::sendACK(uint8_t type)
 {
   io.resetWatchdog();
 
@@ -107,12 +133,12 @@ void CSerialPort::sendACK()
   reply[0U] = MMDVM_FRAME_START;
   reply[1U] = 4U;
   reply[2U] = MMDVM_ACK;
-  reply[3U] = m_buffer[2U];
+  reply[3U] = type;
 
   writeInt(1U, reply, 4, true);
 }
 
-void CSerialPort::sendNAK(uint8_t err)
+void CSerialPort::sendNAK(uint8_t type, uint8_t err)
 {
   io.resetWatchdog();
 
@@ -121,7 +147,7 @@ void CSerialPort::sendNAK(uint8_t err)
   reply[0U] = MMDVM_FRAME_START;
   reply[1U] = 5U;
   reply[2U] = MMDVM_NAK;
-  reply[3U] = m_buffer[2U];
+  reply[3U] = type;
   reply[4U] = err;
 
   writeInt(1U, reply, 5, true);
@@ -189,6 +215,125 @@ void CSerialPort::getStatus()
   writeInt(1U, reply, 14);
 }
 
+void CSerialPort::getLastHeard()
+{
+  uint8_t reply[4U + DMR_LAST_HEARD_LENGTH * DMR_LAST_HEARD_ENTRY_LENGTH];
+
+  reply[0U] = MMDVM_FRAME_START;
+  reply[1U] = 0U;
+  reply[2U] = MMDVM_DMR_LAST_HEARD;
+
+  uint8_t count = 4U;
+#if defined(DUPLEX)
+  count += dmrLastHeard.read(reply + 4U, sizeof(reply) - 4U);
+#endif
+
+  // Number of calls that follow
+  reply[3U] = (count - 4U) / DMR_LAST_HEARD_ENTRY_LENGTH;
+
+  reply[1U] = count;
+
+  writeInt(1U, reply, count);
+}
+
+void CSerialPort::getQueueLatency(bool clear)
+{
+  uint8_t reply[5U + DMRLT_COUNT * DMR_LATENCY_TYPE_LENGTH];
+
+  reply[0U] = MMDVM_FRAME_START;
+  reply[1U] = 0U;
+  reply[2U] = MMDVM_DMR_QUEUE_LATENCY;
+
+  // Header, voice, terminator, data, each the maximum then the buckets
+  reply[3U] = DMRLT_COUNT;
+  reply[4U] = DMR_LATENCY_BUCKETS;
+
+  uint8_t count = 5U;
+#if defined(DUPLEX)
+  count += dmrLatency.read(reply + 5U, sizeof(reply) - 5U);
+
+  if (clear)
+    dmrLatency.reset();
+#else
+  (void)clear;
+#endif
+
+  reply[1U] = count;
+
+  writeInt(1U, reply, count);
+}
+
+void CSerialPort::getTrunk(bool clear)
+{
+  uint8_t reply[3U + DMR_TRUNK_STATUS_LENGTH];
+
+  reply[0U] = MMDVM_FRAME_START;
+  reply[1U] = 0U;
+  reply[2U] = MMDVM_DMR_TRUNK_STATUS;
+
+  uint8_t count = 3U;
+#if defined(DUPLEX)
+  count += dmrTrunk.read(reply + 3U, sizeof(reply) - 3U);
+
+  if (clear)
+    dmrTrunk.reset();
+#else
+  (void)clear;
+#endif
+
+  reply[1U] = count;
+
+  writeInt(1U, reply, count);
+}
+
+void CSerialPort::getTXBuffer(bool clear)
+{
+  uint8_t reply[3U + DMR_TX_STATUS_LENGTH];
+
+  reply[0U] = MMDVM_FRAME_START;
+  reply[1U] = 0U;
+  reply[2U] = MMDVM_DMR_TX_STATUS;
+
+  uint8_t count = 3U;
+#if defined(DUPLEX)
+  count += dmrTX.readStatus(reply + 3U, sizeof(reply) - 3U);
+
+  if (clear)
+    dmrTX.resetStatus();
+#else
+  (void)clear;
+#endif
+
+  reply[1U] = count;
+
+  writeInt(1U, reply, count);
+}
+
+void CSerialPort::getIOStatus(bool clear)
+{
+  uint8_t reply[3U + IO_STATUS_LENGTH + SCHED_STATUS_LENGTH + SHADOW_STATUS_LENGTH];
+
+  reply[0U] = MMDVM_FRAME_START;
+  reply[1U] = 0U;
+  reply[2U] = MMDVM_IO_STATUS;
+
+  // The turnarounds, the scheduler, then the register shadow
+  uint8_t count = 3U;
+  count += io.readStatus(reply + count, sizeof(reply) - count);
+  count += scheduler.readStatus(reply + count, sizeof(reply) - count);
+  count += io.readShadowStatus(reply + count, sizeof(reply) - count);
+
+  if (clear) {
+    io.resetStatus();
+    scheduler.resetStatus();
+    io.resetShadowStatus();
+  }
+
+  reply[1U] = count;
+
+  writeInt(1U, reply, count);
+}
+
 void CSerialPort::getVersion()
 {
   uint8_t reply[132U];
@@ -216,9 +361,15 @@ void CSerialPort::getVersion()
 
 uint8_t CSerialPort::setConfig(const uint8_t* data, uint8_t length)
 {
-  (void)length;
-  //if (length < 23U)
-  //  return 4U;
+  // Older hosts send a shorter config, everything up to the DMR TX level is
+  // needed and the missing trailing levels read as zero
+  if (length < SET_CONFIG_MIN_LENGTH)
+    return 4U;
+
+  uint8_t config[SET_CONFIG_LENGTH];
+  ::memset(config, 0x00U, SET_CONFIG_LENGTH);
+  ::memcpy(config, data, (length < SET_CONFIG_LENGTH) ? length : SET_CONFIG_LENGTH);
+  data = config;
 
   bool ysfLoDev  = (data[0U] & 0x08U) == 0x08U;
   bool simplex   = (data[0U] & 0x80U) == 0x80U;
@@ -518,6 +669,122 @@ uint8_t CSerialPort::setFreq(const uint8_t* data, uint8_t length)
   return io.setFreq(freq_rx, freq_tx, rf_power, pocsag_freq_tx);
 }
 
+// Payload: dwell time in ms (2 bytes), channel count, then the RX
+// frequencies in Hz (4 bytes each), all little endian like SET_FREQ
+uint8_t CSerialPort::setChannels(const uint8_t* data, uint8_t length)
+{
+  if (length < 3U)
+    return 4U;
+
+  uint16_t dwell = data[0U] | (data[1U] << 8);
+  uint8_t  count = data[2U];
+
+  if (count > SCAN_MAX_CHANNELS || length != (3U + count * 4U))
+    return 4U;
+
+  uint32_t frequencies[SCAN_MAX_CHANNELS];
+  for (uint8_t i = 0U; i < count; i++) {
+    const uint8_t* p = data + 3U + i * 4U;
+    frequencies[i]  = p[0U] << 0;
+    frequencies[i] |= p[1U] << 8;
+    frequencies[i] |= p[2U] << 16;
+    frequencies[i] |= uint32_t(p[3U]) << 24;
+  }
+
+  return io.setChannels(frequencies, count, dwell);
+}
+
+#if defined(DUPLEX)
+// Payload: the burst cost limits to start a call, to forward a burst and to
+// keep the flywheel running
+uint8_t CSerialPort::setQuality(const uint8_t* data, uint8_t length)
+{
+  if (length != 3U)
+    return 4U;
+
+  uint8_t err = dmrRX.setQuality(data[1U], data[0U], data[2U]);
+  if (err != 0U)
+    return err;
+
+#if defined(DUAL_RX)
+  dmrRX2.setQuality(data[1U], data[0U], data[2U]);
+#endif
+
+  return 0U;
+}
+
+// Payload: channel count, then for each the logical channel number (2 bytes)
+// and the RX frequency in Hz (4 bytes), little endian, the control channel
+// first. A count of zero stops following.
+uint8_t CSerialPort::setTrunk(const uint8_t* data, uint8_t length)
+{
+  if (length < 1U)
+    return 4U;
+
+  uint8_t count = data[0U];
+
+  if (count > DMR_TRUNK_MAX_CHANNELS || length != (1U + count * 6U))
+    return 4U;
+
+  uint16_t channels[DMR_TRUNK_MAX_CHANNELS];
+  uint32_t frequencies[DMR_TRUNK_MAX_CHANNELS];
+  for (uint8_t i = 0U; i < count; i++) {
+    const uint8_t* p = data + 1U + i * 6U;
+    channels[i]     = p[0U] | (p[1U] << 8);
+    frequencies[i]  = p[2U] << 0;
+    frequencies[i] |= p[3U] << 8;
+    frequencies[i] |= p[4U] << 16;
+    frequencies[i] |= uint32_t(p[5U]) << 24;
+
+    // Logical physical channels are 12 bits
+    if (channels[i] > 0x0FFFU)
+      return 4U;
+  }
+
+  uint8_t err = io.setTrunk(frequencies, count);
+  if (err != 0U)
+    return err;
+
+  dmrTrunk.setPlan(channels, count);
+
+  return 0U;
+}
+#endif
+
+#if defined(DUAL_RX)
+// Payload: 32-bit little endian frequency, zero to stop, and the colour code,
+// optionally followed by a flags byte where bit 0 combines the two receivers
+// on the main downlink instead of reporting the second one separately
+uint8_t CSerialPort::setDualRX(const uint8_t* data, uint8_t length)
+{
+  if (length != 5U && length != 6U)
+    return 4U;
+
+  uint32_t frequency  = data[0U] << 0;
+  frequency |= data[1U] << 8;
+  frequency |= data[2U] << 16;
+  frequency |= uint32_t(data[3U]) << 24;
+
+  uint8_t colorCode = data[4U];
+  if (colorCode > 15U)
+    return 4U;
+
+  bool diversity = (length == 6U) && ((data[5U] & 0x01U) == 0x01U);
+
+  uint8_t err = io.setDualRX(frequency);
+  if (err != 0U)
+    return err;
+
+  dmrDiversity.setEnabled(diversity && frequency != 0U);
+  dmrDiversity.reset();
+
+  dmrRX2.setColorCode(colorCode);
+  dmrRX2.reset();
+
+  return 0U;
+}
+#endif
+
 void CSerialPort::setMode(MMDVM_STATE modemState)
 {
   switch (modemState) {
@@ -533,6 +800,9 @@ void CSerialPort::setMode(MMDVM_STATE modemState)
       dmrRX.reset();
 #endif
       dmrDMORX.reset();
+#if defined(MODE_DSTAR)
+      dstarRX.reset();
+#endif
 
       cwIdTX.reset();
       break;
@@ -543,6 +813,9 @@ void CSerialPort::setMode(MMDVM_STATE modemState)
       dmrRX.reset();
 #endif
       dmrDMORX.reset();
+#if defined(MODE_YSF)
+      syncRX.setDecoder(&YSF_DECODER);
+#endif
 
       cwIdTX.reset();
       break;
@@ -553,6 +826,9 @@ void CSerialPort::setMode(MMDVM_STATE modemState)
       dmrRX.reset();
 #endif
       dmrDMORX.reset();
+#if defined(MODE_P25)
+      syncRX.setDecoder(&P25_DECODER);
+#endif
 
       cwIdTX.reset();
       break;
@@ -563,6 +839,9 @@ void CSerialPort::setMode(MMDVM_STATE modemState)
       dmrRX.reset();
 #endif
       dmrDMORX.reset();
+#if defined(MODE_NXDN)
+      syncRX.setDecoder(&NXDN_DECODER);
+#endif
 
       cwIdTX.reset();
       break;
@@ -573,6 +852,9 @@ void CSerialPort::setMode(MMDVM_STATE modemState)
       dmrRX.reset();
 #endif
       dmrDMORX.reset();
+#if defined(MODE_M17)
+      m17RX.reset();
+#endif
      
       cwIdTX.reset();
       break;
@@ -613,229 +895,79 @@ void CSerialPort::start()
 
 void CSerialPort::process()
 {
-  while (availableInt(1U)) {
-    uint8_t c = readInt(1U);
+  uint8_t  data[SERIAL_READ_LENGTH];
+  uint16_t n;
 
-    if (m_ptr == 0U) {
-      if (c == MMDVM_FRAME_START) {
-        // Handle the frame start correctly
-        m_buffer[0U] = c;
-        m_ptr = 1U;
-        m_len = 0U;
-      }
-      else {
-        m_ptr = 0U;
-        m_len = 0U;
-      }
-    } else if (m_ptr == 1U) {
-      // Handle the frame length
-      m_len = m_buffer[m_ptr] = c;
-      m_ptr = 2U;
-    } else {
-      // Any other bytes are added to the buffer
-      m_buffer[m_ptr] = c;
-      m_ptr++;
-
-      // The full packet has been received, process it
-      if (m_ptr == m_len) {
-        uint8_t err = 2U;
-
-        switch (m_buffer[2U]) {
-          case MMDVM_GET_STATUS:
-            getStatus();
-            break;
-
-          case MMDVM_GET_VERSION:
-            getVersion();
-            break;
-
-          case MMDVM_SET_CONFIG:
-            err = setConfig(m_buffer + 3U, m_len - 3U);
-            if (err == 0U)
-              sendACK();
-            else
-              sendNAK(err);
-            break;
-
-          case MMDVM_SET_MODE:
-            err = setMode(m_buffer + 3U, m_len - 3U);
-            if (err == 0U)
-              sendACK();
-            else
-              sendNAK(err);
-            break;
-
-          case MMDVM_SET_FREQ:
-            err = setFreq(m_buffer + 3U, m_len - 3U);
-            if (err == 0U)
-              sendACK();
-            else
-              sendNAK(err);
-            break;
-
-          case MMDVM_CAL_DATA:
-            if (m_calState == STATE_DMRCAL || m_calState == STATE_DMRDMO1K) {
-              err = calDMR.write(m_buffer + 3U, m_len - 3U);
-            }             else if (m_calState == STATE_RSSICAL || m_calState == STATE_INTCAL) {
-              err = 0U;
-            }
-            if (err == 0U) {
-              sendACK();
-            } else {
-              DEBUG2("Received invalid calibration data", err);
-              sendNAK(err);
-            }
-            break;
-
-          case MMDVM_SEND_CWID:
-            err = 5U;
-            if (m_modemState == STATE_IDLE) {
-              m_cwid_state = true;
-              io.ifConf(STATE_CWID, true);
-              err = cwIdTX.write(m_buffer + 3U, m_len - 3U);
-            }
-            if (err != 0U) {
-              DEBUG2("Invalid CW Id data", err);
-              sendNAK(err);
-            }
-            break;
-
-          case MMDVM_DMR_DATA1:
-          #if defined(DUPLEX)
-            if (m_dmrEnable) {
-              if (m_modemState == STATE_IDLE || m_modemState == STATE_DMR) {
-                if (m_duplex)
-                  err = dmrTX.writeData1(m_buffer + 3U, m_len - 3U);
-              }
-            }
-            if (err == 0U) {
-              if (m_modemState == STATE_IDLE)
-                setMode(STATE_DMR);
-            } else {
-              DEBUG2("Received invalid DMR data", err);
-              sendNAK(err);
-            }
-          #endif
-            break;
-
-          case MMDVM_DMR_DATA2:
-            if (m_dmrEnable) {
-              if (m_modemState == STATE_IDLE || m_modemState == STATE_DMR) {
-              #if defined(DUPLEX)
-                if (m_duplex)
-                  err = dmrTX.writeData2(m_buffer + 3U, m_len - 3U);
-                else
-                  err = dmrDMOTX.writeData(m_buffer + 3U, m_len - 3U);
-              #else
-                  err = dmrDMOTX.writeData(m_buffer + 3U, m_len - 3U);
-              #endif
-              }
-            }
-            if (err == 0U) {
-              if (m_modemState == STATE_IDLE)
-                setMode(STATE_DMR);
-            } else {
-              DEBUG2("Received invalid DMR data", err);
-              sendNAK(err);
-            }
-            break;
-
-
-          case MMDVM_DMR_SHORTLC:
-          #if defined(DUPLEX)
-            if (m_dmrEnable)
-              err = dmrTX.writeShortLC(m_buffer + 3U, m_len - 3U);
-            if (err != 0U) {
-              DEBUG2("Received invalid DMR Short LC", err);
-              sendNAK(err);
-            }
-          #endif
-            break;
-
-          case MMDVM_DMR_ABORT:
-          #if defined(DUPLEX)
-            if (m_dmrEnable)
-              err = dmrTX.writeAbort(m_buffer + 3U, m_len - 3U);
-            if (err != 0U) {
-              DEBUG2("Received invalid DMR Abort", err);
-              sendNAK(err);
-            }
-          #endif
-            break;
-
-          /*case MMDVM_M17_LINK_SETUP:
-            if (m_m17Enable) {
-              if (m_modemState == STATE_IDLE || m_modemState == STATE_M17)
-                err = m17TX.writeData(m_buffer + 3U, m_len - 3U);
-            }
-            if (err == 0U) {
-              if (m_modemState == STATE_IDLE)
-                setMode(STATE_M17);
-            } else {
-              DEBUG2("Received invalid M17 link setup data", err);
-              sendNAK(err);
-            }
-            break;
-
-          
-         
-          case MMDVM_M17_STREAM:
-            if (m_m17Enable) {
-              if (m_modemState == STATE_IDLE || m_modemState == STATE_M17)
-                err = m17TX.writeData(m_buffer + 3U, m_len - 3U);
-            }
-            if (err == 0U) {
-              if (m_modemState == STATE_IDLE)
-                setMode(STATE_M17);
-            } else {
-              DEBUG2("Received invalid M17 stream data", err);
-              sendNAK(err);
-            }
-            break;
-
-          case MMDVM_M17_EOT:
-            if (m_m17Enable) {
-              if (m_modemState == STATE_IDLE || m_modemState == STATE_M17)
-                err = m17TX.writeData(m_buffer + 3U, m_len - 3U);
-            }
-            if (err == 0U) {
-              if (m_modemState == STATE_IDLE)
-                setMode(STATE_M17);
-            } else {
-              DEBUG2("Received invalid M17 EOT", err);
-              sendNAK(err);
-            }
-            break;
-*/
+  // Drop a partial frame once the host has gone quiet, otherwise a stray
+  // frame start leaves the parser waiting on bytes that never come
+  if (m_ptr > 0U && (millis() - m_lastRX) >= SERIAL_FRAME_TIMEOUT) {
+    DEBUG2("SerialPort: dropped partial frame, bytes", m_ptr);
+    m_ptr = 0U;
+    m_len = 0U;
+  }
 
-          case MMDVM_TRANSPARENT:
-          case MMDVM_QSO_INFO:
-            // Do nothing on the MMDVM.
-            break;
+  while ((n = readInt(1U, data, SERIAL_READ_LENGTH)) > 0U) {
+    m_lastRX = millis();
 
-#if defined(SERIAL_REPEATER) || defined(SERIAL_REPEATER_USART1)
-          case MMDVM_SERIAL:
-            writeInt(3U, m_buffer + 3U, m_len - 3U);
-            break;
-#endif
+    uint16_t i = 0U;
+    while (i < n) {
+      if (m_ptr == 0U) {
+        if (data[i] != MMDVM_FRAME_START) {
+          i++;
+          continue;
+        }
 
-          default:
-            // Handle this, send a NAK back
-            sendNAK(1U);
-            break;
+        if ((i + 1U) < n) {
+          uint8_t len = data[i + 1U];
+
+          // Too short to be a frame, resync on the next frame start
+          if (len < 3U) {
+            i++;
+            continue;
+          }
+
+          // A frame wholly inside this read is handled where it lies
+          if ((i + len) <= n) {
+            processMessage(data + i, len);
+            i += len;
+            continue;
+          }
         }
 
-        m_ptr = 0U;
+        m_buffer[0U] = MMDVM_FRAME_START;
+        m_ptr = 1U;
         m_len = 0U;
+        i++;
+      } else if (m_ptr == 1U) {
+        // Handle the frame length
+        if (data[i] < 3U) {
+          m_ptr = 0U;
+          i++;
+          continue;
+        }
+
+        m_len = m_buffer[1U] = data[i++];
+        m_ptr = 2U;
+      } else {
+        // Any other bytes are added to the buffer, as many as this read holds
+        uint16_t count = m_len - m_ptr;
+        if (count > (n - i))
+          count = n - i;
+
+        ::memcpy(m_buffer + m_ptr, data + i, count);
+        m_ptr += count;
+        i     += count;
+
+        // The full packet has been received, process it
+        if (m_ptr == m_len) {
+          processMessage(m_buffer, m_len);
+          m_ptr = 0U;
+          m_len = 0U;
+        }
       }
     }
   }
 
-  if (io.getWatchdog() >= 48000U) {
-    m_ptr = 0U;
-    m_len = 0U;
-  }
-
 #if defined(SERIAL_REPEATER) || defined(SERIAL_REPEATER_USART1)
   // Check for any incoming serial data from a device/screen on UART2
   //  !!Notice!! on powerup the Nextion screen dumps FF FF FF 88 FF FF FF to the serial port.
@@ -868,6 +1000,303 @@ void CSerialPort::process()
 #endif
 }
 
+void CSerialPort::processMessage(const uint8_t* data, uint8_t length)
+{
+  uint8_t command = data[2U];
+  uint8_t err     = 2U;
+
+  switch (command) {
+    case MMDVM_GET_STATUS:
+      getStatus();
+      break;
+
+    case MMDVM_GET_VERSION:
+      getVersion();
+      break;
+
+    case MMDVM_SET_CONFIG:
+      err = setConfig(data + 3U, length - 3U);
+      if (err == 0U)
+        sendACK(command);
+      else
+        sendNAK(command, err);
+      break;
+
+    case MMDVM_SET_MODE:
+      err = setMode(data + 3U, length - 3U);
+      if (err == 0U)
+        sendACK(command);
+      else
+        sendNAK(command, err);
+      break;
+
+    case MMDVM_SET_FREQ:
+      err = setFreq(data + 3U, length - 3U);
+      if (err == 0U)
+        sendACK(command);
+      else
+        sendNAK(command, err);
+      break;
+
+    case MMDVM_CAL_DATA:
+      if (m_calState == STATE_DMRCAL || m_calState == STATE_DMRDMO1K) {
+        err = calDMR.write(data + 3U, length - 3U);
+      }             else if (m_calState == STATE_RSSICAL || m_calState == STATE_INTCAL) {
+        err = 0U;
+      }
+      if (err == 0U) {
+        sendACK(command);
+      } else {
+        DEBUG2("Received invalid calibration data", err);
+        sendNAK(command, err);
+      }
+      break;
+
+    case MMDVM_SEND_CWID:
+      err = 5U;
+      if (m_modemState == STATE_IDLE) {
+        m_cwid_state = true;
+        io.ifConf(STATE_CWID, true);
+        err = cwIdTX.write(data + 3U, length - 3U);
+      }
+      if (err != 0U) {
+        DEBUG2("Invalid CW Id data", err);
+        sendNAK(command, err);
+      }
+      break;
+
+    case MMDVM_DMR_DATA1:
+    #if defined(DUPLEX)
+      if (m_dmrEnable) {
+        if (m_modemState == STATE_IDLE || m_modemState == STATE_DMR) {
+          if (m_duplex)
+            err = dmrTX.writeData1(data + 3U, length - 3U);
+        }
+      }
+      if (err == 0U) {
+        if (m_modemState == STATE_IDLE)
+          setMode(STATE_DMR);
+      } else {
+        DEBUG2("Received invalid DMR data", err);
+        sendNAK(command, err);
+      }
+    #endif
+      break;
+
+    case MMDVM_DMR_DATA2:
+      if (m_dmrEnable) {
+        if (m_modemState == STATE_IDLE || m_modemState == STATE_DMR) {
+        #if defined(DUPLEX)
+          if (m_duplex)
+            err = dmrTX.writeData2(data + 3U, length - 3U);
+          else
+            err = dmrDMOTX.writeData(data + 3U, length - 3U);
+        #else
+            err = dmrDMOTX.writeData(data + 3U, length - 3U);
+        #endif
+        }
+      }
+      if (err == 0U) {
+        if (m_modemState == STATE_IDLE)
+          setMode(STATE_DMR);
+      } else {
+        DEBUG2("Received invalid DMR data", err);
+        sendNAK(command, err);
+      }
+      break;
+
+
+    case MMDVM_DMR_SHORTLC:
+    #if defined(DUPLEX)
+      if (m_dmrEnable)
+        err = dmrTX.writeShortLC(data + 3U, length - 3U);
+      if (err != 0U) {
+        DEBUG2("Received invalid DMR Short LC", err);
+        sendNAK(command, err);
+      }
+    #endif
+      break;
+
+    case MMDVM_DMR_ABORT:
+    #if defined(DUPLEX)
+      if (m_dmrEnable)
+        err = dmrTX.writeAbort(data + 3U, length - 3U);
+      if (err != 0U) {
+        DEBUG2("Received invalid DMR Abort", err);
+        sendNAK(command, err);
+      }
+    #endif
+      break;
+
+    /*case MMDVM_M17_LINK_SETUP:
+      if (m_m17Enable) {
+        if (m_modemState == STATE_IDLE || m_modemState == STATE_M17)
+          err = m17TX.writeData(data + 3U, length - 3U);
+      }
+      if (err == 0U) {
+        if (m_modemState == STATE_IDLE)
+          setMode(STATE_M17);
+      } else {
+        DEBUG2("Received invalid M17 link setup data", err);
+        sendNAK(command, err);
+      }
+      break;
+
+    
+   
+    case MMDVM_M17_STREAM:
+      if (m_m17Enable) {
+        if (m_modemState == STATE_IDLE || m_modemState == STATE_M17)
+          err = m17TX.writeData(data + 3U, length - 3U);
+      }
+      if (err == 0U) {
+        if (m_modemState == STATE_IDLE)
+          setMode(STATE_M17);
+      } else {
+        DEBUG2("Received invalid M17 stream data", err);
+        sendNAK(command, err);
+      }
+      break;
+
+    case MMDVM_M17_EOT:
+      if (m_m17Enable) {
+        if (m_modemState == STATE_IDLE || m_modemState == STATE_M17)
+          err = m17TX.writeData(data + 3U, length - 3U);
+      }
+      if (err == 0U) {
+        if (m_modemState == STATE_IDLE)
+          setMode(STATE_M17);
+      } else {
+        DEBUG2("Received invalid M17 EOT", err);
+        sendNAK(command, err);
+      }
+      break;
+*/
+
+    case MMDVM_DMR_FILTER:
+    #if defined(DUPLEX)
+      err = dmrFilter.setFilter(data + 3U, length - 3U);
+    #endif
+      if (err == 0U) {
+        sendACK(command);
+      } else {
+        DEBUG2("Received invalid DMR filter", err);
+        sendNAK(command, err);
+      }
+      break;
+
+    case MMDVM_DMR_LAST_HEARD:
+      getLastHeard();
+      break;
+
+    case MMDVM_DMR_QUEUE_LATENCY:
+      // An optional non-zero byte clears the histogram after it is read
+      getQueueLatency(length > 3U && data[3U] != 0U);
+      break;
+
+    case MMDVM_SET_CHANNELS:
+      err = setChannels(data + 3U, length - 3U);
+      if (err == 0U) {
+        sendACK(command);
+      } else {
+        DEBUG2("Received invalid channel list", err);
+        sendNAK(command, err);
+      }
+      break;
+
+    case MMDVM_DMR_DUAL_RX:
+    #if defined(DUAL_RX)
+      err = setDualRX(data + 3U, length - 3U);
+    #endif
+      if (err == 0U) {
+        sendACK(command);
+      } else {
+        DEBUG2("Received invalid dual receive", err);
+        sendNAK(command, err);
+      }
+      break;
+
+    case MMDVM_DMR_QUALITY:
+    #if defined(DUPLEX)
+      err = setQuality(data + 3U, length - 3U);
+    #endif
+      if (err == 0U) {
+        sendACK(command);
+      } else {
+        DEBUG2("Received invalid DMR quality", err);
+        sendNAK(command, err);
+      }
+      break;
+
+    case MMDVM_DMR_CSBK_FILTER:
+    #if defined(DUPLEX)
+      err = dmrFilter.setCSBK(data + 3U, length - 3U);
+    #endif
+      if (err == 0U) {
+        sendACK(command);
+      } else {
+        DEBUG2("Received invalid CSBK filter", err);
+        sendNAK(command, err);
+      }
+      break;
+
+    case MMDVM_DMR_TRUNK:
+    #if defined(DUPLEX)
+      err = setTrunk(data + 3U, length - 3U);
+    #endif
+      if (err == 0U) {
+        sendACK(command);
+      } else {
+        DEBUG2("Received invalid trunk plan", err);
+        sendNAK(command, err);
+      }
+      break;
+
+    case MMDVM_DMR_TRUNK_STATUS:
+      // An optional non-zero byte clears the counters after they are read
+      getTrunk(length > 3U && data[3U] != 0U);
+      break;
+
+    case MMDVM_DMR_TX_BUFFER:
+    #if defined(DUPLEX)
+      err = dmrTX.setBuffer(data + 3U, length - 3U);
+    #endif
+      if (err == 0U) {
+        sendACK(command);
+      } else {
+        DEBUG2("Received invalid DMR TX buffer", err);
+        sendNAK(command, err);
+      }
+      break;
+
+    case MMDVM_DMR_TX_STATUS:
+      // An optional non-zero byte clears the counters after they are read
+      getTXBuffer(length > 3U && data[3U] != 0U);
+      break;
+
+    case MMDVM_IO_STATUS:
+      // An optional non-zero byte clears the worst cases after they are read
+      getIOStatus(length > 3U && data[3U] != 0U);
+      break;
+
+    case MMDVM_TRANSPARENT:
+    case MMDVM_QSO_INFO:
+      // Do nothing on the MMDVM.
+      break;
+
+#if defined(SERIAL_REPEATER) || defined(SERIAL_REPEATER_USART1)
+    case MMDVM_SERIAL:
+      writeInt(3U, data + 3U, length - 3U);
+      break;
+#endif
+
+    default:
+      // Handle this, send a NAK back
+      sendNAK(command, 1U);
+      break;
+  }
+}
+
 #if defined(SERIAL_REPEATER) || defined(SERIAL_REPEATER_USART1)
 void CSerialPort::writeSerialRpt(const uint8_t* data, uint8_t length)
 {
@@ -970,7 +1399,7 @@ void CSerialPort::writeDStarEOT()
   writeInt(1U, reply, 3);
 }
 
-void CSerialPort::writeDMRData(bool slot, const uint8_t* data, uint8_t length)
+void CSerialPort::writeDMRFrame(bool slot, uint8_t* data, uint8_t length, uint8_t receiver)
 {
 #if !defined(MS_MODE)
   if (m_modemState != STATE_DMR && m_modemState != STATE_IDLE)
@@ -982,30 +1411,40 @@ void CSerialPort::writeDMRData(bool slot, const uint8_t* data, uint8_t length)
 
 #if defined(ENABLE_DEBUG)
   if (m_debug) {
-    writeDebug("writeDMRData: Sending frame", slot, length);
+    writeDebug("writeDMRFrame: Sending frame", slot, length);
   }
 #endif
 
   if (length > 37U)
     length = 37U;
 
-  uint8_t reply[40U];
+#if defined(DUAL_RX)
+  if (receiver == 1U) {
+    uint8_t* reply = data - 4U;
 
-  reply[0U] = MMDVM_FRAME_START;
-  reply[1U] = 0U;
-  reply[2U] = slot ? MMDVM_DMR_DATA2 : MMDVM_DMR_DATA1;
+    reply[0U] = MMDVM_FRAME_START;
+    reply[1U] = length + 4U;
+    reply[2U] = MMDVM_DMR_DUAL_RX;
+    reply[3U] = slot ? 0x01U : 0x00U;
 
-  uint8_t count = 3U;
-  for (uint8_t i = 0U; i < length; i++, count++)
-    reply[count] = data[i];
+    writeInt(1U, reply, length + 4U);
+    return;
+  }
+#else
+  (void)receiver;
+#endif
 
-  reply[1U] = count;
+  uint8_t* reply = data - 3U;
 
-  writeInt(1U, reply, count);
+  reply[0U] = MMDVM_FRAME_START;
+  reply[1U] = length + 3U;
+  reply[2U] = slot ? MMDVM_DMR_DATA2 : MMDVM_DMR_DATA1;
+
+  writeInt(1U, reply, length + 3U);
 }
 
 
-void CSerialPort::writeDMRLost(bool slot)
+void CSerialPort::writeDMRLost(bool slot, uint8_t receiver)
 {
 #if !defined(MS_MODE)
   if (m_modemState != STATE_DMR && m_modemState != STATE_IDLE)
@@ -1015,6 +1454,22 @@ void CSerialPort::writeDMRLost(bool slot)
     return;
 #endif
 
+#if defined(DUAL_RX)
+  if (receiver == 1U) {
+    uint8_t reply[4U];
+
+    reply[0U] = MMDVM_FRAME_START;
+    reply[1U] = 4U;
+    reply[2U] = MMDVM_DMR_DUAL_RX;
+    reply[3U] = DUAL_RX_TAG_LOST | (slot ? 0x01U : 0x00U);
+
+    writeInt(1U, reply, 4);
+    return;
+  }
+#else
+  (void)receiver;
+#endif
+
   uint8_t reply[3U];
 
   reply[0U] = MMDVM_FRAME_START;
@@ -1179,7 +1634,7 @@ void CSerialPort::writeNXDNLost()
   writeInt(1U, reply, 3);
 }
 
-/*void CSerialPort::writeM17LinkSetup(const uint8_t* data, uint8_t length)
+void CSerialPort::writeM17LinkSetup(const uint8_t* data, uint8_t length)
 {
   if (m_modemState != STATE_M17 && m_modemState != STATE_IDLE)
     return;
@@ -1257,7 +1712,7 @@ void CSerialPort::writeM17Lost()
   reply[2U] = MMDVM_M17_LOST;
 
   writeInt(1U, reply, 3);
-}*/
+}
 
 #if defined(SEND_RSSI_DATA)
 
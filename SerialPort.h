@@ -39,8 +39,11 @@ public:
   void writeDStarLost();
   void writeDStarEOT();
 
-  void writeDMRData(bool slot, const uint8_t* data, uint8_t length);
-  void writeDMRLost(bool slot);
+  // The data must have DMR_FRAME_HEADROOM writable bytes in front of it,
+  // the serial header is built there and the frame is sent without a copy.
+  // Frames of the second receiver go out tagged under MMDVM_DMR_DUAL_RX.
+  void writeDMRFrame(bool slot, uint8_t* data, uint8_t length, uint8_t receiver = 0U);
+  void writeDMRLost(bool slot, uint8_t receiver = 0U);
 
   void writeYSFData(const uint8_t* data, uint8_t length);
   void writeYSFLost();
@@ -52,10 +55,10 @@ public:
   void writeNXDNData(const uint8_t* data, uint8_t length);
   void writeNXDNLost();
 
- // void writeM17LinkSetup(const uint8_t* data, uint8_t length);
- // void writeM17Stream(const uint8_t* data, uint8_t length);
- // void writeM17EOT();
- // void writeM17Lost();
+  void writeM17LinkSetup(const uint8_t* data, uint8_t length);
+  void writeM17Stream(const uint8_t* data, uint8_t length);
+  void writeM17EOT();
+  void writeM17Lost();
 
 #if defined(SEND_RSSI_DATA)
   void writeRSSIData(const uint8_t* data, uint8_t length);
@@ -74,25 +77,41 @@ private:
   uint8_t m_buffer[256U];
   uint8_t m_ptr;
   uint8_t m_len;
+  uint32_t m_lastRX;
   uint8_t m_serial_buffer[128U];
   uint8_t m_serial_len;
 
   bool    m_debug;
   bool    m_firstCal;
 
-  void    sendACK();
-  void    sendNAK(uint8_t err);
+  void    sendACK(uint8_t type);
+  void    sendNAK(uint8_t type, uint8_t err);
+  void    processMessage(const uint8_t* data, uint8_t length);
   void    getStatus();
   void    getVersion();
+  void    getLastHeard();
+  void    getQueueLatency(bool clear);
+  void    getTrunk(bool clear);
+  void    getTXBuffer(bool clear);
+  void    getIOStatus(bool clear);
   uint8_t setConfig(const uint8_t* data, uint8_t length);
   uint8_t setMode(const uint8_t* data, uint8_t length);
   void    setMode(MMDVM_STATE modemState);
   uint8_t setFreq(const uint8_t* data, uint8_t length);
+  uint8_t setChannels(const uint8_t* data, uint8_t length);
+#if defined(DUPLEX)
+  uint8_t setQuality(const uint8_t* data, uint8_t length);
+  uint8_t setTrunk(const uint8_t* data, uint8_t length);
+#endif
+#if defined(DUAL_RX)
+  uint8_t setDualRX(const uint8_t* data, uint8_t length);
+#endif
 
   // Hardware versions
   void    beginInt(uint8_t n, int speed);
   int     availableInt(uint8_t n);
   uint8_t readInt(uint8_t n);
+  uint16_t readInt(uint8_t n, uint8_t* data, uint16_t length);
   void    writeInt(uint8_t n, const uint8_t* data, uint16_t length, bool flush = false);
 };
 
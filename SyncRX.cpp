@@ -0,0 +1,152 @@
+/*
+ *   Copyright (C) 2015,2016,2017 by Jonathan Naylor G4KLX
+ *   Copyright (C) 2016,2017,2018 by Andy Uribe CA6JAU
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "Config.h"
+
+#if defined(MODE_YSF) || defined(MODE_P25) || defined(MODE_NXDN)
+
+#include "Globals.h"
+#include "SyncRX.h"
+#include "Utils.h"
+
+const uint8_t BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
+
+#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
+
+CSyncRX::CSyncRX() :
+m_decoder(NULL),
+m_synced(false),
+m_first(false),
+m_outBuffer(),
+m_buffer(NULL),
+m_bufferPtr(0U),
+m_endPtr(0U),
+m_lostCount(0U)
+{
+  m_buffer = m_outBuffer + 1U;
+}
+
+void CSyncRX::setDecoder(const SYNCRX_DECODER* decoder)
+{
+  m_decoder = decoder;
+
+  reset();
+}
+
+void CSyncRX::reset()
+{
+  m_synced    = false;
+  m_first     = false;
+  m_bufferPtr = 0U;
+  m_endPtr    = 0U;
+  m_lostCount = 0U;
+
+  ::memset(m_outBuffer, 0x00U, SYNCRX_FRAME_LENGTH_BYTES + 3U);
+}
+
+void CSyncRX::databit()
+{
+  if (m_decoder == NULL)
+    return;
+
+  // The newest bit is the bottom of the pattern register
+  uint64_t pattern = bitHistory.getPattern();
+
+  if (m_synced)
+    processData((pattern & 0x01U) == 0x01U, pattern);
+  else
+    processNone(pattern);
+}
+
+void CSyncRX::processNone(uint64_t pattern)
+{
+  // Fuzzy matching of the data sync bit sequence
+  if (countBits64((pattern & m_decoder->syncMask) ^ m_decoder->syncBits) > m_decoder->startErrs)
+    return;
+
+  DEBUG1("SyncRX: sync found in None");
+
+  for (uint8_t i = 0U; i < (m_decoder->syncLengthBits + 7U) / 8U; i++)
+    m_buffer[i] = m_decoder->syncBytes[i];
+
+  m_lostCount = m_decoder->maxLost;
+  m_bufferPtr = m_decoder->syncLengthBits;
+  m_endPtr    = m_decoder->frameLengthBits;
+  m_synced    = true;
+  m_first     = true;
+
+  io.setDecode(true);
+}
+
+void CSyncRX::processData(bool bit, uint64_t pattern)
+{
+  WRITE_BIT1(m_buffer, m_bufferPtr, bit);
+
+  m_bufferPtr++;
+  if (m_bufferPtr > m_endPtr) {
+    reset();
+    return;
+  }
+
+  uint16_t syncLength = m_decoder->syncLengthBits;
+
+  // Only search for a sync in the right place +-2 bits
+  if (m_bufferPtr >= (syncLength - 2U) && m_bufferPtr <= (syncLength + 2U)) {
+    // Fuzzy matching of the data sync bit sequence
+    if (countBits64((pattern & m_decoder->syncMask) ^ m_decoder->syncBits) <= m_decoder->runErrs) {
+      DEBUG2("SyncRX: found sync in Data, pos", m_bufferPtr - syncLength);
+      m_lostCount = m_decoder->maxLost;
+      m_bufferPtr = syncLength;
+    }
+  }
+
+  if (m_decoder->decode != NULL && m_bufferPtr == m_decoder->decodePos)
+    m_endPtr = m_decoder->decode(m_buffer, m_first);
+
+  // Send a frame to the host if the required number of bits have been received
+  if (m_bufferPtr == m_endPtr) {
+    m_lostCount--;
+    // We've not seen a data sync for too long, signal RXLOST and change to RX_NONE
+    if (m_lostCount == 0U) {
+      DEBUG1("SyncRX: sync timed out, lost lock");
+      io.setDecode(false);
+      m_decoder->lost();
+      reset();
+      return;
+    }
+
+    m_outBuffer[0U] = m_lostCount == (m_decoder->maxLost - 1U) ? 0x01U : 0x00U;
+    bool more = m_decoder->write(m_outBuffer, m_endPtr);
+
+    // Start the next frame
+    ::memset(m_outBuffer, 0x00U, SYNCRX_FRAME_LENGTH_BYTES + 3U);
+    m_bufferPtr = 0U;
+    m_endPtr    = m_decoder->frameLengthBits;
+    m_first     = false;
+
+    if (!more) {
+      io.setDecode(false);
+      reset();
+    }
+  }
+}
+
+#endif
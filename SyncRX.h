@@ -0,0 +1,88 @@
+/*
+ *   Copyright (C) 2015,2016,2017 by Jonathan Naylor G4KLX
+ *   Copyright (C) 2016,2017,2018 by Andy Uribe CA6JAU
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(SYNCRX_H)
+#define  SYNCRX_H
+
+#include <stdint.h>
+
+#if defined(MODE_YSF) || defined(MODE_P25) || defined(MODE_NXDN)
+#define SYNCRX_ENABLED
+#endif
+
+// Sized for the largest frame of the decoders built in
+#if defined(MODE_P25)
+#include "P25Defines.h"
+const uint16_t SYNCRX_FRAME_LENGTH_BYTES = P25_LDU_FRAME_LENGTH_BYTES;
+#elif defined(MODE_YSF)
+#include "YSFDefines.h"
+const uint16_t SYNCRX_FRAME_LENGTH_BYTES = YSF_FRAME_LENGTH_BYTES;
+#else
+#include "NXDNDefines.h"
+const uint16_t SYNCRX_FRAME_LENGTH_BYTES = NXDN_FRAME_LENGTH_BYTES;
+#endif
+
+// A frame synchronous protocol, the sync word is the first thing in every frame
+struct SYNCRX_DECODER {
+  uint64_t       syncBits;
+  uint64_t       syncMask;
+  const uint8_t* syncBytes;
+  uint8_t        syncLengthBits;
+  uint8_t        startErrs;
+  uint8_t        runErrs;
+  uint8_t        maxLost;
+  uint16_t       frameLengthBits;
+
+  // Optional, called once decodePos bits into each frame, returns the length of that frame in bits
+  uint16_t       decodePos;
+  uint16_t     (*decode)(const uint8_t* frame, bool first);
+
+  // data[0] is set when the frame carried a sync, returns false to end the transmission
+  bool         (*write)(uint8_t* data, uint16_t lengthBits);
+  void         (*lost)();
+};
+
+class CSyncRX {
+public:
+  CSyncRX();
+
+  void setDecoder(const SYNCRX_DECODER* decoder);
+
+  // Processes the newest bit in the shared bit history
+  void databit();
+
+  void reset();
+
+private:
+  const SYNCRX_DECODER* m_decoder;
+  bool                  m_synced;
+  bool                  m_first;
+  uint8_t               m_outBuffer[SYNCRX_FRAME_LENGTH_BYTES + 3U];
+  uint8_t*              m_buffer;
+  uint16_t              m_bufferPtr;
+  uint16_t              m_endPtr;
+  uint8_t               m_lostCount;
+
+  void processNone(uint64_t pattern);
+  void processData(bool bit, uint64_t pattern);
+};
+
+#endif
@@ -68,8 +68,24 @@ uint8_t countBits64(uint64_t bits)
 
 #if !defined(ARDUINO)
 extern uint32_t get_watchdog_count();
+extern uint32_t get_tick_count();
+// From the free running bit clock (19200 ticks/s, 96 ticks per 5 ms), the
+// remainder is carried so the count stays monotonic across tick wraps.
+// The carried state is updated without masking interrupts, so this is for
+// the main loop only; an interrupt handler reads get_tick_count() instead.
 uint32_t mmdvm_millis() {
-  return get_watchdog_count() / 10;
+  static uint32_t lastTicks = 0U;
+  static uint32_t ms = 0U;
+  static uint32_t rem = 0U;
+
+  uint32_t ticks = get_tick_count();
+  uint64_t acc = uint64_t(ticks - lastTicks) * 5U + rem;
+  lastTicks = ticks;
+
+  ms += uint32_t(acc / 96U);
+  rem = uint32_t(acc % 96U);
+
+  return ms;
 }
 long mmdvm_random(long min, long max) {
   return min + (get_watchdog_count() % (max - min));
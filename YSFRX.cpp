@@ -0,0 +1,66 @@
+/*
+ *   Copyright (C) 2009-2017 by Jonathan Naylor G4KLX
+ *   Copyright (C) 2016,2017,2018 by Andy Uribe CA6JAU
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Config.h"
+
+#if defined(MODE_YSF)
+
+#include "Globals.h"
+#include "YSFRX.h"
+
+static bool writeData(uint8_t* data, uint16_t lengthBits)
+{
+  uint8_t length = (lengthBits / 8U) + 1U;
+
+#if defined(SEND_RSSI_DATA)
+  uint16_t rssi = io.readRSSI();
+
+  data[length + 0U] = (rssi >> 8) & 0xFFU;
+  data[length + 1U] = (rssi >> 0) & 0xFFU;
+
+  serial.writeYSFData(data, length + 2U);
+#else
+  serial.writeYSFData(data, length);
+#endif
+
+  return true;
+}
+
+static void writeLost()
+{
+  serial.writeYSFLost();
+}
+
+const SYNCRX_DECODER YSF_DECODER = {
+  YSF_SYNC_BITS,
+  YSF_SYNC_BITS_MASK,
+  YSF_SYNC_BYTES,
+  YSF_SYNC_LENGTH_BITS,
+  2U,                               // Sync bit errors to start
+  4U,                               // Sync bit errors while running
+  1U + 1U,                          // Frames without sync before lost
+  YSF_FRAME_LENGTH_BITS,
+  0U,
+  NULL,
+  writeData,
+  writeLost
+};
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// CBPTC19696::decode() on any 33-byte burst. Whatever it corrects the input
+// to, encoding that payload again gives a burst it decodes to the same
+// payload with nothing to correct.
+
+#include "Config.h"
+#include "Globals.h"
+#include "BPTC19696.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  if (size != DMR_FRAME_LENGTH_BYTES)
+    return 0;
+
+  CBPTC19696 bptc;
+
+  uint8_t payload[12U];
+  bptc.decode(data, payload);
+
+  uint8_t burst[DMR_FRAME_LENGTH_BYTES];
+  ::memcpy(burst, data, DMR_FRAME_LENGTH_BYTES);
+  bptc.encode(payload, burst);
+
+  uint8_t again[12U];
+  if (bptc.decode(burst, again) != 0U || ::memcmp(payload, again, 12U) != 0)
+    ::abort();
+
+  return 0;
+}
@@ -0,0 +1,43 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// CDMRLC::decode() on a burst as the slot receiver hands it over, the
+// control byte first and then the 33 bytes. The low nibble of the control
+// byte is taken as the data type, so the header and terminator masks and
+// the types without one are all covered.
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRLC.h"
+
+#include <stdlib.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  if (size != (1U + DMR_FRAME_LENGTH_BYTES))
+    return 0;
+
+  DMRLC_T lc;
+  if (CDMRLC::decode(data, data[0U] & 0x0FU, &lc)) {
+    // Only IDs in range get through
+    if (lc.srcId == 0U || lc.srcId > 16777215U || lc.dstId == 0U || lc.dstId > 16777215U)
+      ::abort();
+  }
+
+  return 0;
+}
@@ -0,0 +1,303 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Stand-in for libFuzzer where the compiler has none, as with g++. It runs
+// the harness over every input named on the command line, files or
+// directories of them, then over -runs=N blind mutations of those inputs.
+// There is no coverage feedback, so nothing is added to the corpus. An
+// input that trips a sanitizer, aborts or hangs is left in crash-N or
+// timeout-N, as libFuzzer would leave it.
+//
+// Options, as libFuzzer takes them: -runs=N, -seed=N, -max_len=N and
+// -timeout=N in seconds
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <sanitizer/common_interface_defs.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv) __attribute__((weak));
+
+const uint32_t MAX_INPUTS = 4096U;
+
+struct INPUT_T {
+  uint8_t* data;
+  size_t   size;
+};
+
+static INPUT_T  inputs[MAX_INPUTS];
+static uint32_t inputCount = 0U;
+
+static uint32_t runs    = 0U;
+static uint32_t seed    = 1U;
+static size_t   maxLen  = 4096U;
+static uint32_t timeout = 10U;
+
+// The input being run, for the crash file
+static const uint8_t* current     = NULL;
+static size_t         currentSize = 0U;
+static uint32_t       currentRun  = 0U;
+
+static void writeInput(const char* prefix)
+{
+  char name[32U];
+  ::snprintf(name, sizeof(name), "%s-%u", prefix, currentRun);
+
+  int fd = ::open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd >= 0) {
+    if (currentSize > 0U && ::write(fd, current, currentSize) < 0)
+      ::perror(name);
+    ::close(fd);
+  }
+
+  ::fprintf(stderr, "== input written to %s\n", name);
+}
+
+static void onDeath()
+{
+  writeInput("crash");
+}
+
+static void onSignal(int sig)
+{
+  if (sig == SIGALRM) {
+    ::fprintf(stderr, "== timeout after %u s\n", timeout);
+    writeInput("timeout");
+  } else {
+    writeInput("crash");
+  }
+
+  ::_exit(1);
+}
+
+static void addInput(const char* path)
+{
+  FILE* fp = ::fopen(path, "rb");
+  if (fp == NULL) {
+    ::perror(path);
+    ::exit(1);
+  }
+
+  uint8_t* data = (uint8_t*)::malloc(maxLen > 0U ? maxLen : 1U);
+  size_t size = ::fread(data, 1U, maxLen, fp);
+  ::fclose(fp);
+
+  if (inputCount == MAX_INPUTS) {
+    ::fprintf(stderr, "%s: more than %u inputs\n", path, MAX_INPUTS);
+    ::exit(1);
+  }
+
+  inputs[inputCount].data = data;
+  inputs[inputCount].size = size;
+  inputCount++;
+}
+
+static void addPath(const char* path)
+{
+  struct stat st;
+  if (::stat(path, &st) != 0) {
+    ::perror(path);
+    ::exit(1);
+  }
+
+  if (!S_ISDIR(st.st_mode)) {
+    addInput(path);
+    return;
+  }
+
+  DIR* dir = ::opendir(path);
+  struct dirent* entry;
+  while ((entry = ::readdir(dir)) != NULL) {
+    if (entry->d_name[0U] == '.')
+      continue;
+
+    char name[1024U];
+    ::snprintf(name, sizeof(name), "%s/%s", path, entry->d_name);
+    addPath(name);
+  }
+  ::closedir(dir);
+}
+
+// xorshift32, reproducible from -seed
+static uint32_t pick(uint32_t range)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+
+  return range > 0U ? seed % range : 0U;
+}
+
+// Values that sit on the edges of length checks and the frame start
+static const uint8_t INTERESTING[] = {0x00U, 0x01U, 0x02U, 0x03U, 0x7FU, 0x80U, 0xE0U, 0xFEU, 0xFFU};
+
+static size_t mutate(uint8_t* data, size_t size)
+{
+  uint32_t count = 1U + pick(4U);
+
+  for (uint32_t n = 0U; n < count; n++) {
+    switch (pick(7U)) {
+      case 0U:
+        if (size > 0U)
+          data[pick(size)] ^= 0x01U << pick(8U);
+        break;
+
+      case 1U:
+        if (size > 0U)
+          data[pick(size)] = uint8_t(pick(256U));
+        break;
+
+      case 2U:
+        if (size > 0U)
+          data[pick(size)] = INTERESTING[pick(sizeof(INTERESTING))];
+        break;
+
+      case 3U:
+        if (size < maxLen) {
+          size_t pos = pick(size + 1U);
+          ::memmove(data + pos + 1U, data + pos, size - pos);
+          data[pos] = uint8_t(pick(256U));
+          size++;
+        }
+        break;
+
+      case 4U:
+        if (size > 1U) {
+          size_t pos = pick(size);
+          ::memmove(data + pos, data + pos + 1U, size - pos - 1U);
+          size--;
+        }
+        break;
+
+      case 5U:
+        // A run of the input over another part of it
+        if (size > 1U) {
+          size_t from = pick(size);
+          size_t to   = pick(size);
+          size_t len  = 1U + pick(size - (from > to ? from : to));
+          ::memmove(data + to, data + from, len);
+        }
+        break;
+
+      default: {
+          // A run of another input spliced in
+          const INPUT_T& other = inputs[pick(inputCount)];
+          if (other.size > 0U && size > 0U) {
+            size_t from = pick(other.size);
+            size_t to   = pick(size);
+            size_t len  = 1U + pick(other.size - from);
+            if (to + len > size)
+              len = size - to;
+            ::memcpy(data + to, other.data + from, len);
+          }
+        }
+        break;
+    }
+  }
+
+  return size;
+}
+
+// Each run gets a buffer of exactly its size, so the sanitizer sees a read
+// past the end of the input
+static void runOne(const uint8_t* data, size_t size)
+{
+  uint8_t* copy = (uint8_t*)::malloc(size > 0U ? size : 1U);
+  ::memcpy(copy, data, size);
+
+  current     = copy;
+  currentSize = size;
+
+  ::alarm(timeout);
+  LLVMFuzzerTestOneInput(copy, size);
+  ::alarm(0U);
+
+  ::free(copy);
+  currentRun++;
+}
+
+int main(int argc, char** argv)
+{
+  if (LLVMFuzzerInitialize != NULL)
+    LLVMFuzzerInitialize(&argc, &argv);
+
+  for (int i = 1; i < argc; i++) {
+    if (::sscanf(argv[i], "-runs=%u", &runs) == 1 || ::sscanf(argv[i], "-seed=%u", &seed) == 1 ||
+        ::sscanf(argv[i], "-max_len=%zu", &maxLen) == 1 || ::sscanf(argv[i], "-timeout=%u", &timeout) == 1)
+      continue;
+
+    if (argv[i][0U] == '-') {
+      ::fprintf(stderr, "%s: unknown option %s\n", argv[0U], argv[i]);
+      return 1;
+    }
+  }
+
+  for (int i = 1; i < argc; i++) {
+    if (argv[i][0U] != '-')
+      addPath(argv[i]);
+  }
+
+  if (seed == 0U)
+    seed = 1U;
+  uint32_t firstSeed = seed;
+
+  __sanitizer_set_death_callback(onDeath);
+  ::signal(SIGABRT, onSignal);
+  ::signal(SIGALRM, onSignal);
+
+  for (uint32_t i = 0U; i < inputCount; i++)
+    runOne(inputs[i].data, inputs[i].size);
+
+  ::printf("%u inputs replayed\n", inputCount);
+
+  if (runs > 0U) {
+    if (inputCount == 0U) {
+      // Nothing to start from, one empty input to grow
+      inputs[0U].data = NULL;
+      inputs[0U].size = 0U;
+      inputCount = 1U;
+    }
+
+    uint8_t* data = (uint8_t*)::malloc(maxLen > 0U ? maxLen : 1U);
+
+    for (uint32_t n = 0U; n < runs; n++) {
+      const INPUT_T& base = inputs[pick(inputCount)];
+      size_t size = base.size < maxLen ? base.size : maxLen;
+      if (size > 0U)
+        ::memcpy(data, base.data, size);
+
+      size = mutate(data, size);
+      runOne(data, size);
+    }
+
+    ::free(data);
+
+    ::printf("%u mutations run, seed %u\n", runs, firstSeed);
+  }
+
+  return 0;
+}
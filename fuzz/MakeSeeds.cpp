@@ -0,0 +1,253 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Writes the seed corpus of each harness into corpus/, from the synthetic
+// BS downlink of the host tests and the host protocol frames MMDVMHost sends
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRDownlink.h"
+#include "BPTC19696.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <sys/stat.h>
+
+// The frames of the host protocol, as in SerialPort.cpp
+const uint8_t  MMDVM_FRAME_START  = 0xE0U;
+const uint8_t  MMDVM_GET_VERSION  = 0x00U;
+const uint8_t  MMDVM_GET_STATUS   = 0x01U;
+const uint8_t  MMDVM_SET_CONFIG   = 0x02U;
+const uint8_t  MMDVM_SET_MODE     = 0x03U;
+const uint8_t  MMDVM_SET_FREQ     = 0x04U;
+const uint8_t  MMDVM_DMR_DATA2    = 0x1AU;
+const uint8_t  MMDVM_SET_CHANNELS = 0xA2U;
+
+const uint8_t  CONTROL_VOICE = 0x20U;
+const uint8_t  CONTROL_DATA  = 0x40U;
+
+const uint32_t FREQUENCY = 433450000U;
+const uint32_t CHANNEL_FREQ[] = {433450000U, 433462500U, 433475000U};
+
+// Of a call on slot 1 with one superframe, as CDMRDownlink sends it
+const uint8_t  CALL_BURSTS = 8U;
+
+// The RX chain seeds, 24 bursts or 720 ms on air
+const uint8_t  RX_BURSTS = 24U;
+
+static const char* dir = "corpus";
+static uint16_t files = 0U;
+
+static void write(const char* harness, const char* name, const uint8_t* data, uint16_t length)
+{
+  char path[256U];
+  ::snprintf(path, sizeof(path), "%s/%s", dir, harness);
+  ::mkdir(path, 0755);
+
+  ::snprintf(path, sizeof(path), "%s/%s/%s", dir, harness, name);
+  FILE* fp = ::fopen(path, "wb");
+  if (fp == NULL) {
+    ::perror(path);
+    return;
+  }
+
+  ::fwrite(data, 1U, length, fp);
+  ::fclose(fp);
+  files++;
+}
+
+static uint16_t frame(uint8_t* out, uint8_t command, const uint8_t* data, uint8_t length)
+{
+  out[0U] = MMDVM_FRAME_START;
+  out[1U] = length + 3U;
+  out[2U] = command;
+  if (length > 0U)
+    ::memcpy(out + 3U, data, length);
+
+  return length + 3U;
+}
+
+static void put32(uint8_t* data, uint32_t value)
+{
+  data[0U] = value >> 0;
+  data[1U] = value >> 8;
+  data[2U] = value >> 16;
+  data[3U] = value >> 24;
+}
+
+// The bursts of a call on slot 1: the LC header, voice A to F and the
+// terminator, each behind its control byte as MMDVMHost sends them
+static void getCall(uint8_t bursts[CALL_BURSTS][1U + DMR_FRAME_LENGTH_BYTES])
+{
+  CDMRDownlink site(1U, 33U);
+  site.startCall(3100001U, 91U, 1U);
+
+  uint8_t data[DMR_DOWNLINK_BURST_BYTES];
+  for (uint8_t n = 0U; n < CALL_BURSTS; n++) {
+    uint8_t control;
+    if (n == 0U)
+      control = CONTROL_DATA | DT_VOICE_LC_HEADER;
+    else if (n == (CALL_BURSTS - 1U))
+      control = CONTROL_DATA | DT_TERMINATOR_WITH_LC;
+    else if (n == 1U)
+      control = CONTROL_VOICE;
+    else
+      control = n - 1U;
+
+    // Slot 1, then the idle burst of slot 2
+    site.getBurst(data);
+    bursts[n][0U] = control;
+    ::memcpy(bursts[n] + 1U, data + DMR_CACH_LENGTH_BYTES, DMR_FRAME_LENGTH_BYTES);
+    site.getBurst(data);
+  }
+}
+
+static void makeDecoders()
+{
+  uint8_t call[CALL_BURSTS][1U + DMR_FRAME_LENGTH_BYTES];
+  getCall(call);
+
+  CDMRDownlink idleSite(1U, 44U);
+  uint8_t idle[DMR_DOWNLINK_BURST_BYTES];
+  idleSite.getBurst(idle);
+
+  uint8_t data[1U + DMR_FRAME_LENGTH_BYTES];
+
+  write("BPTCFuzz", "header", call[0U] + 1U, DMR_FRAME_LENGTH_BYTES);
+  write("BPTCFuzz", "terminator", call[CALL_BURSTS - 1U] + 1U, DMR_FRAME_LENGTH_BYTES);
+  write("BPTCFuzz", "idle", idle + DMR_CACH_LENGTH_BYTES, DMR_FRAME_LENGTH_BYTES);
+
+  data[0U] = DT_VOICE_LC_HEADER;
+  ::memcpy(data + 1U, call[0U] + 1U, DMR_FRAME_LENGTH_BYTES);
+  write("DMRLCFuzz", "header", data, sizeof(data));
+
+  data[0U] = DT_TERMINATOR_WITH_LC;
+  ::memcpy(data + 1U, call[CALL_BURSTS - 1U] + 1U, DMR_FRAME_LENGTH_BYTES);
+  write("DMRLCFuzz", "terminator", data, sizeof(data));
+
+  data[0U] = DT_IDLE;
+  ::memcpy(data + 1U, idle + DMR_CACH_LENGTH_BYTES, DMR_FRAME_LENGTH_BYTES);
+  write("DMRLCFuzz", "idle", data, sizeof(data));
+
+  // The LCs, with the masks of the header and the terminator taken off
+  CBPTC19696 bptc;
+  uint8_t lc[12U];
+  bptc.decode(call[0U] + 1U, lc);
+  lc[9U] ^= 0x96U; lc[10U] ^= 0x96U; lc[11U] ^= 0x96U;
+  write("RS129Fuzz", "header", lc, sizeof(lc));
+
+  bptc.decode(call[CALL_BURSTS - 1U] + 1U, lc);
+  lc[9U] ^= 0x99U; lc[10U] ^= 0x99U; lc[11U] ^= 0x99U;
+  write("RS129Fuzz", "terminator", lc, sizeof(lc));
+}
+
+static void makeRX()
+{
+  uint8_t data[RX_BURSTS * DMR_DOWNLINK_BURST_BYTES];
+
+  CDMRDownlink idleSite(1U, 55U);
+  for (uint8_t n = 0U; n < RX_BURSTS; n++)
+    idleSite.getBurst(data + n * DMR_DOWNLINK_BURST_BYTES);
+  write("RXFuzz", "idle", data, sizeof(data));
+
+  // Idle for four bursts, then the call from the fifth
+  CDMRDownlink site(1U, 66U);
+  for (uint8_t n = 0U; n < RX_BURSTS; n++) {
+    if (n == 4U)
+      site.startCall(3100002U, 91U, 1U);
+    site.getBurst(data + n * DMR_DOWNLINK_BURST_BYTES);
+  }
+  write("RXFuzz", "call", data, sizeof(data));
+}
+
+static void makeSerial()
+{
+  uint8_t out[1024U];
+  uint8_t data[64U];
+  uint16_t length;
+
+  length = frame(out, MMDVM_GET_VERSION, NULL, 0U);
+  write("SerialFuzz", "get-version", out, length);
+
+  length = frame(out, MMDVM_GET_STATUS, NULL, 0U);
+  write("SerialFuzz", "get-status", out, length);
+
+  // Duplex DMR on colour code 1, TX delay 10 and the DMR level at 50%
+  uint8_t config[23U];
+  ::memset(config, 0x00U, sizeof(config));
+  config[1U]  = 0x02U;
+  config[2U]  = 10U;
+  config[3U]  = STATE_DMR;
+  config[6U]  = 1U;
+  config[10U] = 128U;
+  uint16_t configLength = frame(out, MMDVM_SET_CONFIG, config, sizeof(config));
+  write("SerialFuzz", "set-config", out, configLength);
+
+  // Older hosts stop after the DMR level
+  length = frame(out, MMDVM_SET_CONFIG, config, 11U);
+  write("SerialFuzz", "set-config-short", out, length);
+
+  ::memset(data, 0x00U, sizeof(data));
+  put32(data + 1U, FREQUENCY);
+  put32(data + 5U, FREQUENCY);
+  data[9U] = 255U;
+  put32(data + 10U, FREQUENCY);
+  length = frame(out, MMDVM_SET_FREQ, data, 14U);
+  write("SerialFuzz", "set-freq", out, length);
+
+  data[0U] = STATE_DMR;
+  length = frame(out, MMDVM_SET_MODE, data, 1U);
+  write("SerialFuzz", "set-mode", out, length);
+
+  data[0U] = 200U;
+  data[1U] = 0U;
+  data[2U] = sizeof(CHANNEL_FREQ) / sizeof(uint32_t);
+  for (uint8_t i = 0U; i < data[2U]; i++)
+    put32(data + 3U + i * 4U, CHANNEL_FREQ[i]);
+  length = frame(out, MMDVM_SET_CHANNELS, data, 3U + data[2U] * 4U);
+  write("SerialFuzz", "set-channels", out, length);
+
+  uint8_t call[CALL_BURSTS][1U + DMR_FRAME_LENGTH_BYTES];
+  getCall(call);
+
+  length = frame(out, MMDVM_DMR_DATA2, call[0U], sizeof(call[0U]));
+  write("SerialFuzz", "dmr-data2", out, length);
+
+  // A session as MMDVMHost opens it, then a call to send
+  length = frame(out, MMDVM_SET_CONFIG, config, sizeof(config));
+  length += frame(out + length, MMDVM_SET_MODE, config + 3U, 1U);
+  for (uint8_t n = 0U; n < CALL_BURSTS; n++)
+    length += frame(out + length, MMDVM_DMR_DATA2, call[n], sizeof(call[n]));
+  write("SerialFuzz", "session", out, length);
+}
+
+int main(int argc, char** argv)
+{
+  if (argc > 1)
+    dir = argv[1U];
+  ::mkdir(dir, 0755);
+
+  makeDecoders();
+  makeRX();
+  makeSerial();
+
+  ::printf("%u seeds written to %s\n", files, dir);
+
+  return 0;
+}
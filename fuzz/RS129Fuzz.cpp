@@ -0,0 +1,50 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// CRS129::check() on any 12-byte LC. The code has a distance of four, so no
+// single changed byte of an LC that passes gives another that passes.
+
+#include "Config.h"
+#include "Globals.h"
+#include "RS129.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  if (size != 12U)
+    return 0;
+
+  if (!CRS129::check(data))
+    return 0;
+
+  uint8_t lc[12U];
+  for (uint8_t i = 0U; i < 12U; i++) {
+    ::memcpy(lc, data, 12U);
+    lc[i] ^= 0x01U << (i % 8U);
+    if (CRS129::check(lc))
+      ::abort();
+
+    lc[i] = data[i] ^ 0xFFU;
+    if (CRS129::check(lc))
+      ::abort();
+  }
+
+  return 0;
+}
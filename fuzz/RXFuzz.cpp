@@ -0,0 +1,79 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// The DMR receive chain from the demodulated bits on: the frame sync, the
+// slot receiver, the slot type, BPTC, LC, Short LC and CSBK decoders, and
+// the frames to the host. Each input byte is eight bits on air, the first
+// in the MSB, and both chips receive them.
+
+#include "Config.h"
+#include "Globals.h"
+#include "Host.h"
+
+const uint32_t FREQUENCY = 433450000U;
+
+// The replies and the bus log are not checked here, only kept from filling
+static void drain()
+{
+  uint8_t reply[256U];
+  while (hostSerialRead(reply, sizeof(reply)) > 0U)
+    ;
+
+  hostBusClear();
+}
+
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv)
+{
+  hostReset();
+
+  m_duplex     = true;
+  m_modemState = STATE_DMR;
+
+  io.setFreq(FREQUENCY, FREQUENCY, 255U, FREQUENCY);
+  io.ifConf(STATE_DMR, true);
+  io.start();
+#if defined(DUPLEX)
+  dmrRX.setColorCode(1U);
+#else
+  dmrDMORX.setColorCode(1U);
+#endif
+
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  // Each input starts with the receiver hunting for sync
+#if defined(DUPLEX)
+  dmrRX.reset();
+#else
+  dmrDMORX.reset();
+#endif
+
+  for (size_t i = 0U; i < size; i++) {
+    for (uint8_t n = 0U; n < 8U; n++) {
+      uint8_t bit = (data[i] >> (7U - n)) & 0x01U;
+      hostClockBit(bit, bit);
+    }
+
+    hostLoop();
+    drain();
+  }
+
+  return 0;
+}
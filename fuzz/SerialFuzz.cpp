@@ -0,0 +1,81 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// The MMDVM host protocol: CSerialPort::process() and every command behind
+// it, fed the input as bytes from the host. The modem runs on after each
+// input for longer than the frame timeout, so what the commands started
+// gets clocked and a partial frame does not carry over to the next input.
+
+#include "Config.h"
+#include "Globals.h"
+#include "Host.h"
+
+const uint32_t FREQUENCY = 433450000U;
+
+// As the UART hands them over between two passes of the main loop
+const uint16_t CHUNK_LENGTH = 64U;
+
+// 110 ms of ticks, past SERIAL_FRAME_TIMEOUT
+const uint16_t IDLE_BITS = 2112U;
+
+// The replies and the bus log are not checked here, only kept from filling
+static void drain()
+{
+  uint8_t reply[256U];
+  while (hostSerialRead(reply, sizeof(reply)) > 0U)
+    ;
+
+  hostBusClear();
+}
+
+extern "C" int LLVMFuzzerInitialize(int* argc, char*** argv)
+{
+  hostReset();
+
+  m_modemState = STATE_DMR;
+
+  io.setFreq(FREQUENCY, FREQUENCY, 255U, FREQUENCY);
+  io.ifConf(STATE_DMR, true);
+  io.start();
+  serial.start();
+
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  for (size_t i = 0U; i < size; i += CHUNK_LENGTH) {
+    size_t length = size - i;
+    if (length > CHUNK_LENGTH)
+      length = CHUNK_LENGTH;
+
+    hostSerialWrite(data + i, length);
+    hostLoop();
+    drain();
+  }
+
+  for (uint16_t n = 0U; n < IDLE_BITS; n++) {
+    hostClockBit(0U, 0U);
+    if ((n % 8U) == 7U) {
+      hostLoop();
+      drain();
+    }
+  }
+
+  return 0;
+}
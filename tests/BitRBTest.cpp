@@ -0,0 +1,149 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// CBitRB::putBytes() against put() a bit at a time: random bursts written
+// to two rings, one each way, from every bit offset the CW ID can leave the
+// ring at, with the reader taking bits between them and the ring wrapping
+// and filling up. Both rings must give back the same bits, the same control
+// marks around the bytes and the same fill.
+
+#include "Config.h"
+#include "BitRB.h"
+#include "Test.h"
+
+// An odd number of bytes, so the wrap falls at every point of a burst
+const uint16_t RING_BITS = 8U * 41U;
+
+const uint16_t BURSTS = 2000U;
+
+// A CACH and a burst, the most written here in one call
+const uint16_t MAX_BURST_BYTES = 36U;
+
+static uint32_t seed = 1U;
+
+static uint32_t random(uint32_t range)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+
+  return seed % range;
+}
+
+// Bits with control marks, as the CW ID or a calibration tone writes them
+static void putBits(CBitRB& a, CBitRB& b, uint16_t count)
+{
+  for (uint16_t i = 0U; i < count; i++) {
+    uint8_t bit     = uint8_t(random(2U));
+    uint8_t control = uint8_t(random(2U));
+    CHECK(a.put(bit, control) == b.put(bit, control));
+  }
+
+  CHECK(a.hasOverflowed() == b.hasOverflowed());
+}
+
+// A burst, whole bytes as long as they fit in the second ring
+static uint16_t putBurst(CBitRB& a, CBitRB& b, uint16_t length)
+{
+  uint8_t data[MAX_BURST_BYTES];
+  for (uint16_t i = 0U; i < length; i++)
+    data[i] = uint8_t(random(256U));
+
+  uint16_t stored = a.putBytes(data, length);
+
+  uint16_t fit = b.getSpace() / 8U;
+  if (fit > length)
+    fit = length;
+
+  for (uint16_t i = 0U; i < fit; i++) {
+    for (uint8_t n = 0U; n < 8U; n++)
+      b.put((data[i] >> (7U - n)) & 0x01U, 0U);
+  }
+
+  CHECK(stored == fit);
+  CHECK(a.hasOverflowed() == (fit < length));
+
+  return stored;
+}
+
+// Takes bits from both, as the TX interrupt would
+static uint16_t getBits(CBitRB& a, CBitRB& b, uint16_t count)
+{
+  uint16_t differ = 0U;
+
+  for (uint16_t i = 0U; i < count; i++) {
+    uint8_t bitA = 0U, controlA = 0U, bitB = 0U, controlB = 0U;
+    bool gotA = a.get(bitA, controlA);
+    bool gotB = b.get(bitB, controlB);
+
+    CHECK(gotA == gotB);
+    if (!gotA)
+      break;
+
+    if (bitA != bitB || controlA != controlB)
+      differ++;
+  }
+
+  return differ;
+}
+
+static void testOffset(uint8_t offset)
+{
+  CBitRB a(RING_BITS), b(RING_BITS);
+
+  // The ring left off a byte boundary by a writer before the bursts
+  putBits(a, b, offset);
+
+  uint32_t bytes = 0U, full = 0U;
+  uint16_t differ = 0U;
+
+  for (uint16_t n = 0U; n < BURSTS; n++) {
+    uint16_t stored = putBurst(a, b, 1U + random(MAX_BURST_BYTES));
+    bytes += stored;
+
+    if (a.getSpace() < 8U)
+      full++;
+
+    // Now and then another few marked bits, which move the offset
+    if (random(16U) == 0U)
+      putBits(a, b, random(8U));
+
+    CHECK(a.getData() == b.getData() && a.getSpace() == b.getSpace());
+
+    // The reader keeps up, or falls behind and lets the ring fill
+    differ += getBits(a, b, random(2U * MAX_BURST_BYTES * 8U));
+  }
+
+  differ += getBits(a, b, RING_BITS);
+  CHECK(a.getData() == 0U && b.getData() == 0U);
+
+  uint32_t wraps = (bytes * 8U) / RING_BITS;
+
+  ::printf("offset %u: %u bytes, full %u times, %u wraps, %u bits differ\n", offset, bytes, full, wraps, differ);
+
+  CHECK(full > 0U && wraps > 0U);
+  CHECK(differ == 0U);
+}
+
+int main()
+{
+  for (uint8_t offset = 0U; offset < 8U; offset++)
+    testOffset(offset);
+
+  return testResult();
+}
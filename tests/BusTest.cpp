@@ -0,0 +1,160 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Register traffic of CIO::ifConf() on the host bus
+
+#include "Config.h"
+#include "Globals.h"
+#include "Host.h"
+#include "Test.h"
+
+extern uint32_t ADF7021_RX_REG0;
+
+const uint32_t FREQUENCY = 433450000U;
+
+// Bit mask of the registers written to a chip, and checks every word was
+// latched by the chip it was meant for
+static uint16_t written(int8_t chip)
+{
+  uint16_t regs = 0U;
+
+  for (uint16_t n = 0U; n < hostBusCount(); n++) {
+    const HOST_BUS_T& t = hostBus(n);
+    CHECK(!t.readback);
+    CHECK(t.bits == 32U);
+    CHECK(t.chip >= 0);
+
+    if (t.chip == chip)
+      regs |= 1U << (t.word & 0x0FU);
+  }
+
+  return regs;
+}
+
+static uint16_t regMask(const uint8_t* regs, uint8_t count)
+{
+  uint16_t mask = 0U;
+  for (uint8_t i = 0U; i < count; i++)
+    mask |= 1U << regs[i];
+
+  return mask;
+}
+
+static void report(const char* name, uint64_t startNs)
+{
+  ::printf("%-26s %3u words, %6.1f us on the bus, %6.2f ms in all\n", name, hostBusCount(),
+           double(hostBusNanos()) / 1000.0, double(hostNanos() - startNs) / 1000000.0);
+}
+
+static void testCold()
+{
+  hostReset();
+  m_duplex = false;
+
+  CHECK(io.setFreq(FREQUENCY, FREQUENCY, 255U, FREQUENCY) == 0U);
+
+  uint64_t start = hostNanos();
+  io.ifConf(STATE_DMR, true);
+  report("cold DMR", start);
+
+  // Every register the driver uses, 0 from setRX() in between, and 9 only
+  // with one of the AD7021_GAIN_ options
+#if defined(AD7021_GAIN_AUTO) || defined(AD7021_GAIN_AUTO_LIN) || defined(AD7021_GAIN_LOW) || defined(AD7021_GAIN_HIGH)
+  const uint8_t order[] = {1U, 3U, 4U, 6U, 5U, 0U, 2U, 14U, 9U, 10U, 11U, 12U, 13U, 15U};
+#else
+  const uint8_t order[] = {1U, 3U, 4U, 6U, 5U, 0U, 2U, 14U, 10U, 11U, 12U, 13U, 15U};
+#endif
+  CHECK(hostBusCount() == sizeof(order));
+  for (uint8_t i = 0U; i < sizeof(order) && i < hostBusCount(); i++)
+    CHECK((hostBus(i).word & 0x0FU) == order[i]);
+
+  CHECK(written(0) == regMask(order, sizeof(order)));
+  CHECK(written(1) == 0U);
+  CHECK(hostReg(0U, 0U) == ADF7021_RX_REG0);
+
+  // Each word is shifted and latched in full
+  CHECK(hostBusNanos() == sizeof(order) * (32U * HOST_BUS_BIT_NS + HOST_BUS_LATCH_NS));
+
+  // The CE reset and the coarse IF calibration
+  CHECK((hostNanos() - start) >= (600000U + 10000000U));
+}
+
+static void testWarm()
+{
+  hostBusClear();
+
+  // Same mode again, the chip holds all of it
+  uint64_t start = hostNanos();
+  io.ifConf(STATE_DMR, true);
+  report("warm DMR", start);
+
+  // Only register 0, which setRX() always writes
+  CHECK(hostBusCount() == 1U);
+  CHECK(written(0) == 1U);
+  CHECK((hostNanos() - start) == hostBusNanos());
+}
+
+static void testModeChange()
+{
+  hostBusClear();
+
+  // Without the reset only the registers that differ are written
+  uint64_t start = hostNanos();
+  io.ifConf(STATE_DSTAR, false);
+  report("DMR to D-Star, no reset", start);
+
+  uint16_t regs = written(0);
+  const uint8_t changed[] = {0U, 2U, 3U, 4U, 5U, 10U, 13U};
+  CHECK((regs & regMask(changed, sizeof(changed))) == regMask(changed, sizeof(changed)));
+
+  const uint8_t same[] = {1U, 6U, 11U, 12U, 14U, 15U};
+  CHECK((regs & regMask(same, sizeof(same))) == 0U);
+
+  // A changed IF needs the calibration again
+  CHECK((hostNanos() - start) >= 10000000U);
+}
+
+#if defined(DUPLEX)
+static void testDuplex()
+{
+  hostReset();
+  m_duplex = true;
+
+  uint64_t start = hostNanos();
+  io.ifConf(STATE_DMR, true);
+  report("cold DMR duplex", start);
+
+  // The second chip gets its own set up and receives
+  CHECK(written(1) != 0U);
+  CHECK(hostReg(1U, 0U) == ADF7021_RX_REG0);
+
+  m_duplex = false;
+}
+#endif
+
+int main()
+{
+  testCold();
+  testWarm();
+  testModeChange();
+#if defined(DUPLEX)
+  testDuplex();
+#endif
+
+  return testResult();
+}
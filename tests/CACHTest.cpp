@@ -0,0 +1,242 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// The CACHs CDMRTX sends, taken off the air and read back with the
+// receiver's decoders: the TACT has the slot of the next burst and the
+// Short LC fragments in order, and the Short LC is the one the host sent,
+// the one before it until the next whole one. A bit error in the TACT, or
+// in the Hamming rows of the Short LC, is corrected.
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRDownlink.h"
+#include "DMRShortLC.h"
+#include "Host.h"
+#include "Test.h"
+
+#include <string.h>
+
+#if defined(DUPLEX)
+
+const uint32_t FREQUENCY = 433450000U;
+
+// The frames of the host protocol, as in SerialPort.cpp
+const uint8_t  MMDVM_FRAME_START = 0xE0U;
+const uint8_t  MMDVM_DMR_DATA2   = 0x1AU;
+const uint8_t  MMDVM_DMR_SHORTLC = 0x1CU;
+
+const uint8_t  CONTROL_DATA = 0x40U;
+
+// Group voice, in the Short LC Act_Updt
+const uint8_t  ACTIVITY_GROUP_VOICE = 0x08U;
+
+// A CACH and a burst, the sync at bit 108 of the burst
+const uint16_t BURST_BITS = 288U;
+const uint16_t SYNC_START = 108U;
+const uint16_t CACH_START = 264U;
+
+// The host sends a TS2 frame every two bursts
+const uint16_t FRAMES = 16U;
+
+// The host loop runs every this many bits
+const uint8_t  LOOP_BITS = 8U;
+
+const uint8_t  CACH_LCSS[] = {DMR_LCSS_FIRST, DMR_LCSS_CONTINUATION, DMR_LCSS_CONTINUATION, DMR_LCSS_LAST};
+
+const uint32_t TX_BITS = (FRAMES + 16U) * 2U * BURST_BITS;
+
+static uint8_t tx[TX_BITS];
+
+static void sendFrame(uint8_t command, const uint8_t* data, uint8_t length)
+{
+  uint8_t frame[3U + DMR_FRAME_LENGTH_BYTES + 1U];
+  frame[0U] = MMDVM_FRAME_START;
+  frame[1U] = 3U + length;
+  frame[2U] = command;
+  ::memcpy(frame + 3U, data, length);
+
+  hostSerialWrite(frame, 3U + length);
+}
+
+static void sendCSBK(uint16_t n)
+{
+  uint8_t data[DMR_FRAME_LENGTH_BYTES + 1U];
+  data[0U] = CONTROL_DATA | DT_CSBK;
+  for (uint8_t i = 1U; i < sizeof(data); i++)
+    data[i] = uint8_t(n * 37U + i);
+
+  sendFrame(MMDVM_DMR_DATA2, data, sizeof(data));
+}
+
+static void setUp()
+{
+  hostReset();
+
+  m_duplex     = true;
+  m_modemState = STATE_DMR;
+
+  CHECK(io.setFreq(FREQUENCY, FREQUENCY, 255U, FREQUENCY) == 0U);
+  io.ifConf(STATE_DMR, true);
+  io.start();
+}
+
+// The bits of the first chip, from before the transmitter keys to after it
+// drops. The host sends a busy Short LC, then an idle one half way through.
+static void transmit()
+{
+  CDMRDownlink site;
+  uint8_t shortLC[9U];
+
+  site.getShortLC(ACTIVITY_GROUP_VOICE, shortLC);
+  sendFrame(MMDVM_DMR_SHORTLC, shortLC, sizeof(shortLC));
+
+  uint16_t sent = 0U;
+  for (uint32_t n = 0U; n < TX_BITS; n++) {
+    if ((n % (2U * BURST_BITS)) == 0U && sent < FRAMES) {
+      sendCSBK(sent++);
+
+      if (sent == FRAMES / 2U) {
+        site.getShortLC(0x00U, shortLC);
+        sendFrame(MMDVM_DMR_SHORTLC, shortLC, sizeof(shortLC));
+      }
+    }
+
+    tx[n] = hostClockBit(0U, 0U);
+
+    if ((n % LOOP_BITS) == (LOOP_BITS - 1U))
+      hostLoop();
+  }
+}
+
+static bool isSync(uint32_t pos)
+{
+  uint64_t pattern = 0U;
+  for (uint8_t i = 0U; i < DMR_SYNC_LENGTH_BITS; i++)
+    pattern = (pattern << 1) | tx[pos + i];
+
+  return pattern == DMR_MS_DATA_SYNC_BITS || pattern == DMR_MS_VOICE_SYNC_BITS;
+}
+
+static void getCACH(uint32_t pos, bool* cach)
+{
+  for (uint8_t i = 0U; i < 24U; i++)
+    cach[i] = tx[pos + i] != 0U;
+}
+
+// Every one bit error in the CACH, TACT or Short LC, is corrected
+static void testErrors(const bool* cach, bool tc, uint8_t lcss)
+{
+  uint8_t failed = 0U;
+
+  for (uint8_t i = 0U; i < 24U; i++) {
+    bool c[24U];
+    ::memcpy(c, cach, sizeof(c));
+    c[i] = !c[i];
+
+    bool tc2;
+    uint8_t lcss2;
+    if (!CDMRShortLC::decodeTACT(c, tc2, lcss2) || tc2 != tc || lcss2 != lcss)
+      failed++;
+  }
+
+  CHECK(failed == 0U);
+}
+
+int main()
+{
+  setUp();
+  transmit();
+
+  // The first burst on air, slot 1 after the key up
+  uint32_t first = 0U;
+  while (first < (TX_BITS - DMR_SYNC_LENGTH_BITS) && !isSync(first))
+    first++;
+  CHECK(first >= SYNC_START && first < TX_BITS - BURST_BITS);
+  first -= SYNC_START;
+
+  CDMRShortLC receiver;
+  uint16_t cachs = 0U, shortLCs = 0U, busy = 0U, idle = 0U;
+  bool idleSeen = false, busyAfterIdle = false;
+
+  // Every CACH that follows a burst on air
+  for (uint32_t pos = first; (pos + BURST_BITS) <= TX_BITS && isSync(pos + SYNC_START); pos += BURST_BITS, cachs++) {
+    bool cach[24U];
+    getCACH(pos + CACH_START, cach);
+
+    // The burst that follows is on the other slot
+    bool tc;
+    uint8_t lcss;
+    CHECK(CDMRShortLC::decodeTACT(cach, tc, lcss));
+    CHECK(tc == ((cachs % 2U) == 0U));
+    CHECK(lcss == CACH_LCSS[cachs % 4U]);
+
+    if (cachs < 4U)
+      testErrors(cach, tc, lcss);
+
+    // One error in each Short LC, in the first fragment where bits 4n + 3
+    // land in the row of column parity, which is checked but not corrected
+    if (lcss == DMR_LCSS_FIRST) {
+      uint8_t i = (cachs / 4U) % 17U;
+      if ((i % 4U) == 3U)
+        i--;
+
+      uint8_t n = DMR_CACH_PAYLOAD[i];
+      cach[n] = !cach[n];
+    }
+
+    if (!receiver.decode(cach))
+      continue;
+
+    shortLCs++;
+
+    uint8_t activity1, activity2;
+    CHECK(receiver.getActivity(0U, activity1) && receiver.getActivity(1U, activity2));
+    CHECK(activity2 == 0x00U);
+
+    if (activity1 == ACTIVITY_GROUP_VOICE) {
+      busy++;
+      busyAfterIdle = busyAfterIdle || idleSeen;
+    } else {
+      CHECK(activity1 == 0x00U);
+      idle++;
+      idleSeen = true;
+    }
+  }
+
+  ::printf("%u CACHs, %u Short LCs, %u busy then %u idle\n", cachs, shortLCs, busy, idle);
+
+  // The key up to the hang time after the last frame
+  CHECK(cachs >= 2U * FRAMES);
+
+  // A whole Short LC every four CACHs, and none of them mixed up
+  CHECK(shortLCs == cachs / 4U);
+  CHECK(busy > 0U && idle > 0U && !busyAfterIdle);
+
+  return testResult();
+}
+
+#else
+
+int main()
+{
+  ::printf("needs DUPLEX\n");
+
+  return testResult();
+}
+
+#endif
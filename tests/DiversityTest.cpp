@@ -0,0 +1,210 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Both receivers on one DMR downlink, each fed its own copy with independent
+// bit errors. The same calls and the same errors are run twice, with the
+// second receiver reported apart and with the two combined, and the
+// combined run loses fewer LC headers. Built with DUAL_RX on top of
+// Config.h.
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRDownlink.h"
+#include "DMRLC.h"
+#include "Host.h"
+#include "Test.h"
+
+#include <string.h>
+
+#if defined(DUAL_RX) && defined(DUPLEX)
+
+const uint32_t FREQUENCY = 433450000U;
+
+// The frames of the host protocol, as in SerialPort.cpp
+const uint8_t  MMDVM_FRAME_START = 0xE0U;
+const uint8_t  MMDVM_ACK         = 0x70U;
+const uint8_t  MMDVM_DMR_DATA1   = 0x18U;
+const uint8_t  MMDVM_DMR_DATA2   = 0x1AU;
+const uint8_t  MMDVM_DMR_DUAL_RX = 0xA4U;
+
+// The host loop runs every this many bits
+const uint8_t  LOOP_BITS = 8U;
+
+const uint16_t CALLS = 100U;
+
+// Bit error rates, in 1/1000
+const uint16_t BER[] = {20U, 40U};
+
+static uint8_t  reply[256U];
+static uint16_t replyLen = 0U;
+static uint8_t  acked = 0U;
+
+static uint32_t callSrcId = 0U;
+static uint16_t headers = 0U;
+
+static uint32_t noiseA = 1U;
+static uint32_t noiseB = 1U;
+
+// The frames the modem sends to the host, main downlink headers counted by
+// the LC of the call on air
+static void readHost()
+{
+  uint8_t c;
+  while (hostSerialRead(&c, 1U) == 1U) {
+    if (replyLen == 0U && c != MMDVM_FRAME_START)
+      continue;
+
+    reply[replyLen++] = c;
+    if (replyLen < 3U || replyLen < reply[1U])
+      continue;
+
+    if (reply[2U] == MMDVM_ACK && replyLen >= 4U)
+      acked = reply[3U];
+
+    // Without SEND_RSSI_DATA the burst goes as it is, without the control byte
+    if (reply[2U] == MMDVM_DMR_DATA1 || reply[2U] == MMDVM_DMR_DATA2) {
+      uint8_t data[1U + DMR_FRAME_LENGTH_BYTES];
+      data[0U] = 0x00U;
+      ::memcpy(data + 1U, reply + replyLen - DMR_FRAME_LENGTH_BYTES, DMR_FRAME_LENGTH_BYTES);
+
+      DMRLC_T lc;
+      if (CDMRLC::decode(data, DT_VOICE_LC_HEADER, &lc) && lc.srcId == callSrcId)
+        headers++;
+    }
+
+    replyLen = 0U;
+  }
+}
+
+static uint8_t error(uint32_t& seed, uint16_t ber)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+
+  return (seed % 1000U) < ber ? 1U : 0U;
+}
+
+// The main receiver is on the second chip, the first one takes the other copy
+static void run(CDMRDownlink& site, uint16_t ber, uint32_t bits)
+{
+  for (uint32_t n = 0U; n < bits; n++) {
+    uint8_t bit = site.getBit();
+    uint8_t a = bit ^ error(noiseA, ber);
+    uint8_t b = bit ^ error(noiseB, ber);
+
+    hostClockBit(b, a);
+
+    if ((n % LOOP_BITS) == (LOOP_BITS - 1U)) {
+      hostLoop();
+      readHost();
+    }
+  }
+}
+
+static void setDualRX(bool diversity)
+{
+  const uint8_t frame[] = {MMDVM_FRAME_START, 9U, MMDVM_DMR_DUAL_RX,
+                           uint8_t(FREQUENCY >> 0), uint8_t(FREQUENCY >> 8), uint8_t(FREQUENCY >> 16), uint8_t(FREQUENCY >> 24),
+                           1U, uint8_t(diversity ? 0x01U : 0x00U)};
+
+  acked = 0U;
+  hostSerialWrite(frame, sizeof(frame));
+  hostLoop();
+  readHost();
+
+  CHECK(acked == MMDVM_DMR_DUAL_RX);
+  CHECK(dmrDiversity.isEnabled() == diversity);
+}
+
+static void setUp()
+{
+  hostReset();
+
+  m_duplex     = true;
+  m_modemState = STATE_DMR;
+
+  CHECK(io.setFreq(FREQUENCY, FREQUENCY, 255U, FREQUENCY) == 0U);
+  io.ifConf(STATE_DMR, true);
+  io.start();
+  dmrRX.setColorCode(1U);
+}
+
+// The headers lost out of CALLS calls, each with one header and a superframe
+// of voice, from the same downlink and the same errors on every run
+static uint16_t headersLost(bool diversity, uint16_t ber)
+{
+  setDualRX(diversity);
+
+  CDMRDownlink site(1U, 7U);
+  noiseA = 0x12345678U;
+  noiseB = 0x9ABCDEF1U;
+
+  // Sync on the idle downlink first, without errors
+  run(site, 0U, 20U * 288U);
+
+  uint16_t lost = 0U;
+  for (uint16_t n = 0U; n < CALLS; n++) {
+    callSrcId = 1000U + n;
+    headers = 0U;
+
+    site.startCall(callSrcId, 91U, 1U);
+    while (site.inCall())
+      run(site, ber, 288U);
+    run(site, ber, 4U * 288U);
+
+    // One copy of each burst, whichever receiver it came from
+    CHECK(headers <= 1U);
+    if (headers == 0U)
+      lost++;
+  }
+
+  return lost;
+}
+
+int main()
+{
+  setUp();
+
+  for (uint8_t i = 0U; i < sizeof(BER) / sizeof(BER[0U]); i++) {
+    uint16_t single    = headersLost(false, BER[i]);
+    uint16_t diversity = headersLost(true, BER[i]);
+
+    ::printf("%u.%u%% BER: %u of %u headers lost with one receiver, %u with both\n", BER[i] / 10U, BER[i] % 10U,
+             single, CALLS, diversity);
+
+    CHECK(diversity < single);
+  }
+
+  // Without errors nothing is lost either way
+  CHECK(headersLost(false, 0U) == 0U);
+  CHECK(headersLost(true, 0U) == 0U);
+
+  return testResult();
+}
+
+#else
+
+int main()
+{
+  ::printf("needs DUAL_RX and DUPLEX\n");
+
+  return testResult();
+}
+
+#endif
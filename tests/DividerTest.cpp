@@ -0,0 +1,203 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// The REG0 and REG1 words the chips latch, from ifConf() and from a scan
+// channel list, and the TX REG0 the first chip latches when it keys up,
+// against the single precision float maths the dividers used to be
+// computed with, every 125 Hz across every band
+
+#include "Config.h"
+#include "Globals.h"
+#include "ADF7021.h"
+#include "Host.h"
+#include "Test.h"
+
+#include <math.h>
+
+extern uint32_t ADF7021_TX_REG0;
+
+#if defined(DUPLEX) && defined(ENABLE_SCAN_MODE)
+
+struct BAND_T {
+  const char* name;
+  uint32_t    min;
+  uint32_t    max;
+};
+
+const BAND_T BANDS[] = {
+  {"VHF1", VHF1_MIN, VHF1_MAX},
+  {"VHF2", VHF2_MIN, VHF2_MAX},
+  {"UHF1", UHF1_MIN, UHF1_MAX},
+  {"UHF2", UHF2_MIN, UHF2_MAX}
+};
+
+// Every 5 kHz and 6.25 kHz channel, and all between
+const uint32_t STEP = 125U;
+
+// The RX chip in duplex, the TX one listens on the same REG0 until it keys up
+const uint8_t RX_CHIP = 1U;
+const uint8_t TX_CHIP = 0U;
+
+struct WORDS_T {
+  uint32_t reg1;
+  uint32_t rxReg0;
+  uint32_t txReg0;
+};
+
+// As ifConf() had it, with the PFD a double
+static void floatWords(uint32_t frequency, int32_t afcOffset, WORDS_T& words)
+{
+  uint8_t div2;
+  if ((frequency >= VHF1_MIN) && (frequency < VHF1_MAX)) {
+    words.reg1 = ADF7021_REG1_VHF1;
+    div2 = 1U;
+  } else if ((frequency >= VHF2_MIN) && (frequency < VHF2_MAX)) {
+    words.reg1 = ADF7021_REG1_VHF2;
+    div2 = 1U;
+  } else if ((frequency >= UHF1_MIN) && (frequency < UHF1_MAX)) {
+    words.reg1 = ADF7021_REG1_UHF1;
+    div2 = 1U;
+  } else if ((frequency >= UHF2_MIN) && (frequency < UHF2_MAX)) {
+    words.reg1 = ADF7021_REG1_UHF2;
+    div2 = 2U;
+  } else {
+    words.reg1 = ADF7021_REG1_UHF1;
+    div2 = 1U;
+  }
+
+  const double pfd = double(ADF7021_PFD);
+
+  float divider;
+  if (div2 == 1U)
+    divider = (frequency - 100000 + afcOffset) / (pfd / 2U);
+  else
+    divider = (frequency - 100000 + (2 * afcOffset)) / pfd;
+
+  uint8_t  n = floor(divider);
+  divider = (divider - n) * 32768;
+  uint16_t f = floor(divider + 0.5);
+
+#if defined(BIDIR_DATA_PIN)
+  words.rxReg0 = (uint32_t) 0b01001 << 27;
+#else
+  words.rxReg0 = (uint32_t) 0b01011 << 27;
+#endif
+  words.rxReg0 |= (uint32_t) n << 19;
+  words.rxReg0 |= (uint32_t) f << 4;
+
+  if (div2 == 1U)
+    divider = frequency / (pfd / 2U);
+  else
+    divider = frequency / pfd;
+
+  n = floor(divider);
+  divider = (divider - n) * 32768;
+  f = floor(divider + 0.5);
+
+#if defined(BIDIR_DATA_PIN)
+  words.txReg0 = (uint32_t) 0b01000 << 27;
+#else
+  words.txReg0 = (uint32_t) 0b01010 << 27;
+#endif
+  words.txReg0 |= (uint32_t) n << 19;
+  words.txReg0 |= (uint32_t) f << 4;
+}
+
+static bool banned(uint32_t frequency)
+{
+#if !defined(DISABLE_FREQ_BAN)
+  return ((frequency >= BAN1_MIN) && (frequency <= BAN1_MAX)) || ((frequency >= BAN2_MIN) && (frequency <= BAN2_MAX));
+#else
+  (void)frequency;
+  return false;
+#endif
+}
+
+static void setUp()
+{
+  hostReset();
+
+  m_duplex     = true;
+  m_modemState = STATE_DMR;
+
+  io.start();
+}
+
+// Every frequency of a band: REG0 and REG1 from ifConf() and the TX REG0 it
+// leaves for the switch, and the REG0 of the same channel in a scan list
+static void testBand(const BAND_T& band)
+{
+  uint32_t count = 0U, failed = 0U;
+
+  for (uint32_t frequency = band.min; frequency < band.max; frequency += STEP) {
+    if (banned(frequency))
+      continue;
+
+    WORDS_T want;
+    floatWords(frequency, AFC_OFFSET_DMR, want);
+
+    hostBusClear();
+    CHECK(io.setFreq(frequency, frequency, 255U, frequency) == 0U);
+    io.ifConf(STATE_DMR, false);
+
+    // TurnTest has the TX chip latch ADF7021_TX_REG0 on the switch
+    bool same = hostReg(RX_CHIP, 1U) == want.reg1 && hostReg(RX_CHIP, 0U) == want.rxReg0 &&
+                hostReg(TX_CHIP, 1U) == want.reg1 && hostReg(TX_CHIP, 0U) == want.rxReg0 &&
+                ADF7021_TX_REG0 == want.txReg0;
+
+    hostBusClear();
+    CHECK(io.setChannels(&frequency, 1U, 1000U) == 0U);
+    same = same && hostReg(RX_CHIP, 0U) == want.rxReg0;
+    io.setChannels(NULL, 0U, 0U);
+
+    if (!same) {
+      if (failed < 4U)
+        ::printf("%u Hz: REG1 %08X REG0 %08X/%08X, float maths %08X REG0 %08X/%08X\n", frequency,
+                 hostReg(RX_CHIP, 1U), hostReg(RX_CHIP, 0U), ADF7021_TX_REG0, want.reg1, want.rxReg0, want.txReg0);
+      failed++;
+    }
+
+    count++;
+  }
+
+  ::printf("%s: %u frequencies, %u differ\n", band.name, count, failed);
+
+  CHECK(count > 0U);
+  CHECK(failed == 0U);
+}
+
+int main()
+{
+  setUp();
+
+  for (uint8_t i = 0U; i < sizeof(BANDS) / sizeof(BANDS[0U]); i++)
+    testBand(BANDS[i]);
+
+  return testResult();
+}
+
+#else
+
+int main()
+{
+  ::printf("needs DUPLEX and ENABLE_SCAN_MODE\n");
+
+  return testResult();
+}
+
+#endif
@@ -0,0 +1,285 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// The TX jitter buffer set with MMDVM_DMR_TX_BUFFER: voice calls sent from
+// the host a frame every 60 ms, each frame late by a random jitter. While
+// the jitter stays inside the prefill, 60 ms for each frame after the first,
+// the transmitter never runs dry. A frame later than that leaves a gap, and
+// MMDVM_DMR_TX_STATUS counts the underrun and the idle bursts sent in it.
+
+#include "Config.h"
+#include "Globals.h"
+#include "Host.h"
+#include "Test.h"
+
+#include <string.h>
+
+#if defined(DUPLEX)
+
+const uint32_t FREQUENCY = 433450000U;
+
+// The frames of the host protocol, as in SerialPort.cpp
+const uint8_t  MMDVM_FRAME_START   = 0xE0U;
+const uint8_t  MMDVM_ACK           = 0x70U;
+const uint8_t  MMDVM_DMR_DATA2     = 0x1AU;
+const uint8_t  MMDVM_DMR_TX_BUFFER = 0xA9U;
+const uint8_t  MMDVM_DMR_TX_STATUS = 0xAAU;
+
+const uint8_t  CONTROL_VOICE = 0x20U;
+const uint8_t  CONTROL_DATA  = 0x40U;
+
+// The hang times as the firmware starts
+const uint8_t  HANG_VOICE      = 20U;
+const uint8_t  HANG_DATA       = 10U;
+const uint8_t  HANG_TERMINATOR = 5U;
+
+// The host sends a TS2 frame every 60 ms
+const uint32_t FRAME_MS = 60U;
+const uint64_t FRAME_NS = FRAME_MS * 1000000U;
+
+// A header, three superframes and a terminator
+const uint8_t  CALL_FRAMES = 1U + 3U * 6U + 1U;
+
+// The frame held back in testLate(), mid-call
+const uint8_t  LATE_FRAME = 8U;
+
+// Calls sent at each prefill
+const uint8_t  CALLS = 10U;
+
+// Longer than the hang time after a terminator
+const uint64_t HANG_NS = 1000000000U;
+
+// The host loop runs every this many bits
+const uint8_t  LOOP_BITS = 8U;
+
+static uint32_t seed = 1U;
+
+static uint8_t  reply[256U];
+static uint16_t replyLen = 0U;
+static uint8_t  acked = 0U;
+
+static uint8_t  status[3U + DMR_TX_STATUS_LENGTH];
+static bool     statusRead = false;
+
+static uint32_t random(uint32_t range)
+{
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+
+  return seed % range;
+}
+
+static void readHost()
+{
+  uint8_t c;
+  while (hostSerialRead(&c, 1U) == 1U) {
+    if (replyLen == 0U && c != MMDVM_FRAME_START)
+      continue;
+
+    reply[replyLen++] = c;
+    if (replyLen < 3U || replyLen < reply[1U])
+      continue;
+
+    if (reply[2U] == MMDVM_ACK && replyLen >= 4U)
+      acked = reply[3U];
+
+    if (reply[2U] == MMDVM_DMR_TX_STATUS && replyLen == sizeof(status)) {
+      ::memcpy(status, reply, sizeof(status));
+      statusRead = true;
+    }
+
+    replyLen = 0U;
+  }
+}
+
+static void run(uint64_t until)
+{
+  while (hostNanos() < until) {
+    for (uint8_t n = 0U; n < LOOP_BITS; n++)
+      hostClockBit(0U, 0U);
+
+    hostLoop();
+    readHost();
+  }
+}
+
+static uint16_t field(uint8_t n)
+{
+  return (status[3U + n] << 8) | status[4U + n];
+}
+
+// Reads the status, then clears the counters
+static void readStatus()
+{
+  const uint8_t request[] = {MMDVM_FRAME_START, 4U, MMDVM_DMR_TX_STATUS, 1U};
+
+  statusRead = false;
+  hostSerialWrite(request, sizeof(request));
+  hostLoop();
+  readHost();
+
+  CHECK(statusRead);
+}
+
+static void setBuffer(uint8_t prefill)
+{
+  const uint8_t frame[] = {MMDVM_FRAME_START, 7U, MMDVM_DMR_TX_BUFFER, prefill, HANG_VOICE, HANG_DATA, HANG_TERMINATOR};
+
+  acked = 0U;
+  hostSerialWrite(frame, sizeof(frame));
+  hostLoop();
+  readHost();
+
+  CHECK(acked == MMDVM_DMR_TX_BUFFER);
+}
+
+static void sendFrame(uint8_t n)
+{
+  uint8_t frame[3U + DMR_FRAME_LENGTH_BYTES + 1U];
+  frame[0U] = MMDVM_FRAME_START;
+  frame[1U] = sizeof(frame);
+  frame[2U] = MMDVM_DMR_DATA2;
+
+  if (n == 0U)
+    frame[3U] = CONTROL_DATA | DT_VOICE_LC_HEADER;
+  else if (n == (CALL_FRAMES - 1U))
+    frame[3U] = CONTROL_DATA | DT_TERMINATOR_WITH_LC;
+  else if (((n - 1U) % 6U) == 0U)
+    frame[3U] = CONTROL_VOICE;
+  else
+    frame[3U] = (n - 1U) % 6U;
+
+  for (uint8_t i = 4U; i < sizeof(frame); i++)
+    frame[i] = uint8_t(n * 37U + i);
+
+  hostSerialWrite(frame, sizeof(frame));
+}
+
+// A call whose frames leave the host up to jitter ms after their time, in
+// order, and one frame mid-call a further late ms, then the hang time after
+// it. Returns the most any frame was late by.
+static uint32_t sendCall(uint32_t jitter, uint32_t late)
+{
+  uint64_t start = hostNanos();
+  uint64_t last  = start;
+  uint64_t most  = 0U;
+
+  for (uint8_t n = 0U; n < CALL_FRAMES; n++) {
+    uint64_t due = start + n * FRAME_NS;
+
+    uint64_t at = due + uint64_t(random(jitter + 1U)) * 1000000U;
+    if (n == LATE_FRAME)
+      at += uint64_t(late) * 1000000U;
+    if (at < last)
+      at = last;
+    last = at;
+
+    if ((at - due) > most)
+      most = at - due;
+
+    run(at);
+    sendFrame(n);
+  }
+
+  run(hostNanos() + HANG_NS);
+
+  return uint32_t(most / 1000000U);
+}
+
+// Calls with the frames as late as the prefill holds, none of which may
+// run the FIFO dry
+static void testJitter(uint8_t prefill)
+{
+  setBuffer(prefill);
+  readStatus();
+
+  uint32_t jitter = (prefill - 1U) * FRAME_MS;
+
+  uint32_t most = 0U;
+  for (uint8_t i = 0U; i < CALLS; i++) {
+    uint32_t late = sendCall(jitter, 0U);
+    if (late > most)
+      most = late;
+  }
+
+  readStatus();
+
+  ::printf("prefill %u, %3u ms of jitter: %u calls, peak %u frames, %u underruns, %u idle bursts\n",
+           prefill, most, CALLS, status[8U], field(6U), field(8U));
+
+  CHECK(status[3U] == prefill);
+  CHECK(status[7U] == 0U);
+  CHECK(status[8U] >= prefill);
+  CHECK(field(6U) == 0U && field(8U) == 0U);
+}
+
+// A call with one frame later than the prefill holds, which leaves a gap of
+// idle bursts in it
+static void testLate(uint8_t prefill, uint8_t frames)
+{
+  setBuffer(prefill);
+  readStatus();
+
+  uint32_t late = (prefill - 1U + frames) * FRAME_MS;
+  sendCall(0U, late);
+
+  readStatus();
+
+  ::printf("prefill %u, one frame %3u ms late: %u underruns, %u idle bursts\n", prefill, late, field(6U), field(8U));
+
+  CHECK(field(6U) == 1U);
+  CHECK(field(8U) >= frames && field(8U) <= frames + 1U);
+}
+
+static void setUp()
+{
+  hostReset();
+
+  m_duplex     = true;
+  m_modemState = STATE_DMR;
+
+  CHECK(io.setFreq(FREQUENCY, FREQUENCY, 255U, FREQUENCY) == 0U);
+  io.ifConf(STATE_DMR, true);
+  io.start();
+}
+
+int main()
+{
+  setUp();
+
+  for (uint8_t prefill = 1U; prefill <= 5U; prefill++)
+    testJitter(prefill);
+
+  testLate(1U, 1U);
+  testLate(3U, 1U);
+  testLate(3U, 3U);
+
+  return testResult();
+}
+
+#else
+
+int main()
+{
+  ::printf("needs DUPLEX\n");
+
+  return testResult();
+}
+
+#endif
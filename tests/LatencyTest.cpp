@@ -0,0 +1,242 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// The DMR queue latency histogram, read back with MMDVM_DMR_QUEUE_LATENCY
+// after calls on a DMR downlink: every burst sent to the host is counted
+// once under its frame type, within a host loop of the end of the burst on
+// air, and a clear empties it
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRDownlink.h"
+#include "DMRSlotType.h"
+#include "Host.h"
+#include "Test.h"
+
+#include <string.h>
+
+#if defined(DUPLEX)
+
+const uint32_t FREQUENCY = 433450000U;
+
+// The frames of the host protocol, as in SerialPort.cpp
+const uint8_t  MMDVM_FRAME_START       = 0xE0U;
+const uint8_t  MMDVM_DMR_DATA1         = 0x18U;
+const uint8_t  MMDVM_DMR_DATA2         = 0x1AU;
+const uint8_t  MMDVM_DMR_QUEUE_LATENCY = 0xA3U;
+
+// The sync of a burst, in its bytes 13 to 19
+const uint8_t  SYNC_START = 13U;
+
+// The host loop runs every this many bits, two ticks each, off the 288 of
+// a burst so that the bursts end at every point of it
+const uint8_t  LOOP_BITS = 7U;
+
+const uint16_t CALLS = 10U;
+
+const uint8_t  LATENCY_LENGTH = 5U + DMRLT_COUNT * DMR_LATENCY_TYPE_LENGTH;
+
+static uint8_t  reply[256U];
+static uint16_t replyLen = 0U;
+
+// Frames to the host by type, as CDMRLatency sorts them
+static uint16_t sent[DMRLT_COUNT];
+
+static uint8_t  latency[LATENCY_LENGTH];
+static bool     latencyRead = false;
+
+static bool isDataSync(const uint8_t* burst)
+{
+  const uint8_t* SYNCS[] = {DMR_BS_DATA_SYNC_BYTES, DMR_MS_DATA_SYNC_BYTES, DMR_S1_DATA_SYNC_BYTES, DMR_S2_DATA_SYNC_BYTES};
+
+  for (uint8_t n = 0U; n < sizeof(SYNCS) / sizeof(SYNCS[0U]); n++) {
+    bool same = true;
+    for (uint8_t i = 0U; i < DMR_SYNC_BYTES_LENGTH; i++)
+      same = same && ((burst[SYNC_START + i] ^ SYNCS[n][i]) & DMR_SYNC_BYTES_MASK[i]) == 0U;
+
+    if (same)
+      return true;
+  }
+
+  return false;
+}
+
+// Without SEND_RSSI_DATA the burst goes without its control byte, so the
+// type is taken from the burst: a data sync and its slot type, or voice
+static DMR_LATENCY_TYPE getType(const uint8_t* burst)
+{
+  if (!isDataSync(burst))
+    return DMRLT_VOICE;
+
+  CDMRSlotType slotType;
+  uint8_t colorCode, dataType;
+  CHECK(slotType.decode(burst, colorCode, dataType) == 0U);
+
+  switch (dataType) {
+    case DT_VOICE_LC_HEADER:
+    case DT_VOICE_PI_HEADER:
+      return DMRLT_HEADER;
+    case DT_TERMINATOR_WITH_LC:
+      return DMRLT_TERMINATOR;
+    default:
+      return DMRLT_DATA;
+  }
+}
+
+static void readHost()
+{
+  uint8_t c;
+  while (hostSerialRead(&c, 1U) == 1U) {
+    if (replyLen == 0U && c != MMDVM_FRAME_START)
+      continue;
+
+    reply[replyLen++] = c;
+    if (replyLen < 3U || replyLen < reply[1U])
+      continue;
+
+    if (reply[2U] == MMDVM_DMR_DATA1 || reply[2U] == MMDVM_DMR_DATA2)
+      sent[getType(reply + replyLen - DMR_FRAME_LENGTH_BYTES)]++;
+
+    if (reply[2U] == MMDVM_DMR_QUEUE_LATENCY && replyLen == LATENCY_LENGTH) {
+      ::memcpy(latency, reply, LATENCY_LENGTH);
+      latencyRead = true;
+    }
+
+    replyLen = 0U;
+  }
+}
+
+static void run(CDMRDownlink& site, uint32_t bits)
+{
+  for (uint32_t n = 0U; n < bits; n++) {
+    hostClockBit(0U, site.getBit());
+
+    if ((n % LOOP_BITS) == (LOOP_BITS - 1U)) {
+      hostLoop();
+      readHost();
+    }
+  }
+}
+
+static void readLatency(bool clear)
+{
+  const uint8_t request[] = {MMDVM_FRAME_START, 4U, MMDVM_DMR_QUEUE_LATENCY, uint8_t(clear ? 0x01U : 0x00U)};
+
+  latencyRead = false;
+  hostSerialWrite(request, sizeof(request));
+  hostLoop();
+  readHost();
+
+  CHECK(latencyRead);
+  CHECK(latency[3U] == DMRLT_COUNT && latency[4U] == DMR_LATENCY_BUCKETS);
+}
+
+static uint16_t field(uint8_t type, uint8_t n)
+{
+  const uint8_t* p = latency + 5U + type * DMR_LATENCY_TYPE_LENGTH + n * 2U;
+
+  return (p[0U] << 8) | p[1U];
+}
+
+static uint16_t getMax(uint8_t type)
+{
+  return field(type, 0U);
+}
+
+static uint16_t getCount(uint8_t type)
+{
+  uint16_t count = 0U;
+  for (uint8_t n = 0U; n < DMR_LATENCY_BUCKETS; n++)
+    count += field(type, n + 1U);
+
+  return count;
+}
+
+static void setUp()
+{
+  hostReset();
+
+  m_duplex     = true;
+  m_modemState = STATE_DMR;
+
+  CHECK(io.setFreq(FREQUENCY, FREQUENCY, 255U, FREQUENCY) == 0U);
+  io.ifConf(STATE_DMR, true);
+  io.start();
+  dmrRX.setColorCode(1U);
+}
+
+int main()
+{
+  setUp();
+
+  // Sync on the idle downlink, then start from an empty histogram
+  CDMRDownlink site(1U, 5U);
+  run(site, 20U * 288U);
+  readLatency(true);
+
+  ::memset(sent, 0x00U, sizeof(sent));
+
+  for (uint16_t n = 0U; n < CALLS; n++) {
+    site.startCall(2000U + n, 91U, 1U);
+    while (site.inCall())
+      run(site, 288U);
+    run(site, 4U * 288U);
+  }
+
+  readLatency(false);
+
+  const char* NAMES[DMRLT_COUNT] = {"header", "voice", "terminator", "data"};
+  for (uint8_t type = 0U; type < DMRLT_COUNT; type++) {
+    ::printf("%-10s %4u frames to the host, %4u in the histogram, at most %u ticks\n", NAMES[type],
+             sent[type], getCount(type), getMax(type));
+
+    CHECK(getCount(type) == sent[type]);
+
+    // From the last bit on air to the next host loop
+    CHECK(getMax(type) <= 2U * LOOP_BITS);
+  }
+
+  CHECK(sent[DMRLT_HEADER] == CALLS);
+  CHECK(sent[DMRLT_VOICE] >= CALLS * 6U);
+
+  // MS_MODE ends the call on the terminator without sending it on
+#if defined(MS_MODE)
+  CHECK(sent[DMRLT_TERMINATOR] == 0U);
+#else
+  CHECK(sent[DMRLT_TERMINATOR] == CALLS);
+#endif
+
+  // A clear leaves nothing behind
+  readLatency(true);
+  readLatency(false);
+  for (uint8_t type = 0U; type < DMRLT_COUNT; type++)
+    CHECK(getCount(type) == 0U && getMax(type) == 0U);
+
+  return testResult();
+}
+
+#else
+
+int main()
+{
+  ::printf("needs DUPLEX\n");
+
+  return testResult();
+}
+
+#endif
@@ -0,0 +1,290 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// The burst cost limits of MMDVM_DMR_QUALITY on a DMR downlink. Bursts
+// whose slot type carries more bit errors than the forward limit are kept
+// from the host, and the rest go. A call whose sync words carry too many
+// errors for the sync search is held by the flywheel while its bursts cost
+// no more than the flywheel limit, and is lost once they cost more.
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRDownlink.h"
+#include "Host.h"
+#include "Test.h"
+
+#include <string.h>
+
+#if defined(DUPLEX)
+
+const uint32_t FREQUENCY = 433450000U;
+
+// The frames of the host protocol, as in SerialPort.cpp
+const uint8_t  MMDVM_FRAME_START = 0xE0U;
+const uint8_t  MMDVM_ACK         = 0x70U;
+const uint8_t  MMDVM_NAK         = 0x7FU;
+const uint8_t  MMDVM_DMR_DATA1   = 0x18U;
+const uint8_t  MMDVM_DMR_LOST1   = 0x19U;
+const uint8_t  MMDVM_DMR_DATA2   = 0x1AU;
+const uint8_t  MMDVM_DMR_LOST2   = 0x1BU;
+const uint8_t  MMDVM_DMR_QUALITY = 0xA5U;
+
+// The limits as the firmware starts, and none at all
+const uint8_t  DEFAULT_START    = 28U;
+const uint8_t  DEFAULT_FORWARD  = 28U;
+const uint8_t  DEFAULT_FLYWHEEL = 32U;
+const uint8_t  NO_LIMIT         = 255U;
+
+// An unchecked flywheeled burst, the flywheel limit must stay below it
+const uint8_t  COST_UNCHECKED = 36U;
+
+// The host loop runs every this many bits
+const uint8_t  LOOP_BITS = 8U;
+
+// Bit positions in a CACH and burst: the slot type either side of the sync
+const uint16_t SLOT_TYPE_BITS[] = {122U, 125U, 128U, 183U};
+const uint16_t SYNC_START = 132U;
+
+// Sync errors beyond what the sync search takes, well inside what the
+// flywheel checks a sync against
+const uint8_t  SYNC_ERRORS = 6U;
+
+// Bursts counted at each number of errors, after a few to settle
+const uint16_t BURSTS = 40U;
+
+static CDMRDownlink site(1U, 41U);
+
+static uint8_t  burst[DMR_DOWNLINK_BURST_BYTES];
+static uint8_t  slotTypeErrors = 0U;
+static bool     syncErrors = false;
+
+static uint8_t  reply[256U];
+static uint16_t replyLen = 0U;
+static uint8_t  acked = 0U;
+static uint8_t  naked = 0U;
+
+static uint16_t frames = 0U;
+static uint16_t lost = 0U;
+
+static void flip(uint16_t n)
+{
+  burst[n >> 3] ^= 0x80U >> (n & 7U);
+}
+
+static bool hasSync(uint64_t sync)
+{
+  uint64_t pattern = 0U;
+  for (uint8_t i = 0U; i < DMR_SYNC_LENGTH_BITS; i++) {
+    uint16_t n = SYNC_START + i;
+    pattern = (pattern << 1) | ((burst[n >> 3] >> (7U - (n & 7U))) & 0x01U);
+  }
+
+  return pattern == sync;
+}
+
+// The next burst on air, with the errors of the test
+static void nextBurst()
+{
+  site.getBurst(burst);
+
+  bool data  = hasSync(DMR_BS_DATA_SYNC_BITS);
+  bool voice = hasSync(DMR_BS_VOICE_SYNC_BITS);
+
+  if (data) {
+    for (uint8_t i = 0U; i < slotTypeErrors; i++)
+      flip(SLOT_TYPE_BITS[i]);
+  }
+
+  if (syncErrors && (data || voice)) {
+    for (uint8_t i = 0U; i < SYNC_ERRORS; i++)
+      flip(SYNC_START + 1U + i * 8U);
+  }
+}
+
+static void readHost()
+{
+  uint8_t c;
+  while (hostSerialRead(&c, 1U) == 1U) {
+    if (replyLen == 0U && c != MMDVM_FRAME_START)
+      continue;
+
+    reply[replyLen++] = c;
+    if (replyLen < 3U || replyLen < reply[1U])
+      continue;
+
+    if (reply[2U] == MMDVM_ACK && replyLen >= 4U)
+      acked = reply[3U];
+    if (reply[2U] == MMDVM_NAK && replyLen >= 4U)
+      naked = reply[3U];
+
+    if (reply[2U] == MMDVM_DMR_DATA1 || reply[2U] == MMDVM_DMR_DATA2)
+      frames++;
+    if (reply[2U] == MMDVM_DMR_LOST1 || reply[2U] == MMDVM_DMR_LOST2)
+      lost++;
+
+    replyLen = 0U;
+  }
+}
+
+static void run(uint16_t bursts)
+{
+  for (uint16_t b = 0U; b < bursts; b++) {
+    nextBurst();
+
+    for (uint16_t n = 0U; n < DMR_DOWNLINK_BURST_BYTES * 8U; n++) {
+      hostClockBit(0U, (burst[n >> 3] >> (7U - (n & 7U))) & 0x01U);
+
+      if ((n % LOOP_BITS) == (LOOP_BITS - 1U)) {
+        hostLoop();
+        readHost();
+      }
+    }
+  }
+}
+
+static bool setQuality(uint8_t start, uint8_t forward, uint8_t flywheel)
+{
+  const uint8_t frame[] = {MMDVM_FRAME_START, 6U, MMDVM_DMR_QUALITY, start, forward, flywheel};
+
+  acked = 0U;
+  naked = 0U;
+  hostSerialWrite(frame, sizeof(frame));
+  hostLoop();
+  readHost();
+
+  CHECK(acked == MMDVM_DMR_QUALITY || naked == MMDVM_DMR_QUALITY);
+
+  return acked == MMDVM_DMR_QUALITY;
+}
+
+static void setUp()
+{
+  hostReset();
+
+  m_duplex     = true;
+  m_modemState = STATE_DMR;
+
+  CHECK(io.setFreq(FREQUENCY, FREQUENCY, 255U, FREQUENCY) == 0U);
+  io.ifConf(STATE_DMR, true);
+  io.start();
+  dmrRX.setColorCode(1U);
+
+  // Sync on the idle downlink
+  run(20U);
+}
+
+// The idle bursts forwarded with each number of slot type errors, which is
+// all of their cost, at each forward limit
+static void testForward()
+{
+  for (uint8_t forward = 0U; forward <= 2U; forward++) {
+    CHECK(setQuality(NO_LIMIT, forward, DEFAULT_FLYWHEEL));
+
+    ::printf("forward limit %u:", forward);
+
+    for (uint8_t errors = 0U; errors <= 3U; errors++) {
+      slotTypeErrors = errors;
+      run(4U);
+
+      frames = 0U;
+      run(BURSTS);
+
+      ::printf(" %u errors %2u of %u", errors, frames, BURSTS);
+
+      if (errors <= forward)
+        CHECK(frames == BURSTS);
+      else
+        CHECK(frames == 0U);
+    }
+
+    ::printf("\n");
+  }
+
+  slotTypeErrors = 0U;
+}
+
+// A call with every sync SYNC_ERRORS bits off, followed by the flywheel
+// from its header alone. Voice bursts B to F cost 4, COST_NO_SYNC with a
+// clean EMB, and the A bursts SYNC_ERRORS.
+static void testFlywheel(uint8_t flywheel, bool held)
+{
+  CHECK(setQuality(DEFAULT_START, DEFAULT_FORWARD, flywheel));
+
+  // The header found by the sync search, then the rest of the call without
+  run(20U);
+  site.startCall(3000U + flywheel, 91U, 4U);
+  run(2U);
+
+  frames = 0U;
+  lost   = 0U;
+  syncErrors = true;
+
+  uint16_t bursts = 0U;
+  while (site.inCall() && lost == 0U) {
+    run(1U);
+    bursts++;
+  }
+
+  ::printf("flywheel limit %2u: %3u bursts to the host, %s after %u bursts\n", flywheel, frames,
+           lost > 0U ? "lost" : "held", bursts);
+
+  if (held) {
+    CHECK(lost == 0U);
+
+    // Every voice burst, A included, the terminator being lost to its sync
+    CHECK(frames >= 4U * 6U);
+  } else {
+    // The missed bursts on both slots, counted by the flywheel
+    CHECK(lost > 0U);
+    CHECK(bursts <= 2U * 13U + 2U);
+  }
+
+  while (site.inCall())
+    run(1U);
+  syncErrors = false;
+  run(40U);
+}
+
+int main()
+{
+  setUp();
+
+  testForward();
+
+  // A flywheel limit that would keep an unchecked burst is refused
+  CHECK(!setQuality(DEFAULT_START, DEFAULT_FORWARD, COST_UNCHECKED));
+
+  testFlywheel(DEFAULT_FLYWHEEL, true);
+  testFlywheel(SYNC_ERRORS, true);
+  testFlywheel(3U, false);
+
+  CHECK(setQuality(DEFAULT_START, DEFAULT_FORWARD, DEFAULT_FLYWHEEL));
+
+  return testResult();
+}
+
+#else
+
+int main()
+{
+  ::printf("needs DUPLEX\n");
+
+  return testResult();
+}
+
+#endif
@@ -0,0 +1,263 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Dwell and acquisition timing of the DMR channel scan, against three
+// simulated channels: noise, a BS that carries calls and an idle BS
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRDownlink.h"
+#include "DMRLC.h"
+#include "Host.h"
+#include "Test.h"
+
+#include <string.h>
+
+#if defined(DUPLEX) && defined(ENABLE_SCAN_MODE)
+
+const uint32_t FREQUENCY = 433450000U;
+
+const uint8_t  CHANNELS = 3U;
+const uint32_t CHANNEL_FREQ[CHANNELS] = {433450000U, 433462500U, 433475000U};
+const uint16_t DWELL = 200U;
+
+// The frames of the host protocol, as in SerialPort.cpp
+const uint8_t  MMDVM_FRAME_START = 0xE0U;
+const uint8_t  MMDVM_DMR_DATA1   = 0x18U;
+const uint8_t  MMDVM_DMR_DATA2   = 0x1AU;
+
+// Where the calls are
+const int8_t   CALL_CHANNEL = 1;
+
+// The host loop runs every this many bits, under 1 ms
+const uint8_t  LOOP_BITS = 8U;
+
+static uint32_t chanReg0[CHANNELS];
+
+static CDMRDownlink site(1U, 11U);
+static CDMRDownlink idleSite(1U, 22U);
+static uint32_t noise = 1U;
+
+static int8_t   chan = -1;
+static uint16_t retunes = 0U;
+static uint64_t retuneNs = 0U;
+static uint16_t headers = 0U;
+static uint64_t headerNs = 0U;
+static uint16_t frames = 0U;
+static uint32_t callSrcId = 0U;
+
+static uint8_t  reply[256U];
+static uint16_t replyLen = 0U;
+
+static double ms(uint64_t ns)
+{
+  return double(ns) / 1000000.0;
+}
+
+static int8_t tuned()
+{
+  for (uint8_t i = 0U; i < CHANNELS; i++) {
+    if (hostReg(1U, 0U) == chanReg0[i])
+      return int8_t(i);
+  }
+
+  return -1;
+}
+
+// The DMR frames the modem sends to the host
+static void readHost()
+{
+  uint8_t c;
+  while (hostSerialRead(&c, 1U) == 1U) {
+    if (replyLen == 0U && c != MMDVM_FRAME_START)
+      continue;
+
+    reply[replyLen++] = c;
+    if (replyLen < 3U || replyLen < reply[1U])
+      continue;
+
+    // Without SEND_RSSI_DATA the burst goes as it is, without the control
+    // byte, so the header is known by its LC
+    if (reply[2U] == MMDVM_DMR_DATA1 || reply[2U] == MMDVM_DMR_DATA2) {
+      uint8_t data[1U + DMR_FRAME_LENGTH_BYTES];
+      data[0U] = 0x00U;
+      ::memcpy(data + 1U, reply + replyLen - DMR_FRAME_LENGTH_BYTES, DMR_FRAME_LENGTH_BYTES);
+
+      DMRLC_T lc;
+      if (CDMRLC::decode(data, DT_VOICE_LC_HEADER, &lc) && lc.srcId == callSrcId) {
+        headers++;
+        headerNs = hostNanos();
+      }
+
+      frames++;
+    }
+
+    replyLen = 0U;
+  }
+}
+
+static void run(uint32_t duration)
+{
+  uint64_t end = hostNanos() + uint64_t(duration) * 1000000U;
+
+  while (hostNanos() < end) {
+    for (uint8_t n = 0U; n < LOOP_BITS; n++) {
+      noise = noise * 1103515245U + 12345U;
+
+      uint8_t bits[CHANNELS];
+      bits[0U] = (noise >> 16) & 0x01U;
+      bits[1U] = site.getBit();
+      bits[2U] = idleSite.getBit();
+
+      hostClockBit(0U, chan >= 0 ? bits[chan] : bits[0U]);
+    }
+
+    hostLoop();
+    readHost();
+
+    int8_t now = tuned();
+    if (now != chan) {
+      chan = now;
+      retunes++;
+      retuneNs = hostNanos();
+    }
+  }
+}
+
+static void setUp()
+{
+  hostReset();
+
+  m_duplex     = true;
+  m_modemState = STATE_DMR;
+
+  CHECK(io.setFreq(FREQUENCY, FREQUENCY, 255U, FREQUENCY) == 0U);
+  io.ifConf(STATE_DMR, true);
+  io.start();
+  dmrRX.setColorCode(1U);
+
+  // The REG0 of each channel, from the chip after tuning to it alone
+  for (uint8_t i = 0U; i < CHANNELS; i++) {
+    CHECK(io.setChannels(CHANNEL_FREQ + i, 1U, DWELL) == 0U);
+    chanReg0[i] = hostReg(1U, 0U);
+  }
+
+  CHECK(io.setChannels(CHANNEL_FREQ, CHANNELS, DWELL) == 0U);
+  chan = tuned();
+  CHECK(chan == 0);
+}
+
+// Nothing going on, the scan steps on every dwell, an idle BS included
+static void testDwell()
+{
+  // From a retune, the first dwell started with setChannels()
+  run(DWELL + 10U);
+  uint64_t last = retuneNs;
+  uint64_t shortest = ~0ULL, longest = 0U;
+
+  for (uint8_t n = 0U; n < 2U * CHANNELS; n++) {
+    uint16_t count = retunes;
+    run(DWELL + 10U);
+    CHECK(retunes == count + 1U);
+
+    uint64_t period = retuneNs - last;
+    if (period < shortest)
+      shortest = period;
+    if (period > longest)
+      longest = period;
+    last = retuneNs;
+  }
+
+  ::printf("dwell %u ms: %.1f to %.1f ms a channel\n", DWELL, ms(shortest), ms(longest));
+
+  // The dwell in ticks as setChannels() has it, and at most a host loop late
+  const uint64_t dwellNs = (uint64_t(DWELL) * 96U / 5U) * HOST_EDGE_NS;
+  CHECK(shortest >= dwellNs);
+  CHECK(longest <= dwellNs + 2U * LOOP_BITS * HOST_EDGE_NS);
+}
+
+// A call that starts when the scan is elsewhere is held within a sweep, one
+// that starts while it listens reaches the host from its header
+static void testCall(uint32_t offset)
+{
+  // Line the call start up with the scan cycle
+  while (chan != 0)
+    run(1U);
+  run(offset);
+
+  uint16_t count = headers;
+  bool listening = chan == CALL_CHANNEL;
+
+  uint64_t start = hostNanos();
+  callSrcId = 1234567U + offset;
+  site.startCall(callSrcId, 91U, 6U);
+
+  // Parked on the call channel, for the whole call
+  while (chan != CALL_CHANNEL && site.inCall())
+    run(1U);
+  uint64_t acquired = hostNanos();
+
+  uint16_t before = retunes;
+  while (site.inCall())
+    run(1U);
+  uint64_t ended = hostNanos();
+  bool held = retunes == before;
+
+  // Then off it again, a dwell after the activity ends
+  while (chan == CALL_CHANNEL && (hostNanos() - ended) < 2000000000U)
+    run(1U);
+  uint64_t resumed = hostNanos();
+
+  ::printf("call %3u ms into the sweep: on the channel after %6.1f ms%s, header %s, held %s, resumed %6.1f ms after the end\n",
+           offset, ms(acquired - start), listening ? " (listening)" : "",
+           headers > count ? "sent" : "missed", held ? "yes" : "no", ms(resumed - ended));
+
+  CHECK(held);
+  CHECK((acquired - start) <= uint64_t(CHANNELS * DWELL) * 1000000U);
+  if (listening) {
+    CHECK(headers == count + 1U);
+    CHECK((headerNs - start) <= 100000000U);
+  }
+
+  // The terminator, the Short LC going idle and one dwell
+  CHECK((resumed - ended) <= uint64_t(DWELL + 300U) * 1000000U);
+}
+
+int main()
+{
+  setUp();
+  testDwell();
+
+  for (uint32_t offset = 0U; offset < CHANNELS * DWELL; offset += 100U)
+    testCall(offset);
+
+  ::printf("%u headers, %u bursts to the host\n", headers, frames);
+
+  return testResult();
+}
+
+#else
+
+int main()
+{
+  ::printf("needs DUPLEX and ENABLE_SCAN_MODE\n");
+
+  return testResult();
+}
+
+#endif
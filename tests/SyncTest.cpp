@@ -0,0 +1,554 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// The YSF, P25 and NXDN receivers on the shared CSyncRX, and the M17
+// receiver, fed a bit stream through the ADF7021 clock: frames with sync
+// words that carry bit errors, noise around them, for P25 the header and
+// terminator that pick the frame lengths, and for M17 frames encoded as
+// the standard has them. Built with MODE_YSF, MODE_P25, MODE_NXDN and
+// MODE_M17 on top of Config.h.
+
+#include "Config.h"
+#include "Globals.h"
+#include "Golay24128.h"
+#include "Host.h"
+#include "Test.h"
+
+#include <string.h>
+
+#if defined(MODE_YSF) && defined(MODE_P25) && defined(MODE_NXDN) && defined(MODE_M17)
+
+const uint32_t FREQUENCY = 433450000U;
+
+// The frames of the host protocol, as in SerialPort.cpp
+const uint8_t  MMDVM_FRAME_START = 0xE0U;
+const uint8_t  MMDVM_SET_MODE    = 0x03U;
+const uint8_t  MMDVM_YSF_DATA    = 0x20U;
+const uint8_t  MMDVM_YSF_LOST    = 0x21U;
+const uint8_t  MMDVM_P25_HDR     = 0x30U;
+const uint8_t  MMDVM_P25_LDU     = 0x31U;
+const uint8_t  MMDVM_P25_LOST    = 0x32U;
+const uint8_t  MMDVM_NXDN_DATA   = 0x40U;
+const uint8_t  MMDVM_NXDN_LOST   = 0x41U;
+const uint8_t  MMDVM_M17_LINK_SETUP = 0x45U;
+const uint8_t  MMDVM_M17_STREAM     = 0x46U;
+const uint8_t  MMDVM_M17_LOST       = 0x48U;
+const uint8_t  MMDVM_M17_EOT        = 0x49U;
+
+// The M17 puncturing of the link setup and of a stream frame
+const uint8_t  M17_PUNCTURE_P1[] = {
+  1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U,
+  1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U, 0U, 1U, 1U, 1U};
+const uint8_t  M17_PUNCTURE_P2[] = {1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 0U};
+
+const uint16_t M17_LSF_CRC_POLY = 0x5935U;
+
+// The frame number and payload of a stream frame
+const uint16_t M17_DATA_LENGTH_BITS = 144U;
+
+// The host loop runs every this many bits
+const uint8_t  LOOP_BITS = 8U;
+
+const uint8_t  MAX_FRAMES = 16U;
+
+struct FRAME_T {
+  uint8_t  type;
+  uint8_t  length;
+  uint8_t  data[256U];
+};
+
+static FRAME_T  frames[MAX_FRAMES];
+static uint8_t  frameCount = 0U;
+
+static uint8_t  reply[256U];
+static uint16_t replyLen = 0U;
+
+static uint32_t noiseSeed = 1U;
+static uint8_t  loopBits = 0U;
+
+// The frames the modem sends to the host, debug output left out
+static void readHost()
+{
+  uint8_t c;
+  while (hostSerialRead(&c, 1U) == 1U) {
+    if (replyLen == 0U && c != MMDVM_FRAME_START)
+      continue;
+
+    reply[replyLen++] = c;
+    if (replyLen < 3U || replyLen < reply[1U])
+      continue;
+
+    uint8_t type = reply[2U];
+    if ((type & 0xF0U) != 0xF0U && type != 0x70U && frameCount < MAX_FRAMES) {
+      frames[frameCount].type   = type;
+      frames[frameCount].length = reply[1U] - 3U;
+      ::memcpy(frames[frameCount].data, reply + 3U, reply[1U] - 3U);
+      frameCount++;
+    }
+
+    replyLen = 0U;
+  }
+}
+
+static void clock(uint8_t bit)
+{
+  hostClockBit(bit, 0U);
+
+  if (++loopBits == LOOP_BITS) {
+    loopBits = 0U;
+    hostLoop();
+    readHost();
+  }
+}
+
+static void noise(uint16_t bits)
+{
+  for (uint16_t n = 0U; n < bits; n++) {
+    noiseSeed = noiseSeed * 1103515245U + 12345U;
+    clock((noiseSeed >> 16) & 0x01U);
+  }
+}
+
+static bool getBit(const uint8_t* data, uint16_t n)
+{
+  return (data[n >> 3] & (0x80U >> (n & 7U))) != 0U;
+}
+
+static void setBit(uint8_t* data, uint16_t n, bool b)
+{
+  if (b)
+    data[n >> 3] |= 0x80U >> (n & 7U);
+  else
+    data[n >> 3] &= ~(0x80U >> (n & 7U));
+}
+
+// A frame of random bits behind the sync word, errs bits of the sync flipped
+static void makeFrame(uint8_t* frame, uint16_t lengthBits, const uint8_t* sync, uint8_t syncBits, uint8_t errs)
+{
+  for (uint16_t i = 0U; i < (lengthBits + 7U) / 8U; i++) {
+    noiseSeed = noiseSeed * 1103515245U + 12345U;
+    frame[i] = uint8_t(noiseSeed >> 16);
+  }
+
+  for (uint8_t i = 0U; i < syncBits; i++) {
+    bool b = getBit(sync, i) ^ (i < errs * 3U && (i % 3U) == 0U);
+    if (b)
+      frame[i >> 3] |= 0x80U >> (i & 7U);
+    else
+      frame[i >> 3] &= ~(0x80U >> (i & 7U));
+  }
+}
+
+static void send(const uint8_t* frame, uint16_t lengthBits)
+{
+  for (uint16_t i = 0U; i < lengthBits; i++)
+    clock(getBit(frame, i) ? 1U : 0U);
+}
+
+// What the host got matches what was sent, from the end of the sync word on
+static bool same(const FRAME_T& got, const uint8_t* frame, uint16_t syncBits, uint16_t lengthBits)
+{
+  if (got.length < (lengthBits + 7U) / 8U + 1U)
+    return false;
+
+  for (uint16_t i = syncBits; i < lengthBits; i++) {
+    if (getBit(got.data + 1U, i) != getBit(frame, i))
+      return false;
+  }
+
+  return true;
+}
+
+static uint8_t count(uint8_t type)
+{
+  uint8_t n = 0U;
+  for (uint8_t i = 0U; i < frameCount; i++) {
+    if (frames[i].type == type)
+      n++;
+  }
+
+  return n;
+}
+
+static void setMode(MMDVM_STATE state)
+{
+  const uint8_t frame[] = {MMDVM_FRAME_START, 4U, MMDVM_SET_MODE, uint8_t(state)};
+  hostSerialWrite(frame, sizeof(frame));
+  hostLoop();
+  readHost();
+
+  frameCount = 0U;
+  loopBits   = 0U;
+}
+
+static void setUp()
+{
+  hostReset();
+
+  m_duplex      = false;
+  m_modemState  = STATE_DMR;
+  m_ysfEnable   = true;
+  m_p25Enable   = true;
+  m_nxdnEnable  = true;
+  m_m17Enable   = true;
+
+  CHECK(io.setFreq(FREQUENCY, FREQUENCY, 255U, FREQUENCY) == 0U);
+  io.ifConf(STATE_DMR, true);
+  io.start();
+}
+
+// Starts on a sync with the errors it allows to start, holds on one with
+// the errors it allows while running, and is lost a frame after the last
+static void testYSF()
+{
+  setMode(STATE_YSF);
+  CHECK(m_modemState == STATE_YSF);
+
+  const uint8_t ERRS[] = {2U, 4U, 0U};
+  uint8_t sent[3U][YSF_FRAME_LENGTH_BYTES];
+
+  noise(100U);
+  for (uint8_t n = 0U; n < 3U; n++) {
+    makeFrame(sent[n], YSF_FRAME_LENGTH_BITS, YSF_SYNC_BYTES, YSF_SYNC_LENGTH_BITS, ERRS[n]);
+    send(sent[n], YSF_FRAME_LENGTH_BITS);
+  }
+  noise(3U * YSF_FRAME_LENGTH_BITS);
+
+  ::printf("YSF:  %u frames, %u lost\n", count(MMDVM_YSF_DATA), count(MMDVM_YSF_LOST));
+
+  CHECK(frameCount == 4U);
+  CHECK(count(MMDVM_YSF_DATA) == 3U);
+  for (uint8_t n = 0U; n < 3U && n < frameCount; n++) {
+    CHECK(frames[n].type == MMDVM_YSF_DATA);
+    CHECK(frames[n].data[0U] == 0x01U);
+    CHECK(same(frames[n], sent[n], YSF_SYNC_LENGTH_BITS, YSF_FRAME_LENGTH_BITS));
+  }
+  CHECK(frameCount == 4U && frames[3U].type == MMDVM_YSF_LOST);
+}
+
+// No errors to start, and frames without a sync go on to the host until
+// the lock is lost
+static void testNXDN()
+{
+  setMode(STATE_NXDN);
+  CHECK(m_modemState == STATE_NXDN);
+
+  const uint8_t ERRS[] = {0U, 3U};
+  uint8_t sent[2U][NXDN_FRAME_LENGTH_BYTES];
+
+  noise(100U);
+  for (uint8_t n = 0U; n < 2U; n++) {
+    makeFrame(sent[n], NXDN_FRAME_LENGTH_BITS, NXDN_FSW_BYTES, NXDN_FSW_LENGTH_BITS, ERRS[n]);
+    send(sent[n], NXDN_FRAME_LENGTH_BITS);
+  }
+  noise(8U * NXDN_FRAME_LENGTH_BITS);
+
+  ::printf("NXDN: %u frames, %u lost\n", count(MMDVM_NXDN_DATA), count(MMDVM_NXDN_LOST));
+
+  // Two with a sync, then four without and the loss
+  CHECK(frameCount == 7U);
+  CHECK(count(MMDVM_NXDN_DATA) == 6U);
+  CHECK(count(MMDVM_NXDN_LOST) == 1U);
+  for (uint8_t n = 0U; n < frameCount && n < 6U; n++)
+    CHECK(frames[n].data[0U] == (n < 2U ? 0x01U : 0x00U));
+  for (uint8_t n = 0U; n < 2U && n < frameCount; n++)
+    CHECK(same(frames[n], sent[n], NXDN_FSW_LENGTH_BITS, NXDN_FRAME_LENGTH_BITS));
+}
+
+static void makeP25(uint8_t* frame, uint16_t lengthBits, uint8_t duid)
+{
+  makeFrame(frame, lengthBits, P25_SYNC_BYTES, P25_SYNC_LENGTH_BITS, 0U);
+
+  // The NAC and the DUID of the NID
+  frame[6U] = 0x29U;
+  frame[7U] = 0x30U | duid;
+}
+
+// The header sets the length of the first frame, the LDUs follow at theirs,
+// and the terminator ends the transmission without a loss
+static void testP25()
+{
+  setMode(STATE_P25);
+  CHECK(m_modemState == STATE_P25);
+
+  uint8_t hdu[P25_HDR_FRAME_LENGTH_BYTES];
+  uint8_t ldu[2U][P25_LDU_FRAME_LENGTH_BYTES];
+  uint8_t tdu[P25_TERM_FRAME_LENGTH_BYTES];
+
+  for (uint8_t t = 0U; t < 2U; t++) {
+    noise(100U);
+
+    makeP25(hdu, P25_HDR_FRAME_LENGTH_BITS, P25_DUID_HDU);
+    send(hdu, P25_HDR_FRAME_LENGTH_BITS);
+
+    makeP25(ldu[0U], P25_LDU_FRAME_LENGTH_BITS, P25_DUID_LDU1);
+    send(ldu[0U], P25_LDU_FRAME_LENGTH_BITS);
+    makeP25(ldu[1U], P25_LDU_FRAME_LENGTH_BITS, P25_DUID_LDU2);
+    send(ldu[1U], P25_LDU_FRAME_LENGTH_BITS);
+
+    makeP25(tdu, P25_TERM_FRAME_LENGTH_BITS, P25_DUID_TDU);
+    send(tdu, P25_TERM_FRAME_LENGTH_BITS);
+    noise(2U * P25_LDU_FRAME_LENGTH_BITS);
+
+    uint8_t first = frameCount - 4U;
+    ::printf("P25:  transmission %u, %u headers, %u LDUs, %u lost\n", t + 1U, count(MMDVM_P25_HDR),
+             count(MMDVM_P25_LDU), count(MMDVM_P25_LOST));
+
+    // The TDU goes as an LDU, the frame length after the first
+    CHECK(frameCount == 4U * (t + 1U));
+    if (frameCount != 4U * (t + 1U))
+      return;
+
+    CHECK(frames[first].type == MMDVM_P25_HDR);
+    CHECK(frames[first].length == P25_HDR_FRAME_LENGTH_BYTES + 1U);
+    CHECK(same(frames[first], hdu, P25_SYNC_LENGTH_BITS, P25_HDR_FRAME_LENGTH_BITS));
+
+    for (uint8_t n = 0U; n < 2U; n++) {
+      CHECK(frames[first + 1U + n].type == MMDVM_P25_LDU);
+      CHECK(same(frames[first + 1U + n], ldu[n], P25_SYNC_LENGTH_BITS, P25_LDU_FRAME_LENGTH_BITS));
+    }
+
+    CHECK(frames[first + 3U].type == MMDVM_P25_LDU);
+    CHECK(same(frames[first + 3U], tdu, P25_SYNC_LENGTH_BITS, P25_TERM_FRAME_LENGTH_BITS));
+  }
+
+  CHECK(count(MMDVM_P25_LOST) == 0U);
+}
+
+// The K=5 rate 1/2 code, G1 = 1 + D^3 + D^4 and G2 = 1 + D + D^2 + D^4,
+// flushed back to state zero and punctured. Returns the bits written.
+static uint16_t m17Convolve(const uint8_t* in, uint16_t bits, const uint8_t* puncture, uint8_t punctureLength, uint8_t* out, uint16_t pos)
+{
+  uint8_t reg = 0U;
+  uint8_t p   = 0U;
+
+  for (uint16_t n = 0U; n < bits + 4U; n++) {
+    uint8_t u = (n < bits && getBit(in, n)) ? 1U : 0U;
+
+    uint8_t g[2U];
+    g[0U] = u ^ ((reg >> 2) & 0x01U) ^ ((reg >> 3) & 0x01U);
+    g[1U] = u ^ ((reg >> 0) & 0x01U) ^ ((reg >> 1) & 0x01U) ^ ((reg >> 3) & 0x01U);
+
+    for (uint8_t k = 0U; k < 2U; k++) {
+      if (puncture[p] == 1U)
+        setBit(out, pos++, g[k] != 0U);
+      if (++p >= punctureLength)
+        p = 0U;
+    }
+
+    reg = ((reg << 1) | u) & 0x0FU;
+  }
+
+  return pos;
+}
+
+// The payload scrambled and put through the QPP interleaver behind the sync
+static void m17Frame(uint8_t* frame, const uint8_t* sync, const uint8_t* payload)
+{
+  ::memcpy(frame, sync, M17_SYNC_LENGTH_BYTES);
+
+  uint16_t pos  = 0U;
+  uint16_t step = 137U;
+
+  for (uint16_t i = 0U; i < M17_PAYLOAD_LENGTH_BITS; i++) {
+    setBit(frame, M17_SYNC_LENGTH_BITS + pos, getBit(payload, i) ^ getBit(M17_SCRAMBLER, pos));
+
+    pos += step;
+    if (pos >= M17_PAYLOAD_LENGTH_BITS)
+      pos -= M17_PAYLOAD_LENGTH_BITS;
+
+    step += 184U;
+    if (step >= M17_PAYLOAD_LENGTH_BITS)
+      step -= M17_PAYLOAD_LENGTH_BITS;
+  }
+}
+
+static uint8_t m17Random()
+{
+  noiseSeed = noiseSeed * 1103515245U + 12345U;
+  return uint8_t(noiseSeed >> 16);
+}
+
+// A link setup frame of random addresses and type, its CRC over it
+static void makeLinkSetup(uint8_t* frame, uint16_t errs)
+{
+  uint8_t lsf[M17_LSF_LENGTH_BYTES];
+  for (uint8_t i = 0U; i < M17_LSF_LENGTH_BYTES - 2U; i++)
+    lsf[i] = m17Random();
+
+  uint16_t crc = 0xFFFFU;
+  for (uint8_t i = 0U; i < M17_LSF_LENGTH_BYTES - 2U; i++) {
+    crc ^= uint16_t(lsf[i]) << 8;
+    for (uint8_t j = 0U; j < 8U; j++)
+      crc = (crc & 0x8000U) ? (crc << 1) ^ M17_LSF_CRC_POLY : (crc << 1);
+  }
+  lsf[M17_LSF_LENGTH_BYTES - 2U] = crc >> 8;
+  lsf[M17_LSF_LENGTH_BYTES - 1U] = crc >> 0;
+
+  uint8_t payload[M17_PAYLOAD_LENGTH_BITS / 8U];
+  CHECK(m17Convolve(lsf, M17_LSF_LENGTH_BYTES * 8U, M17_PUNCTURE_P1, sizeof(M17_PUNCTURE_P1), payload, 0U) == M17_PAYLOAD_LENGTH_BITS);
+
+  // Errors spread over the coded bits
+  for (uint16_t i = 0U; i < errs; i++)
+    payload[(i * 7U) % sizeof(payload)] ^= 0x10U;
+
+  m17Frame(frame, M17_LINK_SETUP_SYNC_BYTES, payload);
+}
+
+// A stream frame, with lichErrs bits off in the first LICH codeword and
+// dataErrs bits off in the convolutional code, or all of it noise
+static void makeStream(uint8_t* frame, uint16_t fn, uint8_t lichErrs, uint8_t dataErrs, bool noisy = false)
+{
+  uint8_t payload[M17_PAYLOAD_LENGTH_BITS / 8U];
+
+  for (uint8_t i = 0U; i < M17_LICH_LENGTH_BITS / 24U; i++) {
+    uint32_t code = CGolay24128::encode24128(((uint16_t(m17Random()) << 8) | m17Random()) & 0x0FFFU);
+    payload[i * 3U + 0U] = code >> 16;
+    payload[i * 3U + 1U] = code >> 8;
+    payload[i * 3U + 2U] = code >> 0;
+  }
+
+  uint8_t data[M17_DATA_LENGTH_BITS / 8U];
+  data[0U] = fn >> 8;
+  data[1U] = fn >> 0;
+  for (uint8_t i = 2U; i < sizeof(data); i++)
+    data[i] = m17Random();
+
+  CHECK(m17Convolve(data, M17_DATA_LENGTH_BITS, M17_PUNCTURE_P2, sizeof(M17_PUNCTURE_P2), payload, M17_LICH_LENGTH_BITS) == M17_PAYLOAD_LENGTH_BITS);
+
+  for (uint8_t i = 0U; i < lichErrs; i++)
+    setBit(payload, i * 5U, !getBit(payload, i * 5U));
+
+  for (uint8_t i = 0U; i < dataErrs; i++) {
+    uint16_t n = M17_LICH_LENGTH_BITS + 20U + i * 40U;
+    setBit(payload, n, !getBit(payload, n));
+  }
+
+  if (noisy) {
+    for (uint16_t i = M17_LICH_LENGTH_BITS / 8U; i < sizeof(payload); i++)
+      payload[i] = m17Random();
+  }
+
+  m17Frame(frame, M17_STREAM_SYNC_BYTES, payload);
+}
+
+// A link setup then a stream, errors corrected in both, that ends on its
+// end of stream frame. A stream joined late ends on the EOT sync.
+static void testM17()
+{
+  setMode(STATE_M17);
+  CHECK(m_modemState == STATE_M17);
+
+  const uint8_t STREAM_FRAMES = 4U;
+  uint8_t lsf[M17_FRAME_LENGTH_BYTES];
+  uint8_t stream[STREAM_FRAMES][M17_FRAME_LENGTH_BYTES];
+
+  noise(100U);
+  makeLinkSetup(lsf, 4U);
+  send(lsf, M17_FRAME_LENGTH_BITS);
+  for (uint8_t n = 0U; n < STREAM_FRAMES; n++) {
+    uint16_t fn = n == (STREAM_FRAMES - 1U) ? (n | M17_FN_EOS) : n;
+
+    // The LICH and Viterbi correct a few, the sync is allowed two
+    makeStream(stream[n], fn, n, 3U);
+    if (n == 1U)
+      stream[n][0U] ^= 0x44U;
+
+    send(stream[n], M17_FRAME_LENGTH_BITS);
+  }
+  noise(2U * M17_FRAME_LENGTH_BITS);
+
+  ::printf("M17:  %u link setups, %u stream frames, %u ends, %u lost\n", count(MMDVM_M17_LINK_SETUP),
+           count(MMDVM_M17_STREAM), count(MMDVM_M17_EOT), count(MMDVM_M17_LOST));
+
+  CHECK(frameCount == STREAM_FRAMES + 2U);
+  if (frameCount != STREAM_FRAMES + 2U)
+    return;
+
+  CHECK(frames[0U].type == MMDVM_M17_LINK_SETUP);
+  CHECK(frames[0U].data[0U] == 0x01U);
+  CHECK(same(frames[0U], lsf, M17_SYNC_LENGTH_BITS, M17_FRAME_LENGTH_BITS));
+
+  for (uint8_t n = 0U; n < STREAM_FRAMES; n++) {
+    CHECK(frames[1U + n].type == MMDVM_M17_STREAM);
+    CHECK(frames[1U + n].data[0U] == 0x01U);
+    CHECK(same(frames[1U + n], stream[n], M17_SYNC_LENGTH_BITS, M17_FRAME_LENGTH_BITS));
+  }
+
+  CHECK(frames[STREAM_FRAMES + 1U].type == MMDVM_M17_EOT);
+
+  // Late entry, then the EOT sync
+  setMode(STATE_M17);
+  noise(100U);
+  makeStream(stream[0U], 20U, 0U, 0U);
+  send(stream[0U], M17_FRAME_LENGTH_BITS);
+  makeFrame(stream[1U], M17_FRAME_LENGTH_BITS, M17_EOT_SYNC_BYTES, M17_SYNC_LENGTH_BITS, 0U);
+  send(stream[1U], M17_FRAME_LENGTH_BITS);
+  noise(2U * M17_FRAME_LENGTH_BITS);
+
+  CHECK(frameCount == 2U);
+  CHECK(frameCount == 2U && frames[0U].type == MMDVM_M17_STREAM && frames[1U].type == MMDVM_M17_EOT);
+}
+
+// A sync whose first frame fails its checks is taken as noise: a link
+// setup failing its CRC after the Viterbi decode, a stream frame with a
+// LICH codeword past correcting, and one whose convolutional code is noise
+static void testM17Dropped()
+{
+  setMode(STATE_M17);
+
+  uint8_t frame[M17_FRAME_LENGTH_BYTES];
+
+  noise(100U);
+  makeLinkSetup(frame, 40U);
+  send(frame, M17_FRAME_LENGTH_BITS);
+  noise(100U);
+  makeStream(frame, 0U, 4U, 0U);
+  send(frame, M17_FRAME_LENGTH_BITS);
+  noise(100U);
+  makeStream(frame, 0U, 0U, 0U, true);
+  send(frame, M17_FRAME_LENGTH_BITS);
+  noise(2U * M17_FRAME_LENGTH_BITS);
+
+  ::printf("M17:  %u frames from three failed syncs\n", frameCount);
+
+  CHECK(frameCount == 0U);
+}
+
+int main()
+{
+  setUp();
+  testYSF();
+  testNXDN();
+  testP25();
+  testM17();
+  testM17Dropped();
+
+  return testResult();
+}
+
+#else
+
+int main()
+{
+  ::printf("needs MODE_YSF, MODE_P25, MODE_NXDN and MODE_M17\n");
+
+  return testResult();
+}
+
+#endif
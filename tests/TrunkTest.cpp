@@ -0,0 +1,340 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// A Tier III site of a control channel and a traffic channel, loaded with
+// MMDVM_DMR_TRUNK. A grant on the control channel retunes the receiver to
+// the traffic channel, which it holds for the call and leaves for the
+// control channel at the terminator, when the call never starts and when
+// the traffic channel is lost mid-call. MMDVM_DMR_TRUNK_STATUS counts each.
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRDownlink.h"
+#include "Host.h"
+#include "Test.h"
+
+#include <string.h>
+
+#if defined(DUPLEX)
+
+const uint32_t FREQUENCY = 433450000U;
+
+// The control channel first, as the host loads the plan
+const uint8_t  CHANNELS = 2U;
+const uint16_t CHANNEL_LCN[CHANNELS]  = {1U, 2U};
+const uint32_t CHANNEL_FREQ[CHANNELS] = {433450000U, 433462500U};
+
+const int8_t   CONTROL = 0;
+const int8_t   TRAFFIC = 1;
+
+// The frames of the host protocol, as in SerialPort.cpp
+const uint8_t  MMDVM_FRAME_START      = 0xE0U;
+const uint8_t  MMDVM_ACK              = 0x70U;
+const uint8_t  MMDVM_DMR_TRUNK        = 0xA7U;
+const uint8_t  MMDVM_DMR_TRUNK_STATUS = 0xA8U;
+
+// The host loop runs every this many bits, under 1 ms
+const uint8_t  LOOP_BITS = 8U;
+
+// Grants the control channel sends for each call, a burst in two
+const uint8_t  GRANTS = 4U;
+
+static uint32_t chanReg0[CHANNELS];
+
+static CDMRDownlink control(1U, 31U);
+static CDMRDownlink traffic(1U, 32U);
+static bool     trafficLost = false;
+static uint32_t noise = 1U;
+
+static int8_t   chan = -1;
+static uint16_t retunes = 0U;
+
+static uint8_t  reply[256U];
+static uint16_t replyLen = 0U;
+static uint8_t  acked = 0U;
+
+static uint8_t  status[3U + DMR_TRUNK_STATUS_LENGTH];
+static bool     statusRead = false;
+
+static double ms(uint64_t ns)
+{
+  return double(ns) / 1000000.0;
+}
+
+static int8_t tuned()
+{
+  for (uint8_t i = 0U; i < CHANNELS; i++) {
+    if (hostReg(1U, 0U) == chanReg0[i])
+      return int8_t(i);
+  }
+
+  return -1;
+}
+
+static void readHost()
+{
+  uint8_t c;
+  while (hostSerialRead(&c, 1U) == 1U) {
+    if (replyLen == 0U && c != MMDVM_FRAME_START)
+      continue;
+
+    reply[replyLen++] = c;
+    if (replyLen < 3U || replyLen < reply[1U])
+      continue;
+
+    if (reply[2U] == MMDVM_ACK && replyLen >= 4U)
+      acked = reply[3U];
+
+    if (reply[2U] == MMDVM_DMR_TRUNK_STATUS && replyLen == sizeof(status)) {
+      ::memcpy(status, reply, sizeof(status));
+      statusRead = true;
+    }
+
+    replyLen = 0U;
+  }
+}
+
+// Both channels go on while the receiver is on either
+static void run(uint32_t duration)
+{
+  uint64_t end = hostNanos() + uint64_t(duration) * 1000000U;
+
+  while (hostNanos() < end) {
+    for (uint8_t n = 0U; n < LOOP_BITS; n++) {
+      noise = noise * 1103515245U + 12345U;
+
+      uint8_t bits[CHANNELS];
+      bits[CONTROL] = control.getBit();
+      bits[TRAFFIC] = trafficLost ? uint8_t((noise >> 16) & 0x01U) : traffic.getBit();
+
+      hostClockBit(0U, chan >= 0 ? bits[chan] : uint8_t((noise >> 16) & 0x01U));
+    }
+
+    hostLoop();
+    readHost();
+
+    int8_t now = tuned();
+    if (now != chan) {
+      chan = now;
+      retunes++;
+    }
+  }
+}
+
+// Runs until the receiver is on the channel, for at most this long
+static uint64_t waitFor(int8_t channel, uint32_t duration)
+{
+  uint64_t start = hostNanos();
+
+  while (chan != channel && (hostNanos() - start) < uint64_t(duration) * 1000000U)
+    run(1U);
+
+  return hostNanos() - start;
+}
+
+static uint16_t field(uint8_t n)
+{
+  return (status[3U + n] << 8) | status[4U + n];
+}
+
+static void readStatus()
+{
+  const uint8_t request[] = {MMDVM_FRAME_START, 3U, MMDVM_DMR_TRUNK_STATUS};
+
+  statusRead = false;
+  hostSerialWrite(request, sizeof(request));
+  hostLoop();
+  readHost();
+
+  CHECK(statusRead);
+}
+
+static void setUp()
+{
+  hostReset();
+
+  m_duplex     = true;
+  m_modemState = STATE_DMR;
+
+  CHECK(io.setFreq(FREQUENCY, FREQUENCY, 255U, FREQUENCY) == 0U);
+  io.ifConf(STATE_DMR, true);
+  io.start();
+  dmrRX.setColorCode(1U);
+
+  // The REG0 of each channel, from the chip after tuning to it alone
+  for (uint8_t i = 0U; i < CHANNELS; i++) {
+    CHECK(io.setTrunk(CHANNEL_FREQ + i, 1U) == 0U);
+    chanReg0[i] = hostReg(1U, 0U);
+  }
+  CHECK(chanReg0[CONTROL] != chanReg0[TRAFFIC]);
+
+  // The plan as the host sends it, a count then the channel numbers and
+  // frequencies, little endian
+  uint8_t frame[4U + CHANNELS * 6U];
+  frame[0U] = MMDVM_FRAME_START;
+  frame[1U] = sizeof(frame);
+  frame[2U] = MMDVM_DMR_TRUNK;
+  frame[3U] = CHANNELS;
+  for (uint8_t i = 0U; i < CHANNELS; i++) {
+    uint8_t* p = frame + 4U + i * 6U;
+    p[0U] = CHANNEL_LCN[i] >> 0;
+    p[1U] = CHANNEL_LCN[i] >> 8;
+    p[2U] = CHANNEL_FREQ[i] >> 0;
+    p[3U] = CHANNEL_FREQ[i] >> 8;
+    p[4U] = CHANNEL_FREQ[i] >> 16;
+    p[5U] = CHANNEL_FREQ[i] >> 24;
+  }
+
+  acked = 0U;
+  hostSerialWrite(frame, sizeof(frame));
+  hostLoop();
+  readHost();
+  CHECK(acked == MMDVM_DMR_TRUNK);
+
+  chan = tuned();
+  CHECK(chan == CONTROL);
+  CHECK(dmrTrunk.isEnabled());
+
+  // Sync on the control channel
+  run(600U);
+  CHECK(chan == CONTROL);
+}
+
+// A grant, then the call on the traffic channel to its terminator
+static void testCall()
+{
+  readStatus();
+  uint16_t followed = field(6U);
+
+  control.sendGrant(CHANNEL_LCN[TRAFFIC], 0U, 1001U, 91U, GRANTS);
+  uint64_t retune = waitFor(TRAFFIC, 1000U);
+  CHECK(chan == TRAFFIC);
+
+  readStatus();
+  CHECK(status[3U] == DMRTS_ACQUIRE || status[3U] == DMRTS_FOLLOW);
+  CHECK(field(1U) == CHANNEL_LCN[TRAFFIC] && status[6U] == 0U);
+
+  traffic.startCall(1001U, 91U, 6U);
+
+  uint16_t before = retunes;
+  while (traffic.inCall())
+    run(1U);
+  bool held = retunes == before && chan == TRAFFIC;
+
+  uint64_t back = waitFor(CONTROL, 1000U);
+
+  ::printf("call:    on the traffic channel %6.1f ms after the grant, held %s, back %6.1f ms after the terminator\n",
+           ms(retune), held ? "yes" : "no", ms(back));
+
+  // The grant is in the next burst of its slot, then a scheduler pass
+  CHECK(retune <= 100000000U);
+  CHECK(held);
+  CHECK(chan == CONTROL);
+  CHECK(back <= 100000000U);
+
+  readStatus();
+  CHECK(status[3U] == DMRTS_CONTROL);
+  CHECK(field(6U) == followed + 1U);
+
+  // The first sync on the traffic channel, its idle bursts, within a few
+  // bursts of the retune
+  CHECK(field(12U) > 0U && field(12U) <= 4U * 576U);
+
+  // The control channel repeating the grant for late entry is not followed
+  control.sendGrant(CHANNEL_LCN[TRAFFIC], 0U, 1001U, 91U, GRANTS);
+  run(500U);
+  CHECK(chan == CONTROL);
+}
+
+// A grant for a call that never starts on the traffic channel
+static void testTimeout()
+{
+  readStatus();
+  uint16_t missed = field(8U);
+
+  control.sendGrant(CHANNEL_LCN[TRAFFIC], 0U, 1002U, 91U, GRANTS);
+  waitFor(TRAFFIC, 1000U);
+  CHECK(chan == TRAFFIC);
+
+  uint64_t back = waitFor(CONTROL, 2000U);
+
+  ::printf("timeout: back on the control channel %6.1f ms after the retune\n", ms(back));
+
+  CHECK(chan == CONTROL);
+  CHECK(back >= 950000000U && back <= 1100000000U);
+
+  readStatus();
+  CHECK(field(8U) == missed + 1U);
+}
+
+// The traffic channel fades to noise part way through the call
+static void testLoss()
+{
+  readStatus();
+  uint16_t followed = field(6U);
+
+  control.sendGrant(CHANNEL_LCN[TRAFFIC], 0U, 1003U, 91U, GRANTS);
+  waitFor(TRAFFIC, 1000U);
+  CHECK(chan == TRAFFIC);
+
+  traffic.startCall(1003U, 91U, 6U);
+  run(600U);
+  CHECK(chan == TRAFFIC && traffic.inCall());
+
+  trafficLost = true;
+  uint64_t back = waitFor(CONTROL, 2000U);
+  trafficLost = false;
+
+  ::printf("loss:    back on the control channel %6.1f ms after the traffic channel went\n", ms(back));
+
+  CHECK(chan == CONTROL);
+  CHECK(back <= 1000000000U);
+
+  // A call that was seen counts as followed, however it ended
+  readStatus();
+  CHECK(field(6U) == followed + 1U);
+
+  while (traffic.inCall())
+    run(10U);
+}
+
+int main()
+{
+  setUp();
+
+  testCall();
+  testTimeout();
+  testLoss();
+
+  readStatus();
+  ::printf("%u grants, %u followed, %u missed, %u unknown\n", field(4U), field(6U), field(8U), field(10U));
+  CHECK(field(10U) == 0U);
+
+  return testResult();
+}
+
+#else
+
+int main()
+{
+  ::printf("needs DUPLEX\n");
+
+  return testResult();
+}
+
+#endif
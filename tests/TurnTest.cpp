@@ -0,0 +1,263 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// TX/RX turnaround on the host bus: setTX() and setRX(false) leave REG0 in
+// the shift register for the interrupt to latch, and every other bus writer
+// has to keep off it until then
+
+#include "Config.h"
+#include "Globals.h"
+#include "Host.h"
+#include "Test.h"
+
+extern uint32_t ADF7021_RX_REG0;
+extern uint32_t ADF7021_TX_REG0;
+
+const uint32_t FREQUENCY = 433450000U;
+
+const uint32_t CHANNEL_FREQ[] = {433462500U, 433475000U};
+const uint16_t DWELL = 200U;
+
+// The interrupt latches a switch to TX on the next falling edge, and one to
+// RX on the edge after the last even bit
+const uint16_t MAX_TURN_TX = 2U;
+const uint16_t MAX_TURN_RX = 4U;
+
+static uint8_t txBits[64U];
+
+static void setUp()
+{
+  hostReset();
+
+  m_duplex     = true;
+  m_modemState = STATE_DMR;
+
+  CHECK(io.setFreq(FREQUENCY, FREQUENCY, 255U, FREQUENCY) == 0U);
+  io.ifConf(STATE_DMR, true);
+  io.start();
+
+  for (uint8_t i = 0U; i < sizeof(txBits); i++)
+    txBits[i] = i & 0x01U;
+}
+
+static void clock(uint16_t bits)
+{
+  for (uint16_t n = 0U; n < bits; n++) {
+    hostClockBit(0U, 0U);
+    hostLoop();
+  }
+}
+
+// Clocks bits until the interrupt has latched the switch
+static uint16_t clockSwitch()
+{
+  uint16_t n = 0U;
+  while (io.isSwitching() && n < 16U) {
+    hostClockBit(0U, 0U);
+    n++;
+  }
+
+  return n;
+}
+
+// Every word got to the chip it was shifted for, none was shifted over
+static bool allLatched()
+{
+  for (uint16_t n = 0U; n < hostBusCount(); n++) {
+    if (hostBus(n).chip < 0)
+      return false;
+  }
+
+  return true;
+}
+
+static void report(const char* name, const HOST_BUS_T& reg0)
+{
+  uint16_t toTX, toRX;
+  io.getTurnaround(toTX, toRX);
+
+  ::printf("%-28s to TX %u ticks, to RX %u ticks, REG0 latched %5.1f us after it was shifted\n", name, toTX, toRX,
+           double(reg0.latchNs - reg0.endNs) / 1000.0);
+}
+
+// The scan retunes the second chip while the first switches to TX
+static void testRetuneToTX()
+{
+  hostBusClear();
+
+  io.write(txBits, sizeof(txBits));
+  CHECK(io.isSwitching());
+  CHECK(hostBusCount() == 1U);
+
+  // The interrupt sets m_tx as it latches the switch
+  CHECK(!m_tx);
+
+  // Held back, nothing goes on the bus
+  CHECK(io.setChannels(CHANNEL_FREQ, 2U, DWELL) == 0U);
+  CHECK(hostBusCount() == 1U);
+
+  CHECK(clockSwitch() <= MAX_TURN_TX);
+  CHECK(!io.isSwitching());
+  CHECK(m_tx);
+  CHECK(hostBus(0U).chip == 0);
+  CHECK(hostReg(0U, 0U) == ADF7021_TX_REG0);
+  report("scan retune, to TX", hostBus(0U));
+
+  // Then the retune goes out from the main loop
+  hostLoop();
+  CHECK(hostBusCount() == 2U);
+  CHECK(hostReg(1U, 0U) == ADF7021_RX_REG0);
+  CHECK(allLatched());
+
+  uint16_t toTX, toRX;
+  io.getTurnaround(toTX, toRX);
+  CHECK(toTX <= MAX_TURN_TX);
+}
+
+// The trunk retunes while the transmitter switches off
+static void testTrunkToRX()
+{
+  CHECK(io.setChannels(CHANNEL_FREQ, 0U, 0U) == 0U);
+  CHECK(io.setTrunk(CHANNEL_FREQ, 2U) == 0U);
+
+  // To the end of the transmission
+  uint16_t n = 0U;
+  while (!io.isSwitching() && n < 2U * sizeof(txBits)) {
+    clock(1U);
+    n++;
+  }
+  CHECK(io.isSwitching());
+  CHECK(m_tx);
+
+  hostBusClear();
+  uint32_t rxReg0 = hostShift();
+
+  CHECK(io.tuneTrunk(1U));
+  CHECK(hostBusCount() == 0U);
+  CHECK(hostShift() == rxReg0);
+
+  CHECK(clockSwitch() <= MAX_TURN_RX);
+  CHECK(!m_tx);
+  CHECK(hostReg(0U, 0U) == rxReg0);
+
+  hostLoop();
+  CHECK(hostBusCount() == 1U);
+  CHECK(hostReg(1U, 0U) == ADF7021_RX_REG0);
+  CHECK(allLatched());
+
+  uint16_t toTX, toRX;
+  io.getTurnaround(toTX, toRX);
+  CHECK(toRX <= MAX_TURN_RX);
+  ::printf("%-28s to RX %u ticks\n", "trunk retune, to RX", toRX);
+
+  CHECK(io.setTrunk(CHANNEL_FREQ, 0U) == 0U);
+}
+
+// SET_FREQ or SET_CONFIG from the host as the transmitter keys up
+static void testConfToTX()
+{
+  clock(8U);
+  hostBusClear();
+
+  io.write(txBits, sizeof(txBits));
+  CHECK(io.isSwitching());
+
+  // ifConf() waits for the latch before it shifts anything
+  io.ifConf(STATE_DMR, false);
+  CHECK(hostBusCount() > 1U);
+  CHECK(hostBus(0U).chip == 0);
+  CHECK((hostBus(0U).word & 0x0FU) == 0U);
+  CHECK(hostBus(1U).startNs >= hostBus(0U).latchNs);
+  report("ifConf(), to TX", hostBus(0U));
+
+  // Then its own setRX() is latched at once, and the end of the
+  // transmission switches to RX as usual
+  CHECK(allLatched());
+  CHECK(hostReg(0U, 0U) == ADF7021_RX_REG0);
+
+  clock(2U * sizeof(txBits));
+  CHECK(!m_tx);
+  CHECK(!io.isSwitching());
+  CHECK(allLatched());
+}
+
+// The IO status reply has the turnarounds getTurnaround() has, and the
+// worst cases until they are cleared, then the scheduler status and the
+// register shadow counters
+static void testStatus()
+{
+  const uint8_t request[] = {0xE0U, 4U, 0xABU, 0x01U};
+  hostSerialWrite(request, sizeof(request));
+  hostLoop();
+
+  uint8_t reply[3U + IO_STATUS_LENGTH + SCHED_STATUS_LENGTH + SHADOW_STATUS_LENGTH];
+  CHECK(hostSerialRead(reply, sizeof(reply)) == sizeof(reply));
+  CHECK(reply[0U] == 0xE0U && reply[1U] == sizeof(reply) && reply[2U] == 0xABU);
+
+  uint16_t toTX, toRX;
+  io.getTurnaround(toTX, toRX);
+
+  uint16_t lastTX = (reply[3U] << 8) | reply[4U];
+  uint16_t maxTX  = (reply[5U] << 8) | reply[6U];
+  uint16_t lastRX = (reply[7U] << 8) | reply[8U];
+  uint16_t maxRX  = (reply[9U] << 8) | reply[10U];
+  CHECK(lastTX == toTX && lastRX == toRX);
+  CHECK(maxTX >= toTX && maxTX <= MAX_TURN_TX);
+  CHECK(maxRX >= toRX && maxRX <= MAX_TURN_RX);
+
+  // Then the scheduler, whose peak RX backlog is the most bits clocked in
+  // between two host loops, within the RX ring, and nothing once cleared
+  uint16_t backlog = (reply[13U] << 8) | reply[14U];
+  CHECK(backlog > 0U && backlog <= 1024U);
+
+  uint8_t sched[SCHED_STATUS_LENGTH];
+  CHECK(scheduler.readStatus(sched, SCHED_STATUS_LENGTH) == SCHED_STATUS_LENGTH);
+  CHECK(sched[0U] == 0U && sched[1U] == 0U && sched[2U] == 0U && sched[3U] == 0U);
+
+  // Then the shadow, which skipped the words the repeated ifConf() calls
+  // left as they were, and nothing once cleared
+  const uint8_t* shadow = reply + 3U + IO_STATUS_LENGTH + SCHED_STATUS_LENGTH;
+  uint16_t skipped = (shadow[0U] << 8) | shadow[1U];
+  CHECK(skipped > 0U);
+
+  uint8_t cleared[SHADOW_STATUS_LENGTH];
+  CHECK(io.readShadowStatus(cleared, SHADOW_STATUS_LENGTH) == SHADOW_STATUS_LENGTH);
+  for (uint8_t i = 0U; i < SHADOW_STATUS_LENGTH; i++)
+    CHECK(cleared[i] == 0U);
+
+  // Cleared to the last ones
+  uint8_t data[IO_STATUS_LENGTH];
+  io.readStatus(data, IO_STATUS_LENGTH);
+  CHECK(((data[2U] << 8) | data[3U]) == toTX);
+  CHECK(((data[6U] << 8) | data[7U]) == toRX);
+}
+
+int main()
+{
+#if defined(DUPLEX)
+  setUp();
+  testRetuneToTX();
+  testTrunkToRX();
+  testConfToTX();
+  testStatus();
+#else
+  ::printf("needs DUPLEX\n");
+#endif
+
+  return testResult();
+}
@@ -0,0 +1,352 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Config.h"
+#include "Globals.h"
+#include "DMRDownlink.h"
+#include "DMRDefines.h"
+#include "DMRShortLC.h"
+#include "DMRSlotType.h"
+#include "BPTC19696.h"
+#include "QR1676.h"
+
+#include <string.h>
+
+// Group voice, in the Short LC Act_Updt
+const uint8_t ACTIVITY_GROUP_VOICE = 0x08U;
+
+// The RS(12,9) parity of the LC is masked by data type
+const uint8_t LC_HEADER_MASK     = 0x96U;
+const uint8_t LC_TERMINATOR_MASK = 0x99U;
+
+// The CSBK opcode of a private voice channel grant, with the last block
+// bit, and the mask over its CRC
+const uint8_t CSBKO_PV_GRANT = 0x30U;
+const uint8_t CSBK_CRC_MASK  = 0xA5U;
+
+// LCSS of the EMB in voice bursts B to F
+const uint8_t VOICE_LCSS[] = {DMR_LCSS_FIRST, DMR_LCSS_CONTINUATION, DMR_LCSS_CONTINUATION, DMR_LCSS_LAST, DMR_LCSS_SINGLE};
+
+static void setBit(uint8_t* data, uint16_t n, bool b)
+{
+  if (b)
+    data[n >> 3] |= 0x80U >> (n & 7U);
+  else
+    data[n >> 3] &= ~(0x80U >> (n & 7U));
+}
+
+// GF(2^8), x^8 + x^4 + x^3 + x^2 + 1
+static uint8_t gfMult(uint8_t a, uint8_t b)
+{
+  uint8_t p = 0U;
+  while (b != 0U) {
+    if (b & 0x01U)
+      p ^= a;
+    a = (a & 0x80U) ? uint8_t((a << 1) ^ 0x1DU) : uint8_t(a << 1);
+    b >>= 1;
+  }
+
+  return p;
+}
+
+// RS(12,9), the generator has the roots alpha, alpha^2 and alpha^3
+static void encodeRS129(uint8_t* data)
+{
+  uint8_t g[4U] = {1U, 0U, 0U, 0U};
+  uint8_t alpha = 1U;
+  for (uint8_t r = 0U; r < 3U; r++) {
+    alpha = gfMult(alpha, 2U);
+    for (uint8_t i = 3U; i > 0U; i--)
+      g[i] ^= gfMult(g[i - 1U], alpha);
+  }
+
+  uint8_t rem[3U] = {0U, 0U, 0U};
+  for (uint8_t i = 0U; i < 9U; i++) {
+    uint8_t fb = data[i] ^ rem[0U];
+    rem[0U] = rem[1U] ^ gfMult(fb, g[1U]);
+    rem[1U] = rem[2U] ^ gfMult(fb, g[2U]);
+    rem[2U] = gfMult(fb, g[3U]);
+  }
+
+  data[9U]  = rem[0U];
+  data[10U] = rem[1U];
+  data[11U] = rem[2U];
+}
+
+// Hamming(17,12,3) of one Short LC row
+static void encode17123(bool* d)
+{
+  d[12] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[6] ^ d[7] ^ d[9];
+  d[13] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[7] ^ d[8] ^ d[10];
+  d[14] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[8] ^ d[9] ^ d[11];
+  d[15] = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
+  d[16] = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
+}
+
+// CRC-CCITT, preset to zero and inverted
+static uint16_t crc16(const uint8_t* data, uint8_t length)
+{
+  uint16_t crc = 0x0000U;
+  for (uint8_t i = 0U; i < length; i++) {
+    crc ^= uint16_t(data[i]) << 8;
+    for (uint8_t j = 0U; j < 8U; j++)
+      crc = (crc & 0x8000U) ? uint16_t((crc << 1) ^ 0x1021U) : uint16_t(crc << 1);
+  }
+
+  return ~crc;
+}
+
+// x^8 + x^2 + x + 1, preset to zero
+static uint8_t crc8(const uint8_t* data, uint8_t length)
+{
+  uint8_t crc = 0x00U;
+  for (uint8_t i = 0U; i < length; i++) {
+    crc ^= data[i];
+    for (uint8_t j = 0U; j < 8U; j++)
+      crc = (crc & 0x80U) ? uint8_t((crc << 1) ^ 0x07U) : uint8_t(crc << 1);
+  }
+
+  return crc;
+}
+
+CDMRDownlink::CDMRDownlink(uint8_t colorCode, uint32_t seed) :
+m_colorCode(colorCode),
+m_seed(seed),
+m_count(0U),
+m_data(),
+m_ptr(DMR_DOWNLINK_BURST_BYTES * 8U),
+m_shortLC(),
+m_srcId(0U),
+m_dstId(0U),
+m_callBursts(0U),
+m_callPtr(0U),
+m_grantChannel(0U),
+m_grantSlot(0U),
+m_grantSrcId(0U),
+m_grantDstId(0U),
+m_grants(0U)
+{
+  encodeShortLC(0U);
+}
+
+void CDMRDownlink::startCall(uint32_t srcId, uint32_t dstId, uint8_t superframes)
+{
+  m_srcId      = srcId;
+  m_dstId      = dstId;
+  m_callBursts = 1U + superframes * 6U + 1U;
+  m_callPtr    = 0U;
+}
+
+bool CDMRDownlink::inCall() const
+{
+  return m_callPtr < m_callBursts;
+}
+
+void CDMRDownlink::sendGrant(uint16_t channel, uint8_t slot, uint32_t srcId, uint32_t dstId, uint8_t count)
+{
+  m_grantChannel = channel;
+  m_grantSlot    = slot;
+  m_grantSrcId   = srcId;
+  m_grantDstId   = dstId;
+  m_grants       = count;
+}
+
+uint8_t CDMRDownlink::getBit()
+{
+  if (m_ptr >= DMR_DOWNLINK_BURST_BYTES * 8U) {
+    getBurst(m_data);
+    m_ptr = 0U;
+  }
+
+  uint8_t bit = (m_data[m_ptr >> 3] >> (7U - (m_ptr & 7U))) & 0x01U;
+  m_ptr++;
+
+  return bit;
+}
+
+void CDMRDownlink::getBurst(uint8_t* data)
+{
+  uint8_t slot = m_count & 0x01U;
+
+  // A whole Short LC goes out in every four CACHs
+  if ((m_count % 4U) == 0U)
+    encodeShortLC(inCall() ? ACTIVITY_GROUP_VOICE : 0x00U);
+
+  makeCACH(data, slot);
+
+  uint8_t* burst = data + DMR_CACH_LENGTH_BYTES;
+  if (slot == 0U && inCall()) {
+    if (m_callPtr == 0U)
+      makeData(burst, DT_VOICE_LC_HEADER);
+    else if (m_callPtr == (m_callBursts - 1U))
+      makeData(burst, DT_TERMINATOR_WITH_LC);
+    else
+      makeVoice(burst, (m_callPtr - 1U) % 6U);
+
+    m_callPtr++;
+  } else if (slot == 0U && m_grants > 0U) {
+    makeData(burst, DT_CSBK);
+    m_grants--;
+  } else {
+    makeData(burst, DT_IDLE);
+  }
+
+  m_count++;
+}
+
+void CDMRDownlink::getShortLC(uint8_t activity, uint8_t* data)
+{
+  encodeShortLC(activity);
+
+  memset(data, 0x00U, 9U);
+  for (uint8_t n = 0U; n < 4U; n++) {
+    for (uint8_t i = 0U; i < 17U; i++)
+      setBit(data, n * 17U + i, m_shortLC[n][i]);
+  }
+}
+
+void CDMRDownlink::encodeShortLC(uint8_t activity)
+{
+  // Act_Updt, the SLCO in the low nibble of the first byte
+  uint8_t lc[5U] = {DMRSLCO_ACT_UPDT, uint8_t(activity << 4), 0x00U, 0x00U, 0x00U};
+  lc[4U] = crc8(lc, 4U);
+
+  bool data[68U];
+  memset(data, 0x00U, sizeof(data));
+
+  uint8_t pos = 4U;
+  for (uint8_t r = 0U; r < 3U; r++) {
+    for (uint8_t i = 0U; i < 12U; i++, pos++)
+      data[r * 17U + i] = (lc[pos >> 3] & (0x80U >> (pos & 7U))) != 0U;
+    encode17123(data + r * 17U);
+  }
+
+  for (uint8_t c = 0U; c < 17U; c++)
+    data[51U + c] = data[c] ^ data[17U + c] ^ data[34U + c];
+
+  bool raw[68U];
+  for (uint8_t a = 0U; a < 67U; a++)
+    raw[(a * 4U) % 67U] = data[a];
+  raw[67U] = data[67U];
+
+  for (uint8_t n = 0U; n < 4U; n++)
+    memcpy(m_shortLC[n], raw + n * 17U, 17U);
+}
+
+void CDMRDownlink::makeCACH(uint8_t* cach, uint8_t slot)
+{
+  const uint8_t LCSS[] = {DMR_LCSS_FIRST, DMR_LCSS_CONTINUATION, DMR_LCSS_CONTINUATION, DMR_LCSS_LAST};
+
+  uint8_t n = m_count % 4U;
+
+  bool t[7U];
+  t[0U] = inCall();                // AT
+  t[1U] = slot == 1U;              // TC, the slot of the burst that follows
+  t[2U] = (LCSS[n] & 0x02U) != 0U;
+  t[3U] = (LCSS[n] & 0x01U) != 0U;
+  t[4U] = t[0U] ^ t[1U] ^ t[2U];
+  t[5U] = t[1U] ^ t[2U] ^ t[3U];
+  t[6U] = t[0U] ^ t[1U] ^ t[3U];
+
+  const uint8_t TACT[] = {0U, 4U, 8U, 12U, 14U, 18U, 22U};
+  for (uint8_t i = 0U; i < 7U; i++)
+    setBit(cach, TACT[i], t[i]);
+
+  for (uint8_t i = 0U; i < 17U; i++)
+    setBit(cach, DMR_CACH_PAYLOAD[i], m_shortLC[n][i]);
+}
+
+void CDMRDownlink::makeData(uint8_t* burst, uint8_t dataType)
+{
+  for (uint8_t i = 0U; i < DMR_FRAME_LENGTH_BYTES; i++)
+    burst[i] = random();
+
+  uint8_t lc[12U];
+  if (dataType == DT_VOICE_LC_HEADER || dataType == DT_TERMINATOR_WITH_LC) {
+    // Group voice, FLCO 0 and FID 0
+    lc[0U] = 0x00U;
+    lc[1U] = 0x00U;
+    lc[2U] = 0x00U;
+    lc[3U] = m_dstId >> 16;
+    lc[4U] = m_dstId >> 8;
+    lc[5U] = m_dstId >> 0;
+    lc[6U] = m_srcId >> 16;
+    lc[7U] = m_srcId >> 8;
+    lc[8U] = m_srcId >> 0;
+    encodeRS129(lc);
+
+    uint8_t mask = (dataType == DT_VOICE_LC_HEADER) ? LC_HEADER_MASK : LC_TERMINATOR_MASK;
+    lc[9U]  ^= mask;
+    lc[10U] ^= mask;
+    lc[11U] ^= mask;
+  } else if (dataType == DT_CSBK) {
+    // The channel in 12 bits then the slot, the group then the source
+    lc[0U] = 0x80U | CSBKO_PV_GRANT;
+    lc[1U] = 0x00U;
+    lc[2U] = m_grantChannel >> 4;
+    lc[3U] = ((m_grantChannel & 0x0FU) << 4) | (m_grantSlot << 3);
+    lc[4U] = m_grantDstId >> 16;
+    lc[5U] = m_grantDstId >> 8;
+    lc[6U] = m_grantDstId >> 0;
+    lc[7U] = m_grantSrcId >> 16;
+    lc[8U] = m_grantSrcId >> 8;
+    lc[9U] = m_grantSrcId >> 0;
+
+    uint16_t crc = crc16(lc, 10U);
+    lc[10U] = (crc >> 8) ^ CSBK_CRC_MASK;
+    lc[11U] = (crc >> 0) ^ CSBK_CRC_MASK;
+  } else {
+    for (uint8_t i = 0U; i < 12U; i++)
+      lc[i] = random();
+  }
+
+  CBPTC19696 bptc;
+  bptc.encode(lc, burst);
+
+  CDMRSlotType slotType;
+  slotType.encode(m_colorCode, dataType, burst);
+
+  for (uint8_t i = 0U; i < 48U; i++)
+    setBit(burst, 108U + i, ((DMR_BS_DATA_SYNC_BITS >> (47U - i)) & 0x01U) != 0U);
+}
+
+// Voice burst A has the sync, B to F the EMB around the embedded signalling
+void CDMRDownlink::makeVoice(uint8_t* burst, uint8_t n)
+{
+  for (uint8_t i = 0U; i < DMR_FRAME_LENGTH_BYTES; i++)
+    burst[i] = random();
+
+  if (n == 0U) {
+    for (uint8_t i = 0U; i < 48U; i++)
+      setBit(burst, 108U + i, ((DMR_BS_VOICE_SYNC_BITS >> (47U - i)) & 0x01U) != 0U);
+  } else {
+    uint16_t emb = CQR1676::encode((m_colorCode << 3) | VOICE_LCSS[n - 1U]);
+    for (uint8_t i = 0U; i < 8U; i++) {
+      setBit(burst, 108U + i, ((emb >> (15U - i)) & 0x01U) != 0U);
+      setBit(burst, 148U + i, ((emb >> (7U - i)) & 0x01U) != 0U);
+    }
+  }
+}
+
+// The bits of the vocoder and the idle fill, reproducible from the seed
+uint8_t CDMRDownlink::random()
+{
+  m_seed = m_seed * 1103515245U + 12345U;
+
+  return uint8_t(m_seed >> 16);
+}
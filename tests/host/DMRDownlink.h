@@ -0,0 +1,78 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(DMRDOWNLINK_H)
+#define  DMRDOWNLINK_H
+
+#include <stdint.h>
+
+// A CACH and a burst, 288 bits every 30 ms
+const uint16_t DMR_DOWNLINK_BURST_BYTES = 36U;
+
+// Synthetic BS downlink, as a repeater sends it: idle bursts on both slots,
+// the site activity in the Short LC of the CACHs, and voice calls on slot 1
+// with the LC header, superframes of voice and the terminator. As a Tier III
+// control channel it sends channel grants on slot 1 too.
+class CDMRDownlink {
+public:
+  CDMRDownlink(uint8_t colorCode = 1U, uint32_t seed = 1U);
+
+  // A group call on slot 1 from the next burst of that slot
+  void startCall(uint32_t srcId, uint32_t dstId, uint8_t superframes);
+  bool inCall() const;
+
+  // Private voice channel grants for a group call, this many CSBKs on slot 1
+  // in place of its idle bursts
+  void sendGrant(uint16_t channel, uint8_t slot, uint32_t srcId, uint32_t dstId, uint8_t count);
+
+  // The next bit on air
+  uint8_t getBit();
+
+  // The next CACH and burst, DMR_DOWNLINK_BURST_BYTES of them
+  void getBurst(uint8_t* data);
+
+  // A Short LC Act_Updt with this activity on slot 1, as the host sends it
+  // with MMDVM_DMR_SHORTLC: the 68 bits with their FEC and interleaving, in
+  // 9 bytes. The downlink sends it too, until its next whole Short LC.
+  void getShortLC(uint8_t activity, uint8_t* data);
+
+private:
+  uint8_t  m_colorCode;
+  uint32_t m_seed;
+  uint32_t m_count;
+  uint8_t  m_data[DMR_DOWNLINK_BURST_BYTES];
+  uint16_t m_ptr;
+  bool     m_shortLC[4U][17U];
+  uint32_t m_srcId;
+  uint32_t m_dstId;
+  uint16_t m_callBursts;
+  uint16_t m_callPtr;
+  uint16_t m_grantChannel;
+  uint8_t  m_grantSlot;
+  uint32_t m_grantSrcId;
+  uint32_t m_grantDstId;
+  uint8_t  m_grants;
+
+  void encodeShortLC(uint8_t activity);
+  void makeCACH(uint8_t* cach, uint8_t slot);
+  void makeData(uint8_t* burst, uint8_t dataType);
+  void makeVoice(uint8_t* burst, uint8_t n);
+  uint8_t random();
+};
+
+#endif
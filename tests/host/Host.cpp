@@ -0,0 +1,52 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Config.h"
+#include "Globals.h"
+#include "Host.h"
+
+static uint64_t hostTime = 0U;
+
+void hostSerialClear();
+void hostBusReset();
+void hostClockReset();
+
+uint64_t hostNanos()
+{
+  return hostTime;
+}
+
+void hostAdvance(uint64_t ns)
+{
+  hostTime += ns;
+}
+
+void hostReset()
+{
+  hostTime = 0U;
+
+  hostBusReset();
+  hostClockReset();
+  hostSerialClear();
+}
+
+void hostLoop()
+{
+  scheduler.process();
+}
+
@@ -0,0 +1,85 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+// Host backend for the platform half of CIO and CSerialPort, it replaces
+// IOArduino.cpp and SerialArduino.cpp so the firmware runs on Linux against
+// simulated time, a recording register bus and in-memory serial queues
+
+#if !defined(HOST_H)
+#define  HOST_H
+
+#include <stdint.h>
+
+// One bit-banged bus bit on the STM32F103 at 72 MHz: three port writes and
+// two dlybit() calls
+const uint32_t HOST_BUS_BIT_NS   = 300U;
+const uint32_t HOST_BUS_LATCH_NS = 100U;
+
+// One clock edge of the ADF7021 at 9600 bit/s, a CIO tick
+const uint32_t HOST_EDGE_NS      = 52083U;
+
+const uint16_t HOST_BUS_LENGTH   = 2048U;
+
+// A transfer on the register bus. A write is recorded when its bits are
+// shifted out and gets its chip once SLE latches it, a readback has its chip
+// from the start
+struct HOST_BUS_T {
+  uint32_t word;
+  uint8_t  bits;
+  int8_t   chip;         // -1 while the word sits unlatched in the shift register
+  bool     readback;
+  uint64_t startNs;
+  uint64_t endNs;
+  uint64_t latchNs;      // When SLE latched it
+};
+
+// Clears the bus log, the latched registers and the serial queues, and
+// restarts the simulated clock
+void     hostReset();
+
+uint64_t hostNanos();
+void     hostAdvance(uint64_t ns);
+
+uint16_t          hostBusCount();
+const HOST_BUS_T& hostBus(uint16_t n);
+void              hostBusClear();
+// Time spent shifting and latching since the last hostBusClear()
+uint64_t          hostBusNanos();
+
+// What each chip last latched into a register, and the word the shared shift
+// register holds now
+uint32_t hostReg(uint8_t chip, uint8_t reg);
+uint32_t hostShift();
+
+// Value the next readbacks return
+void     hostSetReadback(uint16_t value);
+
+// Drives one full bit of the ADF7021 clocks: the rising edge samples rxd on
+// the first chip and rxd2 on the second, the falling edge clocks out the
+// next TX bit. Returns the bit the first chip transmitted. The clock also
+// runs through CIO::delay_us(), with the data pins left as they are
+uint8_t  hostClockBit(uint8_t rxd, uint8_t rxd2);
+
+// Modem side of the host serial link
+void     hostSerialWrite(const uint8_t* data, uint16_t length);
+uint16_t hostSerialRead(uint8_t* data, uint16_t length);
+
+// One pass of the firmware main loop
+void     hostLoop();
+
+#endif
@@ -0,0 +1,358 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Config.h"
+#include "Globals.h"
+#include "IO.h"
+#include "Host.h"
+
+#include <assert.h>
+
+// Both chips see the same SCLK/SDATA, so they share one shift register and
+// only the SLE line picks the chip that latches it
+static HOST_BUS_T bus[HOST_BUS_LENGTH];
+static uint16_t   busCount = 0U;
+static uint64_t   busNanos = 0U;
+static uint32_t   busShift = 0U;
+static uint32_t   busRegs[2U][16U];
+static uint16_t   busReadbackValue = 0U;
+
+static bool       pinCLK  = false;
+static bool       pinRXD  = false;
+static bool       pinCLK2 = false;
+static bool       pinRXD2 = false;
+static bool       pinTXD  = false;
+static bool       pinSLE  = false;
+static bool       pinSLE2 = false;
+
+// Due time of the next clock edge, the clock runs on its own as the radio's
+// does, and the edges are delivered through the interrupts
+static uint64_t   clockEdgeNs = HOST_EDGE_NS;
+static bool       clockInInterrupt = false;
+
+void hostClockReset()
+{
+  clockEdgeNs = HOST_EDGE_NS;
+  pinCLK  = false;
+  pinCLK2 = false;
+}
+
+void hostBusClear()
+{
+  busCount = 0U;
+  busNanos = 0U;
+}
+
+void hostBusReset()
+{
+  hostBusClear();
+
+  busShift = 0U;
+  for (uint8_t i = 0U; i < 16U; i++) {
+    busRegs[0U][i] = 0U;
+    busRegs[1U][i] = 0U;
+  }
+}
+
+uint16_t hostBusCount()
+{
+  return busCount;
+}
+
+const HOST_BUS_T& hostBus(uint16_t n)
+{
+  assert(n < busCount);
+
+  return bus[n];
+}
+
+uint64_t hostBusNanos()
+{
+  return busNanos;
+}
+
+uint32_t hostReg(uint8_t chip, uint8_t reg)
+{
+  return busRegs[chip & 1U][reg & 0x0FU];
+}
+
+uint32_t hostShift()
+{
+  return busShift;
+}
+
+void hostSetReadback(uint16_t value)
+{
+  busReadbackValue = value;
+}
+
+static void busTransfer(uint32_t word, uint8_t bits, int8_t chip, bool readback, uint32_t ns)
+{
+  assert(busCount < HOST_BUS_LENGTH);
+
+  HOST_BUS_T& t = bus[busCount++];
+  t.word     = word;
+  t.bits     = bits;
+  t.chip     = chip;
+  t.readback = readback;
+  t.startNs  = hostNanos();
+
+  hostAdvance(ns);
+  busNanos += ns;
+
+  t.endNs    = hostNanos();
+  t.latchNs  = readback ? t.endNs : 0U;
+}
+
+static void busLatched(uint8_t chip)
+{
+  busRegs[chip][busShift & 0x0FU] = busShift;
+
+  // The word that was shifted in last is the one that lands
+  for (uint16_t n = busCount; n > 0U; n--) {
+    HOST_BUS_T& t = bus[n - 1U];
+    if (!t.readback) {
+      if (t.chip < 0) {
+        t.chip    = int8_t(chip);
+        t.latchNs = hostNanos();
+      }
+      break;
+    }
+  }
+}
+
+static void clockEdge()
+{
+  pinCLK  = !pinCLK;
+  pinCLK2 = pinCLK;
+
+  clockInInterrupt = true;
+  io.interrupt();
+#if defined(DUPLEX)
+  io.interrupt2();
+#endif
+  clockInInterrupt = false;
+}
+
+// Runs the clock up to a time. An edge that fell due during a bus transfer
+// is delivered late, as the interrupt would be, and none are delivered from
+// within the interrupt itself
+static void clockRun(uint64_t until)
+{
+  while (!clockInInterrupt && clockEdgeNs <= until) {
+    if (hostNanos() < clockEdgeNs)
+      hostAdvance(clockEdgeNs - hostNanos());
+
+    clockEdgeNs += HOST_EDGE_NS;
+    clockEdge();
+  }
+
+  if (hostNanos() < until)
+    hostAdvance(until - hostNanos());
+}
+
+uint8_t hostClockBit(uint8_t rxd, uint8_t rxd2)
+{
+  pinRXD  = rxd != 0U;
+  pinRXD2 = rxd2 != 0U;
+
+  // Up to and through the rising edge, then the falling one
+  do {
+    clockRun(clockEdgeNs);
+  } while (!pinCLK);
+
+  clockRun(clockEdgeNs);
+
+  return pinTXD ? 1U : 0U;
+}
+
+void CIO::delay_IFcal()
+{
+  delay_us(10000U);
+}
+
+void CIO::delay_reset()
+{
+  delay_us(300U);
+}
+
+void CIO::Init()
+{
+}
+
+void CIO::startInt()
+{
+}
+
+#if defined(BIDIR_DATA_PIN)
+void CIO::Data_dir_out(bool dir)
+{
+}
+
+void CIO::RXD_pin_write(bool on)
+{
+  pinTXD = on;
+}
+#endif
+
+void CIO::SCLK_pin(bool on)
+{
+}
+
+void CIO::SDATA_pin(bool on)
+{
+}
+
+bool CIO::SREAD_pin()
+{
+  return false;
+}
+
+void CIO::SLE_pin(bool on)
+{
+  // The TX/RX switch in the interrupt pulses SLE itself
+  if (on && !pinSLE) {
+    hostAdvance(HOST_BUS_LATCH_NS);
+    busNanos += HOST_BUS_LATCH_NS;
+    busLatched(0U);
+  }
+
+  pinSLE = on;
+}
+
+#if defined(DUPLEX)
+void CIO::SLE2_pin(bool on)
+{
+  if (on && !pinSLE2) {
+    hostAdvance(HOST_BUS_LATCH_NS);
+    busNanos += HOST_BUS_LATCH_NS;
+    busLatched(1U);
+  }
+
+  pinSLE2 = on;
+}
+
+bool CIO::RXD2_pin()
+{
+  return pinRXD2;
+}
+
+bool CIO::CLK2_pin()
+{
+  return pinCLK2;
+}
+#endif
+
+void CIO::CE_pin(bool on)
+{
+}
+
+bool CIO::RXD_pin()
+{
+  return pinRXD;
+}
+
+bool CIO::CLK_pin()
+{
+  return pinCLK;
+}
+
+void CIO::TXD_pin(bool on)
+{
+  pinTXD = on;
+}
+
+void CIO::LED_pin(bool on)
+{
+}
+
+void CIO::DEB_pin(bool on)
+{
+}
+
+void CIO::DSTAR_pin(bool on)
+{
+}
+
+void CIO::DMR_pin(bool on)
+{
+}
+
+void CIO::YSF_pin(bool on)
+{
+}
+
+void CIO::P25_pin(bool on)
+{
+}
+
+void CIO::NXDN_pin(bool on)
+{
+}
+
+void CIO::POCSAG_pin(bool on)
+{
+}
+
+void CIO::PTT_pin(bool on)
+{
+}
+
+void CIO::COS_pin(bool on)
+{
+}
+
+void CIO::busWrite(uint32_t word, uint8_t bits)
+{
+  busShift = word;
+
+  busTransfer(word, bits, -1, false, bits * HOST_BUS_BIT_NS);
+}
+
+void CIO::busLatch(uint8_t chip)
+{
+#if defined(DUPLEX)
+  if (chip == 1U) {
+    SLE2_pin(true);
+    SLE2_pin(false);
+    return;
+  }
+#endif
+  SLE_pin(true);
+  SLE_pin(false);
+}
+
+uint16_t CIO::busReadback(uint8_t chip, uint16_t word)
+{
+  busShift = word;
+
+  // The 9 bit readback word, the latch, then 18 clocks for the 16 data bits
+  busTransfer(word, 9U, int8_t(chip), true, 9U * HOST_BUS_BIT_NS + HOST_BUS_LATCH_NS + 18U * HOST_BUS_BIT_NS);
+
+  return busReadbackValue;
+}
+
+// The clock keeps running through a wait, with the data pins as they are
+void CIO::delay_us(uint32_t us)
+{
+  clockRun(hostNanos() + uint64_t(us) * 1000U);
+}
+
+void CIO::dlybit()
+{
+}
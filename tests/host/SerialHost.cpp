@@ -0,0 +1,113 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Config.h"
+#include "Globals.h"
+#include "SerialPort.h"
+#include "Host.h"
+
+// Only port 1, the host link, is simulated
+const uint16_t HOST_SERIAL_LENGTH = 8192U;
+
+struct HOST_QUEUE_T {
+  uint8_t  data[HOST_SERIAL_LENGTH];
+  uint16_t head;
+  uint16_t tail;
+};
+
+static HOST_QUEUE_T toModem;
+static HOST_QUEUE_T toHost;
+
+static uint16_t queueLength(const HOST_QUEUE_T& q)
+{
+  return (q.head + HOST_SERIAL_LENGTH - q.tail) % HOST_SERIAL_LENGTH;
+}
+
+static void queuePut(HOST_QUEUE_T& q, uint8_t c)
+{
+  // Full, the oldest byte goes as on an overrun UART
+  if (queueLength(q) == HOST_SERIAL_LENGTH - 1U)
+    q.tail = (q.tail + 1U) % HOST_SERIAL_LENGTH;
+
+  q.data[q.head] = c;
+  q.head = (q.head + 1U) % HOST_SERIAL_LENGTH;
+}
+
+static uint8_t queueGet(HOST_QUEUE_T& q)
+{
+  uint8_t c = q.data[q.tail];
+  q.tail = (q.tail + 1U) % HOST_SERIAL_LENGTH;
+
+  return c;
+}
+
+void hostSerialClear()
+{
+  toModem.head = toModem.tail = 0U;
+  toHost.head  = toHost.tail  = 0U;
+}
+
+void hostSerialWrite(const uint8_t* data, uint16_t length)
+{
+  for (uint16_t i = 0U; i < length; i++)
+    queuePut(toModem, data[i]);
+}
+
+uint16_t hostSerialRead(uint8_t* data, uint16_t length)
+{
+  uint16_t n = 0U;
+  while (n < length && queueLength(toHost) > 0U)
+    data[n++] = queueGet(toHost);
+
+  return n;
+}
+
+void CSerialPort::beginInt(uint8_t n, int speed)
+{
+}
+
+int CSerialPort::availableInt(uint8_t n)
+{
+  return (n == 1U) ? queueLength(toModem) : 0;
+}
+
+uint8_t CSerialPort::readInt(uint8_t n)
+{
+  return (n == 1U && queueLength(toModem) > 0U) ? queueGet(toModem) : 0U;
+}
+
+uint16_t CSerialPort::readInt(uint8_t n, uint8_t* data, uint16_t length)
+{
+  if (n != 1U)
+    return 0U;
+
+  uint16_t i = 0U;
+  while (i < length && queueLength(toModem) > 0U)
+    data[i++] = queueGet(toModem);
+
+  return i;
+}
+
+void CSerialPort::writeInt(uint8_t n, const uint8_t* data, uint16_t length, bool flush)
+{
+  if (n != 1U)
+    return;
+
+  for (uint16_t i = 0U; i < length; i++)
+    queuePut(toHost, data[i]);
+}
@@ -0,0 +1,45 @@
+/*
+ *   Copyright (C) 2026 by MMDVM_DUAL_HT_MOD contributors
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(TEST_H)
+#define  TEST_H
+
+#include <stdio.h>
+
+static unsigned int testFailures = 0U;
+
+#define CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      ::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+      testFailures++; \
+    } \
+  } while (0)
+
+// The exit code of a test program
+static inline int testResult()
+{
+  if (testFailures > 0U)
+    ::printf("%u checks failed\n", testFailures);
+  else
+    ::printf("passed\n");
+
+  return testFailures > 0U ? 1 : 0;
+}
+
+#endif